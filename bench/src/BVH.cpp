@@ -0,0 +1,67 @@
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "BVH/BVH.hpp"
+#include "scenes.hpp"
+
+// --------------------------------------------------------------------------------------
+//               Macro benchmarks of the build and the query of the BVH
+// --------------------------------------------------------------------------------------
+
+namespace {
+
+using bench::Scene;
+using Tree = bin_tree::BVH<float>;
+using Store = triangle::TriangleStore<float>;
+
+// build() of a tree over a fresh copy of the scene, items are triangles
+void build(benchmark::State &state, Scene scene) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    const auto &triangles = bench::cached_scene<float>(scene, count);
+    state.SetLabel(std::string(bench::scene_name(scene)));
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto tree = std::make_unique<Tree>(Store{triangles});
+        state.ResumeTiming();
+
+        tree->build();
+        benchmark::ClobberMemory();
+
+        state.PauseTiming(); // the tree is freed outside the timed region
+        tree.reset();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(count));
+}
+
+// get_intersecting_triangles on one thread over a built tree, items are triangles
+void query(benchmark::State &state, Scene scene) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    Tree tree(Store{bench::cached_scene<float>(scene, count)});
+    tree.build();
+    state.SetLabel(std::string(bench::scene_name(scene)));
+
+    std::size_t hits = 0;
+    for (auto _ : state)
+        hits = tree.get_intersecting_triangles().size();
+
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(count));
+    state.counters["hits"] = static_cast<double>(hits);
+}
+
+void scene_sizes(benchmark::internal::Benchmark *benchmark) {
+    benchmark->RangeMultiplier(10)->Range(1'000, 10'000'000)->Unit(benchmark::kMillisecond);
+}
+
+} // namespace
+
+BENCHMARK_CAPTURE(build, uniform, Scene::uniform)->Apply(scene_sizes);
+BENCHMARK_CAPTURE(build, clustered, Scene::clustered)->Apply(scene_sizes);
+BENCHMARK_CAPTURE(build, sheet, Scene::sheet)->Apply(scene_sizes);
+BENCHMARK_CAPTURE(query, uniform, Scene::uniform)->Apply(scene_sizes);
+BENCHMARK_CAPTURE(query, clustered, Scene::clustered)->Apply(scene_sizes);
+BENCHMARK_CAPTURE(query, sheet, Scene::sheet)->Apply(scene_sizes);
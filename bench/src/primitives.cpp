@@ -0,0 +1,186 @@
+#include <benchmark/benchmark.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string_view>
+#include <vector>
+
+#include "BVH/AABB.hpp"
+#include "intersection/point_to_triangle.hpp"
+#include "intersection/triangle_to_triangle.hpp"
+#include "primitives/point.hpp"
+#include "primitives/triangle.hpp"
+#include "primitives/triangle_plane.hpp"
+
+// --------------------------------------------------------------------------------------
+//                  Microbenchmarks of the predicates and the narrowphase
+// --------------------------------------------------------------------------------------
+
+using namespace triangle;
+
+namespace {
+
+// every benchmark cycles through this many random inputs, more than the branch predictor
+// can learn and few enough to stay in L1
+constexpr std::size_t pool_size = 1024;
+
+template <std::floating_point T> struct Random {
+    std::mt19937_64 engine{42};
+    std::uniform_real_distribution<T> unit{0, 1};
+
+    T operator()() { return unit(engine); }
+    Point<T> point() { return Point<T>((*this)(), (*this)(), (*this)()); }
+    Point<T> point_at_z(T z) { return Point<T>((*this)(), (*this)(), z); }
+};
+
+template <std::floating_point T> struct TrianglePair {
+    Triangle<T> first, second;
+    TrianglePlane<T> first_plane, second_plane;
+
+    TrianglePair(const Triangle<T> &a, const Triangle<T> &b)
+        : first(a), second(b), first_plane(a), second_plane(b) {}
+};
+
+constexpr std::array<std::string_view, 5> sign_names{
+    "different (edges tested)", "separated (positive)", "separated (negative)",
+    "one vertex in the other plane", "coplanar"};
+
+// Pairs of non-degenerate triangles sorted by the branch of intersect_triangles that decides
+// them. General position gives the separated and the edge tested pairs; triangles in z = 0
+// and triangles with one vertex there give the coplanar and the vertex-in-plane ones.
+template <std::floating_point T> std::array<std::vector<TrianglePair<T>>, 5> make_sign_pools() {
+    Random<T> random;
+    std::array<std::vector<TrianglePair<T>>, 5> pools;
+
+    auto add = [&](const Triangle<T> &a, const Triangle<T> &b) {
+        if (a.get_type() != TypeTriangle::triangle || b.get_type() != TypeTriangle::triangle)
+            return;
+        TrianglePair<T> pair(a, b);
+        Sign branch = Sign::different;
+        intersect_triangles(pair.first, pair.first_plane, pair.second, pair.second_plane,
+                            [&](Sign sign) { branch = sign; });
+        auto &pool = pools[static_cast<std::size_t>(branch)];
+        if (pool.size() < pool_size)
+            pool.push_back(pair);
+    };
+
+    auto full = [&] {
+        for (const auto &pool : pools)
+            if (pool.size() < pool_size)
+                return false;
+        return true;
+    };
+
+    for (std::size_t attempt = 0; attempt < 1000 * pool_size && !full(); ++attempt) {
+        add(Triangle<T>(random.point(), random.point(), random.point()),
+            Triangle<T>(random.point(), random.point(), random.point()));
+
+        const Triangle<T> flat(random.point_at_z(0), random.point_at_z(0), random.point_at_z(0));
+        add(flat,
+            Triangle<T>(random.point_at_z(0), random.point_at_z(0), random.point_at_z(0)));
+        add(Triangle<T>(random.point_at_z(0), random.point_at_z(random() + T{0.1}),
+                        random.point_at_z(random() + T{0.1})),
+            flat);
+    }
+    return pools;
+}
+
+template <std::floating_point T> void orient_3d(benchmark::State &state) {
+    Random<T> random;
+    std::vector<std::array<Point<T>, 4>> points;
+    for (std::size_t i = 0; i < pool_size; ++i)
+        points.push_back({random.point(), random.point(), random.point(), random.point()});
+
+    std::size_t i = 0;
+    for (auto _ : state) {
+        const auto &[p, q, r, s] = points[i++ % pool_size];
+        benchmark::DoNotOptimize(triangle::orient_3d(p, q, r, s));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// boxes of random size, about half of the pairs overlap
+template <std::floating_point T> void aabb_intersect(benchmark::State &state) {
+    using Box = bounding_box::AABB<T>;
+
+    Random<T> random;
+    auto box = [&] {
+        const Point<T> corner = random.point();
+        const T size = random() / 2;
+        return Box(corner, Point<T>(corner.x_ + size, corner.y_ + size, corner.z_ + size));
+    };
+    std::vector<std::array<Box, 2>> boxes;
+    for (std::size_t i = 0; i < pool_size; ++i)
+        boxes.push_back({box(), box()});
+
+    std::size_t i = 0;
+    for (auto _ : state) {
+        const auto &[a, b] = boxes[i++ % pool_size];
+        benchmark::DoNotOptimize(Box::intersect(a, b));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// points in the plane of the triangle, about half of them inside
+template <std::floating_point T> void point_inside_triangle(benchmark::State &state) {
+    struct Query {
+        Triangle<T> triangle;
+        TrianglePlane<T> plane;
+        Point<T> point;
+    };
+
+    Random<T> random;
+    std::vector<Query> queries;
+    while (queries.size() < pool_size) {
+        const Triangle<T> tr(random.point(), random.point(), random.point());
+        if (tr.get_type() != TypeTriangle::triangle)
+            continue;
+        const TrianglePlane<T> plane(tr);
+        const T u = random(), v = random();
+        const Point<T> &a = tr.get_vertices()[0];
+        const Point<T> point(a.x_ + u * plane.edge_1.x_ + v * plane.edge_2.x_,
+                             a.y_ + u * plane.edge_1.y_ + v * plane.edge_2.y_,
+                             a.z_ + u * plane.edge_1.z_ + v * plane.edge_2.z_);
+        queries.push_back({tr, plane, point});
+    }
+
+    std::size_t i = 0;
+    for (auto _ : state) {
+        const Query &query = queries[i++ % pool_size];
+        benchmark::DoNotOptimize(
+            triangle::point_inside_triangle(query.triangle, query.plane, query.point));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// intersect() with precomputed planes, as the BVH calls it, on the pairs of one branch
+template <std::floating_point T> void intersect(benchmark::State &state) {
+    static const auto pools = make_sign_pools<T>();
+    const auto sign = static_cast<std::size_t>(state.range(0));
+    const auto &pairs = pools[sign];
+    state.SetLabel(std::string(sign_names[sign]));
+    if (pairs.empty()) {
+        state.SkipWithError("no pairs of this branch were generated");
+        return;
+    }
+
+    std::size_t i = 0;
+    for (auto _ : state) {
+        const TrianglePair<T> &pair = pairs[i++ % pairs.size()];
+        benchmark::DoNotOptimize(
+            triangle::intersect(pair.first, pair.first_plane, pair.second, pair.second_plane));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(orient_3d, float);
+BENCHMARK_TEMPLATE(orient_3d, double);
+BENCHMARK_TEMPLATE(aabb_intersect, float);
+BENCHMARK_TEMPLATE(aabb_intersect, double);
+BENCHMARK_TEMPLATE(point_inside_triangle, float);
+BENCHMARK_TEMPLATE(point_inside_triangle, double);
+BENCHMARK_TEMPLATE(intersect, float)->DenseRange(0, 4)->ArgName("sign");
+BENCHMARK_TEMPLATE(intersect, double)->DenseRange(0, 4)->ArgName("sign");
@@ -0,0 +1,115 @@
+#ifndef BENCH_SCENES_HPP
+#define BENCH_SCENES_HPP
+
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string_view>
+#include <vector>
+
+#include "primitives/point.hpp"
+#include "primitives/triangle_store.hpp"
+
+namespace bench {
+
+/* ---------- synthetic inputs of the macro benchmarks ---------- */
+// The scenes grow with the number of triangles at a constant density, so the pairs per
+// triangle stay about the same from 10^3 to 10^7 triangles.
+enum class Scene {
+    uniform,   // small triangles scattered over a cube
+    clustered, // the same triangles around 64 centers, about 8 times as dense
+    sheet      // a wavy height field meshed with triangles that share their edges
+};
+
+constexpr std::string_view scene_name(Scene scene) noexcept {
+    switch (scene) {
+    case Scene::uniform:
+        return "uniform";
+    case Scene::clustered:
+        return "clustered";
+    case Scene::sheet:
+        return "sheet";
+    }
+    return "";
+}
+
+template <std::floating_point T>
+triangle::TriangleStore<T> make_scene(Scene scene, std::size_t count, std::uint64_t seed = 1) {
+    using triangle::Point;
+
+    std::mt19937_64 random(seed);
+    triangle::TriangleStore<T> triangles;
+    triangles.reserve(count);
+
+    if (scene == Scene::sheet) {
+        // two triangles per grid cell over a square of about count / 2 cells
+        const auto side = static_cast<std::size_t>(std::ceil(std::sqrt(count / 2.0)));
+        auto vertex = [](std::size_t i, std::size_t j) {
+            const T x = static_cast<T>(i);
+            const T y = static_cast<T>(j);
+            return Point<T>(x, y, static_cast<T>(4 * std::sin(x / 8) * std::cos(y / 8)));
+        };
+        for (std::size_t j = 0; triangles.size() < count; ++j) {
+            for (std::size_t i = 0; i < side && triangles.size() < count; ++i) {
+                triangles.push_back(vertex(i, j), vertex(i + 1, j), vertex(i, j + 1),
+                                    triangles.size());
+                if (triangles.size() < count)
+                    triangles.push_back(vertex(i + 1, j), vertex(i + 1, j + 1),
+                                        vertex(i, j + 1), triangles.size());
+            }
+        }
+        return triangles;
+    }
+
+    // a cube of two units of edge per triangle
+    const T side = 2 * std::cbrt(static_cast<T>(count));
+    std::uniform_real_distribution<T> in_cube(0, side);
+    std::uniform_real_distribution<T> offset(-0.75, 0.75);
+
+    std::vector<Point<T>> clusters;
+    std::normal_distribution<T> around(0, side / 16);
+    if (scene == Scene::clustered)
+        for (int i = 0; i < 64; ++i)
+            clusters.emplace_back(in_cube(random), in_cube(random), in_cube(random));
+
+    for (std::size_t id = 0; id < count; ++id) {
+        Point<T> center(0, 0, 0);
+        if (clusters.empty()) {
+            center = Point<T>(in_cube(random), in_cube(random), in_cube(random));
+        } else {
+            const Point<T> &cluster = clusters[id % clusters.size()];
+            center = Point<T>(cluster.x_ + around(random), cluster.y_ + around(random),
+                              cluster.z_ + around(random));
+        }
+        auto vertex = [&] {
+            return Point<T>(center.x_ + offset(random), center.y_ + offset(random),
+                            center.z_ + offset(random));
+        };
+        const Point<T> a = vertex(), b = vertex(), c = vertex();
+        triangles.push_back(a, b, c, id);
+    }
+    return triangles;
+}
+
+// The last scene made, kept for the next run of the same benchmark: Google Benchmark calls a
+// benchmark several times while it settles on the number of iterations
+template <std::floating_point T>
+const triangle::TriangleStore<T> &cached_scene(Scene scene, std::size_t count) {
+    static Scene cached_kind = Scene::uniform;
+    static std::size_t cached_count = 0;
+    static triangle::TriangleStore<T> cached;
+
+    if (cached_count != count || cached_kind != scene) {
+        cached = triangle::TriangleStore<T>(); // one scene in memory at a time
+        cached = make_scene<T>(scene, count);
+        cached_kind = scene;
+        cached_count = count;
+    }
+    return cached;
+}
+
+} // namespace bench
+
+#endif // BENCH_SCENES_HPP
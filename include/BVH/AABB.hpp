@@ -5,6 +5,7 @@
 #include <span>
 
 #include "common/cmp.hpp"
+#include "common/simd.hpp"
 #include "primitives/point.hpp"
 
 namespace bounding_box {
@@ -28,6 +29,13 @@ template <std::floating_point T> struct AABB {
     }
 
     void wrap_in_box_with(const AABB &point) {
+        if constexpr (simd::has_xyz0<T>) {
+            using Lanes = simd::xyz0_t<T>;
+            min(Lanes::load(&p_min.x_), Lanes::load(&point.p_min.x_)).store(&p_min.x_);
+            max(Lanes::load(&p_max.x_), Lanes::load(&point.p_max.x_)).store(&p_max.x_);
+            return;
+        }
+
         p_min =
             triangle::Point(std::min(p_min.x_, point.p_min.x_), std::min(p_min.y_, point.p_min.y_),
                             std::min(p_min.z_, point.p_min.z_));
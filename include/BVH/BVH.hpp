@@ -2,20 +2,40 @@
 #define INCLUDE_BVH_HPP
 
 #include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
 #include <cstddef>
+#include <cstdint>
+#include <exception>
 #include <filesystem>
 #include <fstream>
+#include <limits>
 #include <memory>
+#include <numeric>
+#include <optional>
 #include <set>
 #include <span>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "BVH/AABB.hpp"
+#include "BVH/build_arrays.hpp"
+#include "BVH/candidate_pairs.hpp"
+#include "BVH/contact_buffer.hpp"
 #include "BVH/node.hpp"
+#include "BVH/query_stats.hpp"
+#include "common/parallel.hpp"
+#include "common/trace.hpp"
+#include "intersection/mixed_precision.hpp"
+#include "intersection/triangle_contact.hpp"
 #include "intersection/triangle_to_triangle.hpp"
+#include "intersection/triangle_to_triangle_batch.hpp"
 #include "primitives/triangle.hpp"
+#include "primitives/triangle_plane.hpp"
+#include "primitives/triangle_store.hpp"
 
 namespace bin_tree {
 
@@ -32,6 +52,9 @@ inline DumpPaths makeDumpPaths(std::string_view basename = "graph_dump") {
 }
 
 constexpr std::size_t max_number_of_triangles_in_leaf = 3;
+constexpr std::size_t default_queue_capacity = 64; // batches in flight between the two stages
+constexpr int contact_split_depth = 3; // node pair levels per doubling of the worker count
+constexpr long int traced_build_range = 1 << 12; // smallest build_node range with a trace span
 
 enum class Axis { axis_x = 0, axis_y = 1, axis_z = 2 };
 
@@ -39,85 +62,357 @@ template <std::floating_point T>
 bounding_box::AABB<T> calculate_bounding_box(const std::span<triangle::Triangle<T>> &triangles);
 
 /* ---------- Bounding Volume Hierarchy ---------- */
-template <std::floating_point T> class BVH {
+// Triangles is the container the tree is built over: the TriangleStore soup, or an
+// IndexedMesh whose triangles share their vertices
+template <std::floating_point T, triangle::triangle_columns Triangles = triangle::TriangleStore<T>>
+class BVH {
   private:
     std::unique_ptr<Node<T>> root_ = nullptr;
-    std::vector<triangle::Triangle<T>> triangles_;
+    Triangles triangles_;
+    std::vector<triangle::TrianglePlane<T>> planes_; // planes_[i] belongs to triangle i
     std::set<std::size_t> intersecting_triangles_;
+    ContactBuffer<T> contacts_;
+    triangle::EscalationCounters escalation_counters_;
 
   public:
-    BVH(std::vector<triangle::Triangle<T>> &&triangles) : triangles_(std::move(triangles)) {}
+    // the triangles are copied into the compact store and the vector is released
+    BVH(std::vector<triangle::Triangle<T>> &&triangles)
+        requires std::same_as<Triangles, triangle::TriangleStore<T>>
+        : triangles_(triangles) {
+        std::vector<triangle::Triangle<T>>().swap(triangles);
+    }
 
-    void build() {
-        if (triangles_.empty()) {
-            root_.reset();
-            return;
-        }
+    explicit BVH(Triangles &&triangles) : triangles_(std::move(triangles)) {}
 
-        root_ = build_node(0, static_cast<long int>(triangles_.size()));
+    // The build partitions a permutation of 32-bit indices over boxes and centers computed
+    // once up front, and reorders the triangles once at the end, so every leaf covers a
+    // contiguous range of them
+    void build() { build(nullptr, nullptr); }
+
+    // `box` is the box of all triangles, e.g. found by the loader; the build then skips its
+    // first pass over the triangle boxes
+    void build(const bounding_box::AABB<T> &box) { build(nullptr, &box); }
+
+    // `arrays` holds the boxes and centers of the triangles in their current order, e.g.
+    // computed while they were loaded; the build then only partitions
+    void build(const BuildArrays<T> &arrays, const bounding_box::AABB<T> &box) {
+        if (arrays.size() != triangles_.size())
+            throw std::invalid_argument("BVH::build: the build arrays do not match the triangles");
+        build(&arrays, &box);
     }
 
+    const Triangles &get_triangles() const noexcept { return triangles_; }
+
     void dump_graph() const;
+
+    // broadphase and narrowphase on the calling thread, one batch at a time
     std::set<std::size_t> &get_intersecting_triangles() {
+        const trace::Span span("query", triangles_.size());
+        intersecting_triangles_.clear();
+
+        std::array<CandidateBatch, number_of_pair_kinds> batches{
+            CandidateBatch(PairKind::triangle_triangle), CandidateBatch(PairKind::triangle_segment),
+            CandidateBatch(PairKind::segment_segment), CandidateBatch(PairKind::with_point)};
+
+        auto emit = [&](PairKind kind, std::uint32_t first, std::uint32_t second) {
+            CandidateBatch &batch = batches[static_cast<std::size_t>(kind)];
+            batch.push(first, second);
+            if (batch.full()) {
+                process_batch(batch);
+                batch.clear();
+            }
+        };
+
+        collect_candidate_pairs(root_, root_, emit);
+        for (const auto &batch : batches)
+            process_batch(batch);
+
+        return intersecting_triangles_;
+    }
+
+    // broadphase on a worker thread, narrowphase on the calling thread
+    std::set<std::size_t> &
+    get_intersecting_triangles_pipelined(std::size_t queue_capacity = default_queue_capacity) {
+        const trace::Span span("query", triangles_.size());
         intersecting_triangles_.clear();
-        get_intersecting_triangles_in_current_node(root_, root_);
+
+        using BatchPtr = std::unique_ptr<CandidateBatch>;
+        BoundedQueue<BatchPtr> queue(queue_capacity);
+        std::exception_ptr broadphase_error;
+
+        std::jthread broadphase([&] {
+            const trace::Span span("broadphase");
+            try {
+                std::array<BatchPtr, number_of_pair_kinds> batches;
+                for (std::size_t kind = 0; kind < number_of_pair_kinds; ++kind)
+                    batches[kind] = std::make_unique<CandidateBatch>(static_cast<PairKind>(kind));
+
+                bool consumer_alive = true;
+
+                auto emit = [&](PairKind kind, std::uint32_t first, std::uint32_t second) {
+                    if (!consumer_alive)
+                        return;
+
+                    BatchPtr &batch = batches[static_cast<std::size_t>(kind)];
+                    batch->push(first, second);
+                    if (batch->full()) {
+                        consumer_alive = queue.push(std::move(batch));
+                        batch = std::make_unique<CandidateBatch>(kind);
+                    }
+                };
+
+                collect_candidate_pairs(root_, root_, emit);
+
+                for (auto &batch : batches) {
+                    if (consumer_alive && !batch->empty())
+                        consumer_alive = queue.push(std::move(batch));
+                }
+            } catch (...) {
+                broadphase_error = std::current_exception();
+            }
+            queue.close();
+        });
+
+        try {
+            while (auto batch = queue.pop())
+                process_batch(**batch);
+        } catch (...) {
+            queue.close();
+            throw;
+        }
+
+        broadphase.join();
+        if (broadphase_error)
+            std::rethrow_exception(broadphase_error);
+
         return intersecting_triangles_;
     }
 
+    // get_intersecting_triangles with the narrowphase in float and the uncertain pairs
+    // re-evaluated in double, see intersection/mixed_precision.hpp
+    std::set<std::size_t> &get_intersecting_triangles_mixed()
+        requires std::same_as<T, float>
+    {
+        intersecting_triangles_.clear();
+        escalation_counters_ = {};
+
+        std::vector<triangle::Vector<T>> magnitudes;
+        magnitudes.reserve(planes_.size());
+        for (const auto &plane : planes_)
+            magnitudes.push_back(triangle::normal_magnitude(plane));
+
+        auto emit = [&](PairKind kind, std::uint32_t first, std::uint32_t second) {
+            const triangle::Triangle<T> a = triangles_.get_triangle(first);
+            const triangle::Triangle<T> b = triangles_.get_triangle(second);
+
+            const bool hit =
+                kind == PairKind::triangle_triangle
+                    ? triangle::intersect_triangles_mixed(a, planes_[first], magnitudes[first], b,
+                                                          planes_[second], magnitudes[second],
+                                                          escalation_counters_)
+                    : triangle::intersect_mixed(a, b, escalation_counters_);
+            if (hit) {
+                intersecting_triangles_.insert(a.get_id());
+                intersecting_triangles_.insert(b.get_id());
+            }
+        };
+        collect_candidate_pairs(root_, root_, emit);
+
+        return intersecting_triangles_;
+    }
+
+    // get_intersecting_triangles one candidate pair at a time through the scalar tests, with
+    // what the broadphase and the narrowphase did in `counters`; slower, for the --stats mode
+    std::set<std::size_t> &get_intersecting_triangles_counted(QueryCounters &counters) {
+        intersecting_triangles_.clear();
+        counters = {};
+
+        auto emit = [&](PairKind kind, std::uint32_t first, std::uint32_t second) {
+            if (intersect_counted(kind, first, second, counters)) {
+                ++counters.hits;
+                intersecting_triangles_.insert(triangles_.get_id(first));
+                intersecting_triangles_.insert(triangles_.get_id(second));
+            }
+        };
+        CountTraversal traversal{counters};
+        collect_candidate_pairs(root_, root_, emit, traversal);
+
+        return intersecting_triangles_;
+    }
+
+    TreeShape get_tree_shape() const {
+        TreeShape shape;
+        shape.triangles = triangles_.size();
+        measure_tree(root_, 1, shape);
+        return shape;
+    }
+
+    // counters of the last get_intersecting_triangles_mixed()
+    const triangle::EscalationCounters &get_escalation_counters() const noexcept {
+        return escalation_counters_;
+    }
+
+    // intersection geometry of every intersecting pair, on the calling thread
+    ContactBuffer<T> &get_contacts() {
+        contacts_.clear();
+
+        auto emit = [this](PairKind, std::uint32_t first, std::uint32_t second) {
+            push_contact(contacts_, first, second);
+        };
+        collect_candidate_pairs(root_, root_, emit);
+
+        return contacts_;
+    }
+
+    // The same query over the node pairs a few levels below the root, shared by
+    // `number_of_threads` workers. Every node pair has its own buffer and the buffers are
+    // joined in traversal order, so the result equals get_contacts() for any thread count.
+    ContactBuffer<T> &
+    get_contacts_parallel(std::size_t number_of_threads = std::thread::hardware_concurrency()) {
+        contacts_.clear();
+        number_of_threads = std::max<std::size_t>(number_of_threads, 1);
+
+        std::vector<NodePair> tasks;
+        split_node_pairs(root_, root_, contact_split_depth * std::bit_width(number_of_threads),
+                         tasks);
+
+        std::vector<ContactBuffer<T>> results(tasks.size());
+        parallel::run_tasks(tasks.size(), number_of_threads, [&](std::size_t i) {
+            const trace::Span span("traversal task", i);
+            auto emit = [&](PairKind, std::uint32_t first, std::uint32_t second) {
+                push_contact(results[i], first, second);
+            };
+            collect_candidate_pairs(*tasks[i].first, *tasks[i].second, emit);
+        });
+
+        for (const auto &result : results)
+            contacts_.append(result);
+        return contacts_;
+    }
+
   private:
-    std::unique_ptr<Node<T>> build_node(long int start, long int end) {
-        std::span<triangle::Triangle<T>> triangles(triangles_.begin() + start,
-                                                   triangles_.begin() + end);
+    using NodePair = std::pair<const std::unique_ptr<Node<T>> *, const std::unique_ptr<Node<T>> *>;
+
+    void build(const BuildArrays<T> *arrays, const bounding_box::AABB<T> *box) {
+        if (triangles_.empty()) {
+            root_.reset();
+            planes_.clear();
+            return;
+        }
 
+        if (triangles_.size() > std::numeric_limits<std::uint32_t>::max())
+            throw std::length_error("BVH supports at most 2^32 - 1 triangles");
+
+        const trace::Span span("build", triangles_.size());
+        std::vector<std::uint32_t> order(triangles_.size());
+        std::iota(order.begin(), order.end(), std::uint32_t{0});
+
+        std::optional<BuildArrays<T>> computed;
+        if (!arrays)
+            arrays = &computed.emplace(triangles_);
+
+        root_ = build_buckets(order, *arrays, box);
+        computed.reset(); // the boxes and centers built here are not needed past the partition
+        {
+            const trace::Span permute_span("permute", order.size());
+            triangles_.permute(order);
+        }
+
+        const trace::Span planes_span("planes", triangles_.size());
+        planes_.clear();
+        planes_.reserve(triangles_.size());
+        for (std::size_t i = 0; i < triangles_.size(); ++i)
+            planes_.emplace_back(triangles_.get_triangle(i));
+    }
+
+    // Sorts the triangles into type buckets (triangles, segments, points) and builds one
+    // subtree per bucket, so that every leaf holds a single TypeTriangle. `box`, if given,
+    // is the box of all triangles.
+    std::unique_ptr<Node<T>> build_buckets(std::vector<std::uint32_t> &order,
+                                           const BuildArrays<T> &arrays,
+                                           const bounding_box::AABB<T> *box) {
+        auto is_triangle = [this](std::uint32_t i) {
+            return triangles_.get_type(i) == triangle::TypeTriangle::triangle;
+        };
+        auto is_interval = [this](std::uint32_t i) {
+            return triangles_.get_type(i) == triangle::TypeTriangle::interval;
+        };
+
+        const auto intervals_begin = std::stable_partition(order.begin(), order.end(), is_triangle);
+        const auto points_begin = std::stable_partition(intervals_begin, order.end(), is_interval);
+
+        const std::array<long int, 4> bounds{0, intervals_begin - order.begin(),
+                                             points_begin - order.begin(),
+                                             static_cast<long int>(order.size())};
+
+        std::unique_ptr<Node<T>> root = nullptr;
+        for (std::size_t bucket = 3; bucket-- > 0;) {
+            if (bounds[bucket] == bounds[bucket + 1])
+                continue;
+
+            const bool whole = bounds[bucket] == 0 && bounds[bucket + 1] == bounds[3];
+            auto subtree = build_node(order, arrays, bounds[bucket], bounds[bucket + 1],
+                                      whole ? box : nullptr);
+            if (!root) {
+                root = std::move(subtree);
+                continue;
+            }
+
+            auto node = std::make_unique<Node<T>>();
+            bounding_box::AABB<T> box = subtree->get_box();
+            box.wrap_in_box_with(root->get_box());
+            node->set_box(box);
+            node->set_left(std::move(subtree));
+            node->set_right(std::move(root));
+            root = std::move(node);
+        }
+        return root;
+    }
+
+    // `known_box`, if given, is the box of the triangles in [start, end)
+    std::unique_ptr<Node<T>> build_node(std::vector<std::uint32_t> &order,
+                                        const BuildArrays<T> &arrays, long int start, long int end,
+                                        const bounding_box::AABB<T> *known_box = nullptr) {
+        const trace::Span span(end - start >= traced_build_range ? "build_node" : nullptr,
+                               static_cast<std::uint64_t>(end - start));
         auto node = std::make_unique<Node<T>>();
 
-        bounding_box::AABB<T> box = calculate_bounding_box(triangles);
+        bounding_box::AABB<T> box;
+        if (known_box) {
+            box = *known_box;
+        } else {
+            for (long int k = start; k < end; ++k)
+                box.wrap_in_box_with(arrays.boxes[order[k]]);
+        }
         node->set_box(box);
 
         const long int count = end - start;
         if (count <= static_cast<long int>(max_number_of_triangles_in_leaf)) {
-            std::span<triangle::Triangle<T>> all{triangles_.data(), triangles_.size()};
-            node->set_triangles(
-                all.subspan(static_cast<std::size_t>(start), static_cast<std::size_t>(count)));
+            node->set_triangles(static_cast<std::uint32_t>(start),
+                                static_cast<std::uint32_t>(count));
             return node;
         }
 
-        const Axis axis = longest_axis(box);
-
-        auto comp = [axis](const triangle::Triangle<T> &a, const triangle::Triangle<T> &b) {
-            const Axis i = axis;
-
-            switch (i) {
-            case Axis::axis_x:
-                return a.get_box().get_center().x_ < b.get_box().get_center().x_;
-                break;
-            case Axis::axis_y:
-                return a.get_box().get_center().y_ < b.get_box().get_center().y_;
-                break;
-            case Axis::axis_z:
-                return a.get_box().get_center().z_ < b.get_box().get_center().z_;
-                break;
-            default:
-                throw std::out_of_range("Point index");
-            }
-            // return a.get_box().get_center()[i] < b.get_box().get_center()[i];
-        };
+        const auto axis = static_cast<std::size_t>(longest_axis(box));
 
-        triangle::Triangle<T> *first = triangles_.data() + start;
-        triangle::Triangle<T> *last = triangles_.data() + end;
-        triangle::Triangle<T> *midIt = first + count / 2;
+        const T *centers = arrays.centers[axis].data();
+        auto comp = [centers](std::uint32_t a, std::uint32_t b) { return centers[a] < centers[b]; };
+
+        std::uint32_t *first = order.data() + start;
+        std::uint32_t *last = order.data() + end;
+        std::uint32_t *midIt = first + count / 2;
 
         std::nth_element(first, midIt, last, comp);
         const long int mid = start + count / 2;
 
-        node->set_left(build_node(start, mid));
-        node->set_right(build_node(mid, end));
+        node->set_left(build_node(order, arrays, start, mid));
+        node->set_right(build_node(order, arrays, mid, end));
 
         return node;
     }
 
     Axis longest_axis(const bounding_box::AABB<T> &box) {
-        triangle::Vector v(box.p_max, box.p_min);
+        triangle::Vector v(box.p_min, box.p_max);
 
         T v_x = v.x_;
         T v_y = v.y_;
@@ -135,68 +430,243 @@ template <std::floating_point T> class BVH {
     void dump_graph_list_nodes(const std::unique_ptr<Node<T>> &node, std::ofstream &gv) const;
     void dump_graph_connect_nodes(const std::unique_ptr<Node<T>> &node, std::ofstream &gv) const;
 
-    void get_intersecting_triangles_in_current_node(const std::unique_ptr<Node<T>> &a,
-                                                    const std::unique_ptr<Node<T>> &b) {
-        if (!a || !b)
+    static void measure_tree(const std::unique_ptr<Node<T>> &node, std::size_t depth,
+                             TreeShape &shape) {
+        if (!node)
             return;
-        if (!bounding_box::AABB<T>::intersect(a->get_box(), b->get_box())) {
+
+        ++shape.nodes;
+        shape.depth = std::max(shape.depth, depth);
+        if (node->is_branch()) {
+            ++shape.leaves;
             return;
         }
+        measure_tree(node->get_left(), depth + 1, shape);
+        measure_tree(node->get_right(), depth + 1, shape);
+    }
+
+    // observers of collect_candidate_pairs: box_test(passed) for every node pair it visits,
+    // leaf_pair() for every overlapping pair of leaves
+    struct IgnoreTraversal {
+        void box_test(bool) const noexcept {}
+        void leaf_pair() const noexcept {}
+    };
+
+    struct CountTraversal {
+        QueryCounters &counters;
+
+        void box_test(bool passed) noexcept {
+            ++(passed ? counters.box_tests_passed : counters.box_tests_failed);
+        }
+        void leaf_pair() noexcept { ++counters.leaf_pairs; }
+    };
+
+    template <typename Sink>
+    void collect_candidate_pairs(const std::unique_ptr<Node<T>> &a,
+                                 const std::unique_ptr<Node<T>> &b, Sink &emit) const {
+        IgnoreTraversal ignore;
+        collect_candidate_pairs(a, b, emit, ignore);
+    }
+
+    template <typename Sink, typename Observer>
+    void collect_candidate_pairs(const std::unique_ptr<Node<T>> &a,
+                                 const std::unique_ptr<Node<T>> &b, Sink &emit,
+                                 Observer &observer) const {
+        if (!a || !b)
+            return;
+        const bool overlap = bounding_box::AABB<T>::intersect(a->get_box(), b->get_box());
+        observer.box_test(overlap);
+        if (!overlap)
+            return;
 
         const bool a_is_leaf = a->is_branch();
         const bool b_is_leaf = b->is_branch();
 
         if (a_is_leaf && b_is_leaf) {
-            auto ta = a->get_triangles();
-            auto tb = b->get_triangles();
-
-            if (a.get() == b.get()) {
-                for (std::size_t i = 0; i < ta.size(); ++i) {
-                    for (std::size_t j = i + 1; j < tb.size(); ++j) {
-                        if (triangle::intersect(ta[i], tb[j])) {
-                            intersecting_triangles_.insert(ta[i].get_id());
-                            intersecting_triangles_.insert(tb[j].get_id());
-                        }
-                    }
-                }
-            } else {
-                for (const auto &A : ta) {
-                    for (const auto &B : tb) {
-                        if (triangle::intersect(A, B)) {
-                            intersecting_triangles_.insert(A.get_id());
-                            intersecting_triangles_.insert(B.get_id());
-                        }
-                    }
-                }
-            }
+            observer.leaf_pair();
+            // leaves are type-homogeneous: the lower type goes first
+            if (triangles_.get_type(b->get_first_triangle()) <
+                triangles_.get_type(a->get_first_triangle()))
+                emit_leaf_pairs(*b, *a, emit);
+            else
+                emit_leaf_pairs(*a, *b, emit);
             return;
         }
 
         if (a_is_leaf && !b_is_leaf) {
-            get_intersecting_triangles_in_current_node(a, b->get_left());
-            get_intersecting_triangles_in_current_node(a, b->get_right());
+            collect_candidate_pairs(a, b->get_left(), emit, observer);
+            collect_candidate_pairs(a, b->get_right(), emit, observer);
             return;
         }
         if (!a_is_leaf && b_is_leaf) {
-            get_intersecting_triangles_in_current_node(a->get_left(), b);
-            get_intersecting_triangles_in_current_node(a->get_right(), b);
+            collect_candidate_pairs(a->get_left(), b, emit, observer);
+            collect_candidate_pairs(a->get_right(), b, emit, observer);
             return;
         }
 
         if (a.get() == b.get()) {
-            get_intersecting_triangles_in_current_node(a->get_left(), a->get_left());
-            get_intersecting_triangles_in_current_node(a->get_left(), a->get_right());
-            get_intersecting_triangles_in_current_node(a->get_right(), a->get_right());
+            collect_candidate_pairs(a->get_left(), a->get_left(), emit, observer);
+            collect_candidate_pairs(a->get_left(), a->get_right(), emit, observer);
+            collect_candidate_pairs(a->get_right(), a->get_right(), emit, observer);
+        } else {
+            collect_candidate_pairs(a->get_left(), b->get_left(), emit, observer);
+            collect_candidate_pairs(a->get_left(), b->get_right(), emit, observer);
+            collect_candidate_pairs(a->get_right(), b->get_left(), emit, observer);
+            collect_candidate_pairs(a->get_right(), b->get_right(), emit, observer);
+        }
+    }
+
+    // node pairs `depth` levels down the recursion of collect_candidate_pairs, in its order
+    void split_node_pairs(const std::unique_ptr<Node<T>> &a, const std::unique_ptr<Node<T>> &b,
+                          int depth, std::vector<NodePair> &pairs) const {
+        if (!a || !b || !bounding_box::AABB<T>::intersect(a->get_box(), b->get_box()))
+            return;
+
+        if (depth == 0 || (a->is_branch() && b->is_branch())) {
+            pairs.emplace_back(&a, &b);
+            return;
+        }
+
+        if (a->is_branch()) {
+            split_node_pairs(a, b->get_left(), depth - 1, pairs);
+            split_node_pairs(a, b->get_right(), depth - 1, pairs);
+        } else if (b->is_branch()) {
+            split_node_pairs(a->get_left(), b, depth - 1, pairs);
+            split_node_pairs(a->get_right(), b, depth - 1, pairs);
+        } else if (a.get() == b.get()) {
+            split_node_pairs(a->get_left(), a->get_left(), depth - 1, pairs);
+            split_node_pairs(a->get_left(), a->get_right(), depth - 1, pairs);
+            split_node_pairs(a->get_right(), a->get_right(), depth - 1, pairs);
         } else {
-            get_intersecting_triangles_in_current_node(a->get_left(), b->get_left());
-            get_intersecting_triangles_in_current_node(a->get_left(), b->get_right());
-            get_intersecting_triangles_in_current_node(a->get_right(), b->get_left());
-            get_intersecting_triangles_in_current_node(a->get_right(), b->get_right());
+            split_node_pairs(a->get_left(), b->get_left(), depth - 1, pairs);
+            split_node_pairs(a->get_left(), b->get_right(), depth - 1, pairs);
+            split_node_pairs(a->get_right(), b->get_left(), depth - 1, pairs);
+            split_node_pairs(a->get_right(), b->get_right(), depth - 1, pairs);
+        }
+    }
+
+    void push_contact(ContactBuffer<T> &contacts, std::uint32_t first,
+                      std::uint32_t second) const {
+        const triangle::Triangle<T> a = triangles_.get_triangle(first);
+        const triangle::Triangle<T> b = triangles_.get_triangle(second);
+        if (!bounding_box::AABB<T>::intersect(a.get_box(), b.get_box()))
+            return;
+
+        const auto contact = triangle::intersection(a, planes_[first], b, planes_[second]);
+        if (!contact.empty())
+            contacts.push(a.get_id(), b.get_id(), contact);
+    }
+
+    // one candidate pair through the test process_batch uses for its kind; triangle pairs are
+    // counted by the branch of intersect_triangles that decided them
+    bool intersect_counted(PairKind kind, std::uint32_t first, std::uint32_t second,
+                           QueryCounters &counters) const {
+        auto count = [&counters](triangle::Sign branch) {
+            ++counters.triangle_pairs[static_cast<std::size_t>(branch)];
+        };
+
+        if (kind == PairKind::triangle_triangle)
+            return triangle::intersect_triangles(
+                triangle::detail::get_vertices<T>(triangles_, first), planes_[first],
+                triangle::detail::get_vertices<T>(triangles_, second), planes_[second], count);
+
+        const triangle::Triangle<T> a = triangles_.get_triangle(first);
+        const triangle::Triangle<T> b = triangles_.get_triangle(second);
+
+        switch (kind) {
+        case PairKind::triangle_triangle:
+            break;
+        case PairKind::triangle_segment:
+            ++counters.triangle_segment_pairs;
+            return triangle::segment_intersect_proper_triangle(a, b);
+        case PairKind::segment_segment:
+            ++counters.segment_segment_pairs;
+            return triangle::segment_intersect_segment(a, b);
+        case PairKind::with_point:
+            ++counters.point_pairs;
+            return triangle::point_inside_triangle(a, planes_[first],
+                                                   triangles_.get_vertex(second, 0));
+        }
+        return false;
+    }
+
+    static PairKind get_pair_kind(triangle::TypeTriangle lower, triangle::TypeTriangle upper) {
+        using triangle::TypeTriangle;
+
+        if (upper == TypeTriangle::point)
+            return PairKind::with_point;
+        if (lower == TypeTriangle::interval)
+            return PairKind::segment_segment;
+        if (upper == TypeTriangle::interval)
+            return PairKind::triangle_segment;
+        return PairKind::triangle_triangle;
+    }
+
+    template <typename Sink>
+    void emit_leaf_pairs(const Node<T> &a, const Node<T> &b, Sink &emit) const {
+        const PairKind kind = get_pair_kind(triangles_.get_type(a.get_first_triangle()),
+                                            triangles_.get_type(b.get_first_triangle()));
+
+        const std::uint32_t base_a = a.get_first_triangle();
+        const std::uint32_t base_b = b.get_first_triangle();
+        const auto size_a = static_cast<std::uint32_t>(a.get_number_of_triangles());
+        const auto size_b = static_cast<std::uint32_t>(b.get_number_of_triangles());
+
+        if (&a == &b) {
+            for (std::uint32_t i = 0; i < size_a; ++i)
+                for (std::uint32_t j = i + 1; j < size_b; ++j)
+                    emit(kind, base_a + i, base_b + j);
+        } else {
+            for (std::uint32_t i = 0; i < size_a; ++i)
+                for (std::uint32_t j = 0; j < size_b; ++j)
+                    emit(kind, base_a + i, base_b + j);
+        }
+    }
+
+    // one kernel per batch: the pairs of a batch share their type combination
+    void process_batch(const CandidateBatch &batch) {
+        const trace::Span span("narrowphase batch", batch.get_pairs().size());
+        auto on_hit = [this](const CandidatePair &pair) {
+            intersecting_triangles_.insert(triangles_.get_id(pair.first));
+            intersecting_triangles_.insert(triangles_.get_id(pair.second));
+        };
+
+        auto for_each_hit = [&](auto &&intersect) {
+            for (const CandidatePair &pair : batch.get_pairs()) {
+                if (intersect(triangles_.get_triangle(pair.first),
+                              triangles_.get_triangle(pair.second)))
+                    on_hit(pair);
+            }
+        };
+
+        switch (batch.get_kind()) {
+        case PairKind::triangle_triangle:
+            triangle::intersect_triangle_pairs<T>(triangles_, planes_, batch.get_pairs(), on_hit);
+            break;
+        case PairKind::triangle_segment:
+            for_each_hit([](const auto &tr, const auto &segment) {
+                return triangle::segment_intersect_proper_triangle(tr, segment);
+            });
+            break;
+        case PairKind::segment_segment:
+            for_each_hit([](const auto &first, const auto &second) {
+                return triangle::segment_intersect_segment(first, second);
+            });
+            break;
+        case PairKind::with_point:
+            for (const CandidatePair &pair : batch.get_pairs()) {
+                if (triangle::point_inside_triangle(triangles_.get_triangle(pair.first),
+                                                    planes_[pair.first],
+                                                    triangles_.get_vertex(pair.second, 0)))
+                    on_hit(pair);
+            }
+            break;
         }
     }
 };
 
-template <std::floating_point T> void BVH<T>::dump_graph() const {
+template <std::floating_point T, triangle::triangle_columns Triangles>
+void BVH<T, Triangles>::dump_graph() const {
 
     const auto paths = makeDumpPaths();
     const std::string gvFile = paths.gv.string();
@@ -222,8 +692,9 @@ template <std::floating_point T> void BVH<T>::dump_graph() const {
     std::system(("dot " + gvFile + " -Tsvg -o " + svgFile).c_str());
 }
 
-template <std::floating_point T>
-void BVH<T>::dump_graph_list_nodes(const std::unique_ptr<Node<T>> &node, std::ofstream &gv) const {
+template <std::floating_point T, triangle::triangle_columns Triangles>
+void BVH<T, Triangles>::dump_graph_list_nodes(const std::unique_ptr<Node<T>> &node,
+                                              std::ofstream &gv) const {
     if (!node)
         return;
 
@@ -254,9 +725,9 @@ void BVH<T>::dump_graph_list_nodes(const std::unique_ptr<Node<T>> &node, std::of
         dump_graph_list_nodes(node->get_right(), gv);
 }
 
-template <std::floating_point T>
-void BVH<T>::dump_graph_connect_nodes(const std::unique_ptr<Node<T>> &node,
-                                      std::ofstream &gv) const {
+template <std::floating_point T, triangle::triangle_columns Triangles>
+void BVH<T, Triangles>::dump_graph_connect_nodes(const std::unique_ptr<Node<T>> &node,
+                                                 std::ofstream &gv) const {
     if (!node)
         return;
 
@@ -0,0 +1,49 @@
+#ifndef INCLUDE_BVH_BUILD_ARRAYS_HPP
+#define INCLUDE_BVH_BUILD_ARRAYS_HPP
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <vector>
+
+#include "BVH/AABB.hpp"
+#include "primitives/triangle_store.hpp"
+
+namespace bin_tree {
+
+/* ---------- per-triangle input of the BVH build ---------- */
+// Boxes and box centers, indexed like the triangles before the build reorders them. They are
+// computed once up front, either from the triangles or block by block while they are loaded.
+template <std::floating_point T> struct BuildArrays {
+    std::vector<bounding_box::AABB<T>> boxes;
+    std::array<std::vector<T>, 3> centers; // centers[axis][i]
+
+    BuildArrays() = default;
+
+    template <triangle::triangle_columns Triangles>
+    explicit BuildArrays(const Triangles &triangles) {
+        reserve(triangles.size());
+        for (std::size_t i = 0; i < triangles.size(); ++i)
+            push_back(triangles.get_box(i));
+    }
+
+    std::size_t size() const noexcept { return boxes.size(); }
+
+    void reserve(std::size_t n) {
+        boxes.reserve(n);
+        for (auto &column : centers)
+            column.reserve(n);
+    }
+
+    // the center is the one get_center of the triangle containers computes
+    void push_back(const bounding_box::AABB<T> &box) {
+        boxes.push_back(box);
+        centers[0].push_back((box.p_max.x_ + box.p_min.x_) / 2);
+        centers[1].push_back((box.p_max.y_ + box.p_min.y_) / 2);
+        centers[2].push_back((box.p_max.z_ + box.p_min.z_) / 2);
+    }
+};
+
+} // namespace bin_tree
+
+#endif // INCLUDE_BVH_BUILD_ARRAYS_HPP
@@ -0,0 +1,124 @@
+#ifndef INCLUDE_CANDIDATE_PAIRS_HPP
+#define INCLUDE_CANDIDATE_PAIRS_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <semaphore>
+#include <span>
+#include <stdexcept>
+
+namespace bin_tree {
+
+/* ---------- pair of triangle indices produced by the broadphase ---------- */
+struct CandidatePair {
+    std::uint32_t first;
+    std::uint32_t second;
+};
+
+constexpr std::size_t candidate_batch_size = 256;
+
+// type combination of a pair; `first` always holds the lower TypeTriangle
+enum class PairKind : std::uint8_t {
+    triangle_triangle,
+    triangle_segment,
+    segment_segment,
+    with_point, // `second` is a point, `first` anything
+};
+
+constexpr std::size_t number_of_pair_kinds = 4;
+
+/* ---------- fixed-size batch of candidate pairs ---------- */
+class CandidateBatch {
+  private:
+    std::array<CandidatePair, candidate_batch_size> pairs_;
+    std::size_t size_ = 0;
+    PairKind kind_;
+
+  public:
+    explicit CandidateBatch(PairKind kind = PairKind::triangle_triangle) noexcept : kind_(kind) {}
+
+    PairKind get_kind() const noexcept { return kind_; }
+
+    void push(std::uint32_t first, std::uint32_t second) noexcept {
+        pairs_[size_++] = CandidatePair{first, second};
+    }
+
+    void clear() noexcept { size_ = 0; }
+
+    bool full() const noexcept { return size_ == candidate_batch_size; }
+    bool empty() const noexcept { return size_ == 0; }
+    std::size_t size() const noexcept { return size_; }
+
+    std::span<const CandidatePair> get_pairs() const noexcept { return {pairs_.data(), size_}; }
+};
+
+/* ---------- blocking queue with a fixed capacity ---------- */
+template <typename Item> class BoundedQueue {
+  private:
+    using Semaphore = std::counting_semaphore<>;
+
+    std::deque<Item> items_;
+    bool closed_ = false;
+    std::mutex mutex_;
+
+    Semaphore free_slots_;
+    Semaphore ready_items_{0};
+
+  public:
+    explicit BoundedQueue(std::size_t capacity)
+        : free_slots_(static_cast<std::ptrdiff_t>(capacity)) {
+        if (capacity == 0)
+            throw std::invalid_argument("BoundedQueue capacity must be positive");
+    }
+
+    // blocks while the queue is full; returns false if the queue was closed
+    bool push(Item item) {
+        free_slots_.acquire();
+        {
+            std::lock_guard lock(mutex_);
+            if (closed_) {
+                free_slots_.release(); // pass the wake-up on to the next blocked producer
+                return false;
+            }
+            items_.push_back(std::move(item));
+        }
+        ready_items_.release();
+        return true;
+    }
+
+    // blocks while the queue is empty; returns nullopt once it is closed and drained
+    std::optional<Item> pop() {
+        ready_items_.acquire();
+        std::optional<Item> item;
+        {
+            std::lock_guard lock(mutex_);
+            if (items_.empty()) {
+                ready_items_.release(); // only reachable after close()
+                return std::nullopt;
+            }
+            item.emplace(std::move(items_.front()));
+            items_.pop_front();
+        }
+        free_slots_.release();
+        return item;
+    }
+
+    void close() {
+        {
+            std::lock_guard lock(mutex_);
+            if (closed_)
+                return;
+            closed_ = true;
+        }
+        free_slots_.release();
+        ready_items_.release();
+    }
+};
+
+} // namespace bin_tree
+
+#endif // INCLUDE_CANDIDATE_PAIRS_HPP
@@ -0,0 +1,74 @@
+#ifndef INCLUDE_CONTACT_BUFFER_HPP
+#define INCLUDE_CONTACT_BUFFER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "primitives/contact.hpp"
+#include "primitives/point.hpp"
+
+namespace bin_tree {
+
+/* ---------- one intersecting pair; its vertices are a range of the shared array ---------- */
+struct ContactRecord {
+    std::size_t first_id;
+    std::size_t second_id;
+    std::uint32_t offset;
+    std::uint32_t size; // 1: point, 2: segment, 3 to 6: coplanar polygon
+};
+
+/* ---------- contacts of a query, packed into two flat arrays ---------- */
+template <std::floating_point T> class ContactBuffer {
+  private:
+    std::vector<ContactRecord> records_;
+    std::vector<triangle::Point<T>> vertices_;
+
+  public:
+    void push(std::size_t first_id, std::size_t second_id, const triangle::Contact<T> &contact) {
+        const auto points = contact.get_vertices();
+        records_.push_back(ContactRecord{first_id, second_id, next_offset(points.size()),
+                                         static_cast<std::uint32_t>(points.size())});
+        vertices_.insert(vertices_.end(), points.begin(), points.end());
+    }
+
+    // the contacts of `other` go behind the current ones
+    void append(const ContactBuffer &other) {
+        const std::uint32_t shift = next_offset(other.vertices_.size());
+
+        records_.reserve(records_.size() + other.records_.size());
+        for (ContactRecord record : other.records_) {
+            record.offset += shift;
+            records_.push_back(record);
+        }
+        vertices_.insert(vertices_.end(), other.vertices_.begin(), other.vertices_.end());
+    }
+
+    void clear() noexcept {
+        records_.clear();
+        vertices_.clear();
+    }
+
+    bool empty() const noexcept { return records_.empty(); }
+    std::size_t size() const noexcept { return records_.size(); }
+
+    std::span<const ContactRecord> get_records() const noexcept { return records_; }
+
+    std::span<const triangle::Point<T>> get_vertices(const ContactRecord &record) const noexcept {
+        return std::span<const triangle::Point<T>>(vertices_).subspan(record.offset, record.size);
+    }
+
+  private:
+    std::uint32_t next_offset(std::size_t added) const {
+        if (vertices_.size() + added > std::numeric_limits<std::uint32_t>::max())
+            throw std::length_error("ContactBuffer supports at most 2^32 - 1 vertices");
+        return static_cast<std::uint32_t>(vertices_.size());
+    }
+};
+
+} // namespace bin_tree
+
+#endif // INCLUDE_CONTACT_BUFFER_HPP
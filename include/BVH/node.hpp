@@ -2,18 +2,18 @@
 #define INCLUDE_NODE_HPP
 
 #include "AABB.hpp"
-#include "primitives/triangle.hpp"
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
 #include <memory>
-#include <span>
-#include <vector>
 
 namespace bin_tree {
 
 template <std::floating_point T> class Node {
   private:
     bounding_box::AABB<T> box_;
-    std::span<triangle::Triangle<T>> triangles_;
+    std::uint32_t first_ = 0; // leaf triangles: [first_, first_ + count_) of the BVH store
+    std::uint32_t count_ = 0;
     bool is_branch_ = true;
 
     std::unique_ptr<Node> left_ = nullptr;
@@ -32,9 +32,10 @@ template <std::floating_point T> class Node {
 
     void set_box(const bounding_box::AABB<T> &box) { box_ = box; }
 
-    void set_triangles(const std::span<triangle::Triangle<T>> &triangles) {
+    void set_triangles(std::uint32_t first, std::uint32_t count) {
         is_branch_ = true;
-        triangles_ = triangles;
+        first_ = first;
+        count_ = count;
     }
 
     const std::unique_ptr<Node> &get_left() const noexcept { return left_; }
@@ -43,11 +44,11 @@ template <std::floating_point T> class Node {
 
     bool is_branch() const noexcept { return is_branch_; }
 
-    std::span<triangle::Triangle<T>> get_triangles() const noexcept { return triangles_; }
+    std::uint32_t get_first_triangle() const noexcept { return first_; }
 
     const bounding_box::AABB<T> &get_box() const noexcept { return box_; }
 
-    size_t get_number_of_triangles() const noexcept { return triangles_.size(); }
+    size_t get_number_of_triangles() const noexcept { return count_; }
 };
 
 } // namespace bin_tree
@@ -0,0 +1,224 @@
+#ifndef INCLUDE_BVH_QUERY_STATS_HPP
+#define INCLUDE_BVH_QUERY_STATS_HPP
+
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "common/perf_counters.hpp"
+#include "common/stage_timings.hpp"
+#include "intersection/triangle_to_triangle_2d.hpp"
+
+namespace bin_tree {
+
+/* ---------- shape of a built tree ---------- */
+struct TreeShape {
+    std::size_t triangles = 0;
+    std::size_t nodes = 0;
+    std::size_t leaves = 0;
+    std::size_t depth = 0; // nodes on the longest path from the root to a leaf
+};
+
+/* ---------- what the broadphase and the narrowphase of a query did ---------- */
+struct QueryCounters {
+    std::size_t box_tests_passed = 0; // node pairs whose boxes overlap
+    std::size_t box_tests_failed = 0;
+    std::size_t leaf_pairs = 0; // overlapping pairs of leaves, their triangles become candidates
+
+    // triangle pairs by the branch of intersect_triangles that decided them, indexed by Sign:
+    // different (the edges are tested), pozitive and negative (separated by a plane),
+    // common_vertice_other_poz_or_neg (one vertex in the other plane), common_plane
+    std::array<std::size_t, 5> triangle_pairs{};
+    std::size_t triangle_segment_pairs = 0;
+    std::size_t segment_segment_pairs = 0;
+    std::size_t point_pairs = 0;
+
+    std::size_t hits = 0; // intersecting pairs
+
+    // every visited node pair gets one box test
+    std::size_t node_pairs() const noexcept { return box_tests_passed + box_tests_failed; }
+
+    std::size_t get_triangle_pairs(triangle::Sign branch) const noexcept {
+        return triangle_pairs[static_cast<std::size_t>(branch)];
+    }
+
+    std::size_t narrowphase_calls() const noexcept {
+        std::size_t calls = triangle_segment_pairs + segment_segment_pairs + point_pairs;
+        for (const std::size_t count : triangle_pairs)
+            calls += count;
+        return calls;
+    }
+};
+
+/* ---------- everything the --stats mode reports ---------- */
+struct QueryStats {
+    timing::StageTimings timings;
+    TreeShape tree;
+    QueryCounters counters;
+};
+
+enum class StatsFormat { text, json };
+
+inline StatsFormat parse_stats_format(std::string_view name) {
+    if (name == "text")
+        return StatsFormat::text;
+    if (name == "json")
+        return StatsFormat::json;
+    throw std::invalid_argument("Unknown stats format: " + std::string(name));
+}
+
+namespace detail {
+
+inline void print_json_string(std::ostream &os, std::string_view text) {
+    os << '"';
+    for (const char c : text) {
+        if (c == '"' || c == '\\')
+            os << '\\';
+        os << c;
+    }
+    os << '"';
+}
+
+// event counts go up to ~1e12 and are printed in full
+inline void print_json_number(std::ostream &os, const std::optional<double> &value) {
+    if (!value) {
+        os << "null";
+        return;
+    }
+    const std::streamsize precision = os.precision(15);
+    os << *value;
+    os.precision(precision);
+}
+
+// events of the query per visited node pair: cycles and the misses
+constexpr std::array<perf::Event, 5> per_node_pair_events{
+    perf::Event::cycles, perf::Event::l1d_misses, perf::Event::llc_misses,
+    perf::Event::branch_misses, perf::Event::dtlb_misses};
+
+inline std::optional<double> per_node_pair(const perf::EventCounts &events, perf::Event event,
+                                           std::size_t node_pairs) {
+    const auto &count = events.get(event);
+    if (!count || node_pairs == 0)
+        return std::nullopt;
+    return *count / static_cast<double>(node_pairs);
+}
+
+} // namespace detail
+
+inline void print_stats_text(std::ostream &os, const QueryStats &stats) {
+    using triangle::Sign;
+    const QueryCounters &counters = stats.counters;
+
+    stats.timings.print(os);
+    os << "tree: " << stats.tree.triangles << " triangles, " << stats.tree.nodes << " nodes, "
+       << stats.tree.leaves << " leaves, depth " << stats.tree.depth << '\n'
+       << "broadphase: " << counters.node_pairs() << " node pairs, "
+       << counters.box_tests_passed << " box tests passed, " << counters.box_tests_failed
+       << " failed, " << counters.leaf_pairs << " leaf pairs\n"
+       << "narrowphase: " << counters.narrowphase_calls() << " calls, " << counters.hits
+       << " hits\n"
+       << "  triangle pairs: " << counters.get_triangle_pairs(Sign::pozitive) << " separated "
+       << "(positive), " << counters.get_triangle_pairs(Sign::negative) << " separated "
+       << "(negative), " << counters.get_triangle_pairs(Sign::common_plane) << " coplanar, "
+       << counters.get_triangle_pairs(Sign::common_vertice_other_poz_or_neg)
+       << " one vertex in the other plane, " << counters.get_triangle_pairs(Sign::different)
+       << " edges tested\n"
+       << "  triangle-segment pairs: " << counters.triangle_segment_pairs
+       << ", segment pairs: " << counters.segment_segment_pairs
+       << ", pairs with a point: " << counters.point_pairs << '\n';
+
+    if (const perf::EventCounts *events = stats.timings.find_events("query")) {
+        os << "query per node pair:";
+        for (const perf::Event event : detail::per_node_pair_events) {
+            os << (event == perf::Event::cycles ? " " : ", ")
+               << perf::event_names[static_cast<std::size_t>(event)] << ' ';
+            if (const auto value = detail::per_node_pair(*events, event, counters.node_pairs()))
+                os << *value;
+            else
+                os << "n/a";
+        }
+        os << '\n';
+    }
+}
+
+// one JSON object on one line
+inline void print_stats_json(std::ostream &os, const QueryStats &stats) {
+    using triangle::Sign;
+    const QueryCounters &counters = stats.counters;
+
+    os << "{\"stages\":{";
+    bool first = true;
+    for (const auto &[name, seconds] : stats.timings.get_stages()) {
+        if (!first)
+            os << ',';
+        first = false;
+        detail::print_json_string(os, name);
+        os << ':' << seconds;
+    }
+    os << "},\"tree\":{\"triangles\":" << stats.tree.triangles << ",\"nodes\":" << stats.tree.nodes
+       << ",\"leaves\":" << stats.tree.leaves << ",\"depth\":" << stats.tree.depth << '}'
+       << ",\"broadphase\":{\"node_pairs\":" << counters.node_pairs()
+       << ",\"box_tests_passed\":" << counters.box_tests_passed
+       << ",\"box_tests_failed\":" << counters.box_tests_failed
+       << ",\"leaf_pairs\":" << counters.leaf_pairs << '}'
+       << ",\"narrowphase\":{\"calls\":" << counters.narrowphase_calls()
+       << ",\"hits\":" << counters.hits << ",\"triangle_pairs\":{\"separated_positive\":"
+       << counters.get_triangle_pairs(Sign::pozitive)
+       << ",\"separated_negative\":" << counters.get_triangle_pairs(Sign::negative)
+       << ",\"coplanar\":" << counters.get_triangle_pairs(Sign::common_plane)
+       << ",\"vertex_in_plane\":"
+       << counters.get_triangle_pairs(Sign::common_vertice_other_poz_or_neg)
+       << ",\"edges_tested\":" << counters.get_triangle_pairs(Sign::different) << '}'
+       << ",\"triangle_segment_pairs\":" << counters.triangle_segment_pairs
+       << ",\"segment_segment_pairs\":" << counters.segment_segment_pairs
+       << ",\"point_pairs\":" << counters.point_pairs << '}';
+
+    // hardware events of the stages that counted them
+    const auto events = stats.timings.get_events();
+    if (!events.empty()) {
+        os << ",\"events\":{";
+        for (std::size_t stage = 0; stage < events.size(); ++stage) {
+            const auto &[name, counts] = events[stage];
+            if (stage != 0)
+                os << ',';
+            detail::print_json_string(os, name);
+            os << ":{";
+            for (std::size_t i = 0; i < perf::number_of_events; ++i) {
+                os << '"' << perf::event_keys[i] << "\":";
+                detail::print_json_number(os, counts->counts[i]);
+                os << ',';
+            }
+            os << "\"ipc\":";
+            detail::print_json_number(os, counts->ipc());
+            os << '}';
+        }
+        os << '}';
+    }
+    if (const perf::EventCounts *query = stats.timings.find_events("query")) {
+        os << ",\"query_per_node_pair\":{";
+        for (std::size_t i = 0; i < detail::per_node_pair_events.size(); ++i) {
+            const perf::Event event = detail::per_node_pair_events[i];
+            os << (i == 0 ? "\"" : ",\"") << perf::event_keys[static_cast<std::size_t>(event)]
+               << "\":";
+            detail::print_json_number(
+                os, detail::per_node_pair(*query, event, counters.node_pairs()));
+        }
+        os << '}';
+    }
+    os << "}\n";
+}
+
+inline void print_stats(std::ostream &os, const QueryStats &stats, StatsFormat format) {
+    if (format == StatsFormat::json)
+        print_stats_json(os, stats);
+    else
+        print_stats_text(os, stats);
+}
+
+} // namespace bin_tree
+
+#endif // INCLUDE_BVH_QUERY_STATS_HPP
@@ -0,0 +1,46 @@
+#ifndef INCLUDE_COMMON_PARALLEL_HPP
+#define INCLUDE_COMMON_PARALLEL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace parallel {
+
+// runs task(0) .. task(number_of_tasks - 1) on up to `number_of_threads` threads and
+// rethrows the first exception
+template <typename Task>
+void run_tasks(std::size_t number_of_tasks, std::size_t number_of_threads, Task &&task) {
+    std::atomic<std::size_t> next_task{0};
+    std::exception_ptr error;
+    std::mutex error_mutex;
+
+    auto work = [&] {
+        try {
+            for (std::size_t i = next_task++; i < number_of_tasks; i = next_task++)
+                task(i);
+        } catch (...) {
+            std::lock_guard lock(error_mutex);
+            if (!error)
+                error = std::current_exception();
+            next_task = number_of_tasks;
+        }
+    };
+
+    {
+        std::vector<std::jthread> workers;
+        for (std::size_t i = 1; i < std::min(number_of_threads, number_of_tasks); ++i)
+            workers.emplace_back(work);
+        work();
+    }
+    if (error)
+        std::rethrow_exception(error);
+}
+
+} // namespace parallel
+
+#endif // INCLUDE_COMMON_PARALLEL_HPP
@@ -0,0 +1,212 @@
+#ifndef INCLUDE_COMMON_PERF_COUNTERS_HPP
+#define INCLUDE_COMMON_PERF_COUNTERS_HPP
+
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <ios>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace perf {
+
+/* ---------- hardware events counted around the stages of a run ---------- */
+enum class Event : std::size_t {
+    cycles,
+    instructions,
+    l1d_misses,
+    llc_misses,
+    branch_misses,
+    dtlb_misses
+};
+
+constexpr std::size_t number_of_events = 6;
+
+inline constexpr std::array<std::string_view, number_of_events> event_names{
+    "cycles", "instructions", "L1d misses", "LLC misses", "branch misses", "dTLB misses"};
+
+// names for JSON keys
+inline constexpr std::array<std::string_view, number_of_events> event_keys{
+    "cycles", "instructions", "l1d_misses", "llc_misses", "branch_misses", "dtlb_misses"};
+
+// the counts of one interval; an event that could not be opened or never got a hardware
+// counter has no value
+struct EventCounts {
+    std::array<std::optional<double>, number_of_events> counts;
+
+    const std::optional<double> &get(Event event) const noexcept {
+        return counts[static_cast<std::size_t>(event)];
+    }
+
+    // instructions per cycle
+    std::optional<double> ipc() const noexcept {
+        const auto &cycles = get(Event::cycles);
+        const auto &instructions = get(Event::instructions);
+        if (!cycles || !instructions || *cycles == 0)
+            return std::nullopt;
+        return *instructions / *cycles;
+    }
+
+    bool empty() const noexcept {
+        for (const auto &count : counts)
+            if (count)
+                return false;
+        return true;
+    }
+};
+
+// "cycles 123, instructions 456, IPC 3.71, L1d misses n/a, ..." on one line
+inline void print_counts(std::ostream &os, const EventCounts &counts) {
+    const std::ios_base::fmtflags flags = os.flags();
+    const std::streamsize precision = os.precision();
+    os << std::fixed;
+
+    for (std::size_t i = 0; i < number_of_events; ++i) {
+        if (i != 0)
+            os << ", ";
+        os << event_names[i] << ' ';
+        if (counts.counts[i])
+            os << std::setprecision(0) << *counts.counts[i];
+        else
+            os << "n/a";
+        if (static_cast<Event>(i) == Event::instructions) {
+            os << ", IPC ";
+            if (const auto ipc = counts.ipc())
+                os << std::setprecision(2) << *ipc;
+            else
+                os << "n/a";
+        }
+    }
+
+    os.flags(flags);
+    os.precision(precision);
+}
+
+namespace detail {
+
+constexpr std::uint64_t cache_miss(std::uint64_t cache) noexcept {
+    return cache | std::uint64_t{PERF_COUNT_HW_CACHE_OP_READ} << 8 |
+           std::uint64_t{PERF_COUNT_HW_CACHE_RESULT_MISS} << 16;
+}
+
+struct EventConfig {
+    std::uint32_t type;
+    std::uint64_t config;
+};
+
+inline constexpr std::array<EventConfig, number_of_events> event_configs{{
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HW_CACHE, cache_miss(PERF_COUNT_HW_CACHE_L1D)},
+    {PERF_TYPE_HW_CACHE, cache_miss(PERF_COUNT_HW_CACHE_LL)},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    {PERF_TYPE_HW_CACHE, cache_miss(PERF_COUNT_HW_CACHE_DTLB)},
+}};
+
+// A disabled counter of the calling thread and the threads it starts later, user space only;
+// -1 with errno set if the kernel refuses it
+inline int open_counter(std::uint32_t type, std::uint64_t config) noexcept {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = 1;
+    attr.inherit = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    return static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+}
+
+// The count since the last reset, scaled up by enabled / running time when the kernel had to
+// share the hardware counters between events; no value if the event never ran
+inline std::optional<double> read_counter(int fd) noexcept {
+    struct {
+        std::uint64_t value;
+        std::uint64_t time_enabled;
+        std::uint64_t time_running;
+    } data;
+    if (::read(fd, &data, sizeof(data)) != static_cast<::ssize_t>(sizeof(data)) ||
+        data.time_running == 0)
+        return std::nullopt;
+    if (data.time_running == data.time_enabled)
+        return static_cast<double>(data.value);
+    return static_cast<double>(data.value) * static_cast<double>(data.time_enabled) /
+           static_cast<double>(data.time_running);
+}
+
+} // namespace detail
+
+/* ---------- the counters of all events, opened once ---------- */
+// Events the kernel refuses (no PMU in a virtual machine, perf_event_paranoid, seccomp) are
+// left out; with none of them the counters are unavailable and every count is empty.
+class EventCounters {
+  private:
+    std::array<int, number_of_events> fds_;
+    std::string error_;
+
+  public:
+    EventCounters() {
+        for (std::size_t i = 0; i < number_of_events; ++i) {
+            const auto &[type, config] = detail::event_configs[i];
+            fds_[i] = detail::open_counter(type, config);
+            if (fds_[i] < 0 && error_.empty())
+                error_ = std::string(event_names[i]) + ": " + std::strerror(errno);
+        }
+    }
+
+    EventCounters(const EventCounters &) = delete;
+    EventCounters &operator=(const EventCounters &) = delete;
+
+    ~EventCounters() {
+        for (const int fd : fds_)
+            if (fd >= 0)
+                ::close(fd);
+    }
+
+    bool available() const noexcept {
+        for (const int fd : fds_)
+            if (fd >= 0)
+                return true;
+        return false;
+    }
+
+    // why the first event that failed could not be opened, empty if all were
+    const std::string &get_error() const noexcept { return error_; }
+
+    void start() noexcept {
+        for (const int fd : fds_) {
+            if (fd >= 0) {
+                ::ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                ::ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+        }
+    }
+
+    EventCounts stop() noexcept {
+        EventCounts counts;
+        for (std::size_t i = 0; i < number_of_events; ++i) {
+            if (fds_[i] < 0)
+                continue;
+            ::ioctl(fds_[i], PERF_EVENT_IOC_DISABLE, 0);
+            counts.counts[i] = detail::read_counter(fds_[i]);
+        }
+        return counts;
+    }
+};
+
+} // namespace perf
+
+#endif // INCLUDE_COMMON_PERF_COUNTERS_HPP
@@ -0,0 +1,275 @@
+#ifndef PREDICATES_HPP
+#define PREDICATES_HPP
+
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+
+#include "primitives/point.hpp"
+
+namespace predicates {
+
+// Adaptive exact orientation test after J. R. Shewchuk, "Adaptive Precision Floating-Point
+// Arithmetic and Fast Robust Geometric Predicates". The determinant is first evaluated in T
+// and accepted when it exceeds a dynamic error bound; otherwise it is recomputed exactly
+// with floating-point expansions. Requires round-to-nearest and no overflow/underflow.
+
+#ifdef TRIANGLES_EXACT_PREDICATES
+inline constexpr bool exact_mode = true;
+#else
+inline constexpr bool exact_mode = false;
+#endif
+
+// unit roundoff 2^-p of T (2^-24 for float, 2^-53 for double)
+template <std::floating_point T>
+inline constexpr T unit_roundoff = std::numeric_limits<T>::epsilon() / 2;
+
+template <std::floating_point T>
+inline constexpr T orient_3d_error_bound =
+    (T{7} + T{56} * unit_roundoff<T>) * unit_roundoff<T>;
+
+namespace expansion {
+
+/* ---------- error-free transformations ---------- */
+template <std::floating_point T> void fast_two_sum(T a, T b, T &x, T &y) noexcept {
+    x = a + b;
+    T b_virtual = x - a;
+    y = b - b_virtual;
+}
+
+template <std::floating_point T> void two_sum(T a, T b, T &x, T &y) noexcept {
+    x = a + b;
+    T b_virtual = x - a;
+    T a_virtual = x - b_virtual;
+    T b_round = b - b_virtual;
+    T a_round = a - a_virtual;
+    y = a_round + b_round;
+}
+
+template <std::floating_point T> void two_diff(T a, T b, T &x, T &y) noexcept {
+    x = a - b;
+    T b_virtual = a - x;
+    T a_virtual = x + b_virtual;
+    T b_round = b_virtual - b;
+    T a_round = a - a_virtual;
+    y = a_round + b_round;
+}
+
+template <std::floating_point T> void two_product(T a, T b, T &x, T &y) noexcept {
+    x = a * b;
+    y = std::fma(a, b, -x);
+}
+
+// (a1 + a0) - (b1 + b0) as a four-component expansion h[0..3], smallest first
+template <std::floating_point T> void two_two_diff(T a1, T a0, T b1, T b0, T *h) noexcept {
+    T i, j, zero;
+    two_diff(a0, b0, i, h[0]);
+    two_sum(a1, i, j, zero);
+    two_diff(zero, b1, i, h[1]);
+    two_sum(j, i, h[3], h[2]);
+}
+
+// h = e + f for nonoverlapping expansions sorted by magnitude; zero components are dropped
+template <std::floating_point T>
+std::size_t sum(std::size_t e_len, const T *e, std::size_t f_len, const T *f, T *h) noexcept {
+    std::size_t e_index = 0, f_index = 0, h_index = 0;
+    T e_now = e[0];
+    T f_now = f[0];
+    T q, q_new, hh;
+
+    auto next_e = [&] { e_now = ++e_index < e_len ? e[e_index] : T{0}; };
+    auto next_f = [&] { f_now = ++f_index < f_len ? f[f_index] : T{0}; };
+
+    if ((f_now > e_now) == (f_now > -e_now)) {
+        q = e_now;
+        next_e();
+    } else {
+        q = f_now;
+        next_f();
+    }
+
+    if (e_index < e_len && f_index < f_len) {
+        if ((f_now > e_now) == (f_now > -e_now)) {
+            fast_two_sum(e_now, q, q_new, hh);
+            next_e();
+        } else {
+            fast_two_sum(f_now, q, q_new, hh);
+            next_f();
+        }
+        q = q_new;
+        if (hh != 0)
+            h[h_index++] = hh;
+
+        while (e_index < e_len && f_index < f_len) {
+            if ((f_now > e_now) == (f_now > -e_now)) {
+                two_sum(q, e_now, q_new, hh);
+                next_e();
+            } else {
+                two_sum(q, f_now, q_new, hh);
+                next_f();
+            }
+            q = q_new;
+            if (hh != 0)
+                h[h_index++] = hh;
+        }
+    }
+
+    while (e_index < e_len) {
+        two_sum(q, e_now, q_new, hh);
+        next_e();
+        q = q_new;
+        if (hh != 0)
+            h[h_index++] = hh;
+    }
+    while (f_index < f_len) {
+        two_sum(q, f_now, q_new, hh);
+        next_f();
+        q = q_new;
+        if (hh != 0)
+            h[h_index++] = hh;
+    }
+
+    if (q != 0 || h_index == 0)
+        h[h_index++] = q;
+    return h_index;
+}
+
+// h = b * e; zero components are dropped
+template <std::floating_point T>
+std::size_t scale(std::size_t e_len, const T *e, T b, T *h) noexcept {
+    std::size_t h_index = 0;
+    T q, hh, product_1, product_0, s;
+
+    two_product(e[0], b, q, hh);
+    if (hh != 0)
+        h[h_index++] = hh;
+
+    for (std::size_t e_index = 1; e_index < e_len; ++e_index) {
+        two_product(e[e_index], b, product_1, product_0);
+        two_sum(q, product_0, s, hh);
+        if (hh != 0)
+            h[h_index++] = hh;
+        fast_two_sum(product_1, s, q, hh);
+        if (hh != 0)
+            h[h_index++] = hh;
+    }
+
+    if (q != 0 || h_index == 0)
+        h[h_index++] = q;
+    return h_index;
+}
+
+// a.x * b.y - b.x * a.y exactly
+template <std::floating_point T>
+std::array<T, 4> cross_xy(const triangle::Point<T> &a, const triangle::Point<T> &b) noexcept {
+    T axby1, axby0, bxay1, bxay0;
+    two_product(a.x_, b.y_, axby1, axby0);
+    two_product(b.x_, a.y_, bxay1, bxay0);
+
+    std::array<T, 4> h;
+    two_two_diff(axby1, axby0, bxay1, bxay0, h.data());
+    return h;
+}
+
+} // namespace expansion
+
+// Sign of orient_3d(a, b, c, d) = (b - a) x (c - a) * (d - a) evaluated exactly
+template <std::floating_point T>
+int orient_3d_exact(const triangle::Point<T> &a, const triangle::Point<T> &b,
+                    const triangle::Point<T> &c, const triangle::Point<T> &d) noexcept {
+    using namespace expansion;
+
+    auto ab = cross_xy(a, b), bc = cross_xy(b, c), cd = cross_xy(c, d);
+    auto da = cross_xy(d, a), ac = cross_xy(a, c), bd = cross_xy(b, d);
+
+    T temp8[8], cda[12], dab[12], abc[12], bcd[12];
+    std::size_t temp_len;
+
+    temp_len = sum(4, cd.data(), 4, da.data(), temp8);
+    const std::size_t cda_len = sum(temp_len, temp8, 4, ac.data(), cda);
+    temp_len = sum(4, da.data(), 4, ab.data(), temp8);
+    const std::size_t dab_len = sum(temp_len, temp8, 4, bd.data(), dab);
+
+    for (std::size_t i = 0; i < 4; ++i) {
+        bd[i] = -bd[i];
+        ac[i] = -ac[i];
+    }
+
+    temp_len = sum(4, ab.data(), 4, bc.data(), temp8);
+    const std::size_t abc_len = sum(temp_len, temp8, 4, ac.data(), abc);
+    temp_len = sum(4, bc.data(), 4, cd.data(), temp8);
+    const std::size_t bcd_len = sum(temp_len, temp8, 4, bd.data(), bcd);
+
+    T a_det[24], b_det[24], c_det[24], d_det[24];
+    const std::size_t a_len = scale(bcd_len, bcd, a.z_, a_det);
+    const std::size_t b_len = scale(cda_len, cda, -b.z_, b_det);
+    const std::size_t c_len = scale(dab_len, dab, c.z_, c_det);
+    const std::size_t d_len = scale(abc_len, abc, -d.z_, d_det);
+
+    T ab_det[48], cd_det[48], det[96];
+    const std::size_t ab_len = sum(a_len, a_det, b_len, b_det, ab_det);
+    const std::size_t cd_len = sum(c_len, c_det, d_len, d_det, cd_det);
+    const std::size_t det_len = sum(ab_len, ab_det, cd_len, cd_det, det);
+
+    // the expansion is Shewchuk's orient3d(a, b, c, d), which has the opposite sign
+    const T most_significant = det[det_len - 1];
+    return (most_significant < 0) - (most_significant > 0);
+}
+
+// Sign of an already evaluated determinant `value` when it exceeds the error bound of its
+// permanent (the same sum with every product replaced by its absolute value), 0 if the
+// sign is uncertain. Written as a select so that the unpredictable sign compiles without
+// branches.
+template <std::floating_point T> T orient_3d_filter(T value, T permanent) noexcept {
+    const T error_bound = orient_3d_error_bound<T> * permanent;
+    return std::abs(value) > error_bound ? std::copysign(T{1}, value) : T{0};
+}
+
+// Filtered orientation with the exact fallback for uncertain signs
+template <std::floating_point T>
+T orient_3d_adaptive(T value, T permanent, const triangle::Point<T> &a,
+                     const triangle::Point<T> &b, const triangle::Point<T> &c,
+                     const triangle::Point<T> &d) noexcept {
+    const T sign = orient_3d_filter(value, permanent);
+    if (sign != 0)
+        return sign;
+
+    return static_cast<T>(orient_3d_exact(a, b, c, d));
+}
+
+// orient_3d_filter of orient_3d(a, b, c, d): -1 or 1, 0 if uncertain
+template <std::floating_point T>
+T orient_3d_filtered(const triangle::Point<T> &a, const triangle::Point<T> &b,
+                     const triangle::Point<T> &c, const triangle::Point<T> &d) noexcept {
+    const T ab_x = b.x_ - a.x_, ab_y = b.y_ - a.y_, ab_z = b.z_ - a.z_;
+    const T ac_x = c.x_ - a.x_, ac_y = c.y_ - a.y_, ac_z = c.z_ - a.z_;
+    const T ad_x = d.x_ - a.x_, ad_y = d.y_ - a.y_, ad_z = d.z_ - a.z_;
+
+    const T yz = ab_y * ac_z, zy = ab_z * ac_y;
+    const T zx = ab_z * ac_x, xz = ab_x * ac_z;
+    const T xy = ab_x * ac_y, yx = ab_y * ac_x;
+
+    const T value = (yz - zy) * ad_x + (zx - xz) * ad_y + (xy - yx) * ad_z;
+    const T permanent = (std::abs(yz) + std::abs(zy)) * std::abs(ad_x) +
+                        (std::abs(zx) + std::abs(xz)) * std::abs(ad_y) +
+                        (std::abs(xy) + std::abs(yx)) * std::abs(ad_z);
+
+    return orient_3d_filter(value, permanent);
+}
+
+// Sign of orient_3d(a, b, c, d) as -1, 0 or 1
+template <std::floating_point T>
+T orient_3d_adaptive(const triangle::Point<T> &a, const triangle::Point<T> &b,
+                     const triangle::Point<T> &c, const triangle::Point<T> &d) noexcept {
+    const T sign = orient_3d_filtered(a, b, c, d);
+    if (sign != 0)
+        return sign;
+
+    return static_cast<T>(orient_3d_exact(a, b, c, d));
+}
+
+} // namespace predicates
+
+#endif // PREDICATES_HPP
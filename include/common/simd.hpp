@@ -0,0 +1,159 @@
+#ifndef SIMD_HPP
+#define SIMD_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__AVX2__) || defined(__AVX512F__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace simd {
+
+// Thin wrappers over the native float registers. Comparisons return one bit per lane,
+// so the branch logic of the narrowphase can be written once for every width.
+// Arithmetic is plain mul/add/sub in source order: build with -ffp-contract=off so that
+// neither the wrappers nor the scalar code get fused into FMA and results stay bitwise equal.
+
+#if defined(__AVX512F__)
+struct f32x16 {
+    static constexpr std::size_t width = 16;
+    __m512 v;
+
+    static f32x16 load(const float *p) noexcept { return {_mm512_load_ps(p)}; }
+    static f32x16 broadcast(float value) noexcept { return {_mm512_set1_ps(value)}; }
+
+    friend f32x16 operator+(f32x16 a, f32x16 b) noexcept { return {_mm512_add_ps(a.v, b.v)}; }
+    friend f32x16 operator-(f32x16 a, f32x16 b) noexcept { return {_mm512_sub_ps(a.v, b.v)}; }
+    friend f32x16 operator*(f32x16 a, f32x16 b) noexcept { return {_mm512_mul_ps(a.v, b.v)}; }
+
+    friend f32x16 abs(f32x16 a) noexcept { return {_mm512_abs_ps(a.v)}; }
+
+    friend std::uint32_t greater_or_equal(f32x16 a, f32x16 b) noexcept {
+        return _mm512_cmp_ps_mask(a.v, b.v, _CMP_GE_OQ);
+    }
+    friend std::uint32_t lower_or_equal(f32x16 a, f32x16 b) noexcept {
+        return _mm512_cmp_ps_mask(a.v, b.v, _CMP_LE_OQ);
+    }
+    friend std::uint32_t greater(f32x16 a, f32x16 b) noexcept {
+        return _mm512_cmp_ps_mask(a.v, b.v, _CMP_GT_OQ);
+    }
+    friend std::uint32_t lower(f32x16 a, f32x16 b) noexcept {
+        return _mm512_cmp_ps_mask(a.v, b.v, _CMP_LT_OQ);
+    }
+
+    // lanes whose bit is set take `a`, the others take `b`
+    friend f32x16 select(std::uint32_t mask, f32x16 a, f32x16 b) noexcept {
+        return {_mm512_mask_blend_ps(static_cast<__mmask16>(mask), b.v, a.v)};
+    }
+};
+#endif
+
+#if defined(__AVX2__)
+struct f32x8 {
+    static constexpr std::size_t width = 8;
+    __m256 v;
+
+    static f32x8 load(const float *p) noexcept { return {_mm256_load_ps(p)}; }
+    static f32x8 broadcast(float value) noexcept { return {_mm256_set1_ps(value)}; }
+
+    friend f32x8 operator+(f32x8 a, f32x8 b) noexcept { return {_mm256_add_ps(a.v, b.v)}; }
+    friend f32x8 operator-(f32x8 a, f32x8 b) noexcept { return {_mm256_sub_ps(a.v, b.v)}; }
+    friend f32x8 operator*(f32x8 a, f32x8 b) noexcept { return {_mm256_mul_ps(a.v, b.v)}; }
+
+    friend f32x8 abs(f32x8 a) noexcept { return {_mm256_andnot_ps(_mm256_set1_ps(-0.0f), a.v)}; }
+
+    friend std::uint32_t greater_or_equal(f32x8 a, f32x8 b) noexcept {
+        return static_cast<std::uint32_t>(_mm256_movemask_ps(_mm256_cmp_ps(a.v, b.v, _CMP_GE_OQ)));
+    }
+    friend std::uint32_t lower_or_equal(f32x8 a, f32x8 b) noexcept {
+        return static_cast<std::uint32_t>(_mm256_movemask_ps(_mm256_cmp_ps(a.v, b.v, _CMP_LE_OQ)));
+    }
+    friend std::uint32_t greater(f32x8 a, f32x8 b) noexcept {
+        return static_cast<std::uint32_t>(_mm256_movemask_ps(_mm256_cmp_ps(a.v, b.v, _CMP_GT_OQ)));
+    }
+    friend std::uint32_t lower(f32x8 a, f32x8 b) noexcept {
+        return static_cast<std::uint32_t>(_mm256_movemask_ps(_mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ)));
+    }
+
+    // lanes whose bit is set take `a`, the others take `b`
+    friend f32x8 select(std::uint32_t mask, f32x8 a, f32x8 b) noexcept {
+        const __m256i lane_bits = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+        const __m256i bits = _mm256_set1_epi32(static_cast<int>(mask));
+        const __m256i lanes = _mm256_cmpeq_epi32(_mm256_and_si256(bits, lane_bits), lane_bits);
+        return {_mm256_blendv_ps(b.v, a.v, _mm256_castsi256_ps(lanes))};
+    }
+};
+#endif
+
+// widest register type available for T in this build
+template <typename T> struct native {};
+
+#if defined(__AVX512F__)
+template <> struct native<float> {
+    using type = f32x16;
+};
+#elif defined(__AVX2__)
+template <> struct native<float> {
+    using type = f32x8;
+};
+#endif
+
+template <typename T> using native_t = typename native<T>::type;
+
+template <typename T>
+inline constexpr bool has_native = requires { typename native<T>::type; };
+
+/* ---------- one point or vector per register: lanes x, y, z, 0 ---------- */
+// Built with TRIANGLES_SIMD_POINTS, Point<float> and Vector<float> are padded to this layout
+// and their products use the functions below. Every lane does the same mul/sub as the scalar
+// code and the dot product adds in scalar order, so the results are bitwise equal.
+
+// xyz0<T>::type is the register type for T in this build, if the layout is enabled
+template <typename T> struct xyz0 {};
+
+#if defined(TRIANGLES_SIMD_POINTS) && defined(__SSE2__)
+struct f32x4 {
+    static constexpr std::size_t width = 4;
+    __m128 v;
+
+    static f32x4 load(const float *p) noexcept { return {_mm_load_ps(p)}; }
+    void store(float *p) const noexcept { _mm_store_ps(p, v); }
+
+    friend f32x4 operator-(f32x4 a, f32x4 b) noexcept { return {_mm_sub_ps(a.v, b.v)}; }
+    friend f32x4 operator*(f32x4 a, f32x4 b) noexcept { return {_mm_mul_ps(a.v, b.v)}; }
+
+    // lane-wise std::min(a, b) and std::max(a, b), with the same choice on ties
+    friend f32x4 min(f32x4 a, f32x4 b) noexcept { return {_mm_min_ps(b.v, a.v)}; }
+    friend f32x4 max(f32x4 a, f32x4 b) noexcept { return {_mm_max_ps(b.v, a.v)}; }
+};
+
+// (y, z, x, 0) and (z, x, y, 0)
+inline f32x4 rotate_yzx(f32x4 a) noexcept { return {_mm_shuffle_ps(a.v, a.v, 0b11'00'10'01)}; }
+inline f32x4 rotate_zxy(f32x4 a) noexcept { return {_mm_shuffle_ps(a.v, a.v, 0b11'01'00'10)}; }
+
+inline f32x4 cross_xyz0(f32x4 a, f32x4 b) noexcept {
+    return rotate_yzx(a) * rotate_zxy(b) - rotate_zxy(a) * rotate_yzx(b);
+}
+
+// (x_a * x_b + y_a * y_b) + z_a * z_b
+inline float dot_xyz0(f32x4 a, f32x4 b) noexcept {
+    const __m128 products = _mm_mul_ps(a.v, b.v);
+    const __m128 xy = _mm_add_ss(products, _mm_shuffle_ps(products, products, 0b01));
+    return _mm_cvtss_f32(_mm_add_ss(xy, _mm_movehl_ps(products, products)));
+}
+
+template <> struct xyz0<float> {
+    using type = f32x4;
+};
+#endif
+
+template <typename T> using xyz0_t = typename xyz0<T>::type;
+
+// Point<T> and Vector<T> use the xyz0 layout
+template <typename T>
+inline constexpr bool has_xyz0 = requires { typename xyz0<T>::type; };
+
+} // namespace simd
+
+#endif // SIMD_HPP
@@ -0,0 +1,105 @@
+#ifndef INCLUDE_COMMON_STAGE_TIMINGS_HPP
+#define INCLUDE_COMMON_STAGE_TIMINGS_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <ios>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "common/perf_counters.hpp"
+
+namespace timing {
+
+using Clock = std::chrono::steady_clock;
+
+inline double seconds_since(Clock::time_point start) noexcept {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+/* ---------- wall-clock time of the stages of a run, in the order they were added ---------- */
+class StageTimings {
+  private:
+    std::vector<std::pair<std::string, double>> stages_; // name, seconds
+    std::vector<std::optional<perf::EventCounts>> events_; // events_[i] of stages_[i]
+    perf::EventCounters *counters_ = nullptr;
+
+  public:
+    // with `counters`, measure() also counts the hardware events of every stage
+    void count_events(perf::EventCounters *counters) noexcept { counters_ = counters; }
+
+    void add(std::string name, double seconds,
+             std::optional<perf::EventCounts> events = std::nullopt) {
+        stages_.emplace_back(std::move(name), seconds);
+        events_.push_back(std::move(events));
+    }
+
+    // runs stage() and adds its time under `name`
+    template <typename Stage> decltype(auto) measure(std::string name, Stage &&stage) {
+        struct Record {
+            StageTimings &timings;
+            std::string name;
+            Clock::time_point start = Clock::now();
+            ~Record() {
+                std::optional<perf::EventCounts> events;
+                if (timings.counters_)
+                    events = timings.counters_->stop();
+                timings.add(std::move(name), seconds_since(start), std::move(events));
+            }
+        } record{*this, std::move(name)};
+        if (counters_)
+            counters_->start();
+        return stage();
+    }
+
+    const std::vector<std::pair<std::string, double>> &get_stages() const noexcept {
+        return stages_;
+    }
+
+    // the events of the last stage called `name`, if they were counted
+    const perf::EventCounts *find_events(std::string_view name) const noexcept {
+        for (std::size_t i = stages_.size(); i-- > 0;)
+            if (stages_[i].first == name)
+                return events_[i] ? &*events_[i] : nullptr;
+        return nullptr;
+    }
+
+    // the stages that have event counts, with them
+    std::vector<std::pair<std::string_view, const perf::EventCounts *>> get_events() const {
+        std::vector<std::pair<std::string_view, const perf::EventCounts *>> events;
+        for (std::size_t i = 0; i < stages_.size(); ++i)
+            if (events_[i])
+                events.emplace_back(stages_[i].first, &*events_[i]);
+        return events;
+    }
+
+    void print(std::ostream &os) const {
+        const std::ios_base::fmtflags flags = os.flags();
+        const std::streamsize precision = os.precision();
+
+        std::size_t width = 0;
+        for (const auto &[name, seconds] : stages_)
+            width = std::max(width, name.size());
+        for (const auto &[name, seconds] : stages_)
+            os << std::left << std::setw(static_cast<int>(width)) << name << "  " << std::right
+               << std::fixed << std::setprecision(3) << std::setw(8) << seconds << " s\n";
+
+        for (const auto &[name, events] : get_events()) {
+            os << std::left << std::setw(static_cast<int>(width)) << name << std::right << "  ";
+            perf::print_counts(os, *events);
+            os << '\n';
+        }
+        os.flags(flags);
+        os.precision(precision);
+    }
+};
+
+} // namespace timing
+
+#endif // INCLUDE_COMMON_STAGE_TIMINGS_HPP
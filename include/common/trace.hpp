@@ -0,0 +1,232 @@
+#ifndef INCLUDE_COMMON_TRACE_HPP
+#define INCLUDE_COMMON_TRACE_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace trace {
+
+// Spans are recorded only in builds with TRIANGLES_TRACE (cmake -DTRACE=ON); otherwise
+// trace::Span is an empty object and compiles to nothing
+#ifdef TRIANGLES_TRACE
+inline constexpr bool enabled = true;
+#else
+inline constexpr bool enabled = false;
+#endif
+
+// ring buffer of every thread, 32 MiB when full: a narrowphase batch span per 256 pairs
+// keeps about 250M pairs of a query
+constexpr std::size_t events_per_thread = std::size_t{1} << 20;
+
+using Clock = std::chrono::steady_clock;
+
+// a finished span; `arg` is its size in whatever unit the span counts (bytes, triangles, pairs)
+struct Event {
+    const char *name; // a string literal
+    std::uint64_t start; // nanoseconds since the recorder started
+    std::uint64_t duration;
+    std::uint64_t arg;
+};
+
+/* ---------- the spans of one thread, the oldest overwritten when it is full ---------- */
+// grows as spans come in, a short run does not pay for the whole capacity
+class ThreadBuffer {
+  private:
+    std::vector<Event> events_;
+    std::size_t capacity_;
+    std::size_t recorded_ = 0; // all events ever pushed
+    std::uint32_t tid_;
+
+  public:
+    ThreadBuffer(std::uint32_t tid, std::size_t capacity)
+        : capacity_(std::max<std::size_t>(capacity, 1)), tid_(tid) {}
+
+    void push(const Event &event) {
+        if (events_.size() < capacity_)
+            events_.push_back(event);
+        else
+            events_[recorded_ % capacity_] = event;
+        ++recorded_;
+    }
+
+    std::uint32_t get_tid() const noexcept { return tid_; }
+    std::size_t dropped() const noexcept { return recorded_ - events_.size(); }
+
+    // oldest first
+    template <typename Visit> void for_each(Visit &&visit) const {
+        const std::size_t begin = recorded_ > events_.size() ? recorded_ % events_.size() : 0;
+        for (std::size_t i = 0; i < events_.size(); ++i)
+            visit(events_[(begin + i) % events_.size()]);
+    }
+};
+
+// nanoseconds as microseconds with three decimals, independent of the stream state
+inline void print_microseconds(std::ostream &os, std::uint64_t nanoseconds) {
+    const std::uint64_t fraction = nanoseconds % 1000;
+    os << nanoseconds / 1000 << '.' << fraction / 100 << fraction / 10 % 10 << fraction % 10;
+}
+
+/* ---------- the buffers of all threads and the Chrome trace they are written to ---------- */
+// Spans are dropped until start() or write_at_exit(). Every thread gets its buffer on its first
+// span; the buffers stay with the recorder after their threads end. Writing the trace must not
+// overlap spans that are still recording.
+class Recorder {
+  private:
+    static inline std::atomic<std::uint64_t> next_id_{1};
+
+    std::uint64_t id_ = next_id_++;
+    Clock::time_point epoch_ = Clock::now();
+    std::size_t capacity_;
+    std::atomic<bool> recording_{false};
+    std::mutex mutex_;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers_;
+    std::string path_;
+    std::ofstream file_; // written on destruction if open
+
+  public:
+    explicit Recorder(std::size_t capacity = events_per_thread) : capacity_(capacity) {}
+
+    Recorder(const Recorder &) = delete;
+    Recorder &operator=(const Recorder &) = delete;
+
+    // no exception can leave a destructor run at exit, so a failed write is only reported
+    ~Recorder() {
+        if (!file_.is_open())
+            return;
+        write_chrome_trace(file_);
+        file_.close();
+        if (!file_)
+            std::cerr << "trace: could not write " << path_ << '\n';
+    }
+
+    // the recorder of the process, whose trace goes to the file of write_at_exit
+    static Recorder &instance() {
+        static Recorder recorder;
+        return recorder;
+    }
+
+    void start() noexcept { recording_.store(true, std::memory_order_relaxed); }
+    bool recording() const noexcept { return recording_.load(std::memory_order_relaxed); }
+
+    // Opens `path` now, so that a bad path fails before the run instead of at exit, and
+    // starts recording
+    void write_at_exit(std::string path) {
+        std::lock_guard lock(mutex_);
+        file_.open(path);
+        if (!file_)
+            throw std::runtime_error("cannot open the trace file " + path);
+        path_ = std::move(path);
+        start();
+    }
+
+    std::uint64_t now() const noexcept {
+        return static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - epoch_).count());
+    }
+
+    // The buffer of the calling thread for this recorder. The thread keeps its buffers by
+    // recorder id, so alternating recorders find their buffers again; ids are never reused,
+    // so the entries of destroyed recorders are never looked up.
+    ThreadBuffer &thread_buffer() {
+        thread_local std::unordered_map<std::uint64_t, ThreadBuffer *> buffers;
+        thread_local std::uint64_t last_owner = 0; // most spans go to the same recorder
+        thread_local ThreadBuffer *last_buffer = nullptr;
+
+        if (last_owner != id_) {
+            ThreadBuffer *&buffer = buffers[id_];
+            if (!buffer) {
+                std::lock_guard lock(mutex_);
+                const auto tid = static_cast<std::uint32_t>(buffers_.size() + 1);
+                buffers_.push_back(std::make_unique<ThreadBuffer>(tid, capacity_));
+                buffer = buffers_.back().get();
+            }
+            last_owner = id_;
+            last_buffer = buffer;
+        }
+        return *last_buffer;
+    }
+
+    // The Chrome trace event format: one complete ("X") event per span, times in
+    // microseconds, one row per thread. Opens in chrome://tracing and Perfetto.
+    void write_chrome_trace(std::ostream &os) {
+        std::lock_guard lock(mutex_);
+
+        os << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+        bool first = true;
+        auto separator = [&] {
+            if (!first)
+                os << ",\n";
+            first = false;
+        };
+
+        for (const auto &buffer : buffers_) {
+            separator();
+            os << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->get_tid()
+               << ",\"args\":{\"name\":\"thread " << buffer->get_tid() << "\"}}";
+            if (buffer->dropped() != 0) {
+                separator();
+                os << "{\"name\":\"dropped spans\",\"ph\":\"i\",\"s\":\"t\",\"ts\":0,\"pid\":1,"
+                   << "\"tid\":" << buffer->get_tid() << ",\"args\":{\"count\":"
+                   << buffer->dropped() << "}}";
+            }
+            buffer->for_each([&](const Event &event) {
+                separator();
+                os << "{\"name\":\"" << event.name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":"
+                   << buffer->get_tid() << ",\"ts\":";
+                print_microseconds(os, event.start);
+                os << ",\"dur\":";
+                print_microseconds(os, event.duration);
+                os << ",\"args\":{\"n\":" << event.arg << "}}";
+            });
+        }
+        os << "]}\n";
+    }
+};
+
+/* ---------- a span from construction to destruction on the calling thread ---------- */
+// A null `name` records nothing, for spans worth recording only above some size; neither does
+// a span started while the recorder is not recording
+class ScopedSpan {
+  private:
+    Recorder *recorder_;
+    const char *name_;
+    std::uint64_t arg_;
+    std::uint64_t start_;
+
+  public:
+    explicit ScopedSpan(const char *name, std::uint64_t arg = 0,
+                        Recorder &recorder = Recorder::instance())
+        : recorder_(&recorder), name_(recorder.recording() ? name : nullptr), arg_(arg),
+          start_(name_ ? recorder.now() : 0) {}
+
+    ScopedSpan(const ScopedSpan &) = delete;
+    ScopedSpan &operator=(const ScopedSpan &) = delete;
+
+    ~ScopedSpan() {
+        if (name_)
+            recorder_->thread_buffer().push({name_, start_, recorder_->now() - start_, arg_});
+    }
+};
+
+struct NoSpan {
+    explicit NoSpan(const char *, std::uint64_t = 0) noexcept {}
+};
+
+using Span = std::conditional_t<enabled, ScopedSpan, NoSpan>;
+
+} // namespace trace
+
+#endif // INCLUDE_COMMON_TRACE_HPP
@@ -1,56 +1,267 @@
 #ifndef INCLUDE_DRIVER_HPP
 #define INCLUDE_DRIVER_HPP
 
+#include <algorithm>
 #include <concepts>
 #include <cstdbool>
 #include <iostream>
+#include <ostream>
+#include <span>
+#include <thread>
+#include <utility>
 #include <vector>
 
+#include <unistd.h>
+
 #include "BVH/BVH.hpp"
+#include "BVH/query_stats.hpp"
+#include "common/stage_timings.hpp"
+#include "intersection/mixed_precision.hpp"
+#include "io/binary_format.hpp"
+#include "io/input_format.hpp"
+#include "io/mapped_input.hpp"
+#include "io/overlapped_input.hpp"
+#include "io/parallel_text_input.hpp"
+#include "io/result_output.hpp"
+#include "io/text_input.hpp"
+#include "primitives/indexed_mesh.hpp"
 #include "primitives/triangle.hpp"
+#include "primitives/triangle_store.hpp"
+#include "primitives/triangle_view.hpp"
+#include "snap/BVH.hpp"
 
 namespace triangle {
 
-template <std::floating_point T> inline std::vector<Triangle<T>> get_input_data() {
-    std::size_t N;
-    if (!(std::cin >> N)) {
-        throw std::runtime_error("Failed to read number of triangles.");
-    }
+// Reads the triangles, calls reserve(N) and then add(p0, p1, p2, id) for every triangle.
+// Standard input is memory-mapped when it is a regular file and read in large blocks
+// otherwise. Its format is found by its content: the text format, parsed with
+// std::from_chars, the binary format, STL, OBJ or PLY.
+template <std::floating_point T, typename Reserve, typename Add>
+void read_input_data(Reserve &&reserve, Add &&add) {
+    const io::MappedInput input(STDIN_FILENO);
+    io::parse_input<T>(input.text(), std::forward<Reserve>(reserve), std::forward<Add>(add));
+}
 
+template <std::floating_point T> inline std::vector<Triangle<T>> get_input_data() {
     std::vector<Triangle<T>> triangles;
-    float x1, y1, z1, x2, y2, z2, x3, y3, z3;
-
-    for (std::size_t i = 0; i < N; ++i) {
-        if (!(std::cin >> x1 >> y1 >> z1 >> x2 >> y2 >> z2 >> x3 >> y3 >> z3)) {
-            throw std::runtime_error(
-                "Failed to read triangle coordinates"); // FIXME add more information
-        }
+    read_input_data<T>([&](std::size_t N) { triangles.reserve(N); },
+                       [&](const Point<T> &p0, const Point<T> &p1, const Point<T> &p2,
+                           std::size_t id) { triangles.emplace_back(p0, p1, p2, id); });
+    return triangles;
+}
 
-        triangles.push_back(
-            Triangle<T>(Point<T>(x1, y1, z1), Point<T>(x2, y2, z2), Point<T>(x3, y3, z3), i));
-    }
+template <std::floating_point T> inline TriangleStore<T> get_input_store() {
+    TriangleStore<T> triangles;
+    read_input_data<T>([&](std::size_t N) { triangles.reserve(N); },
+                       [&](const Point<T> &p0, const Point<T> &p1, const Point<T> &p2,
+                           std::size_t id) { triangles.push_back(p0, p1, p2, id); });
     return triangles;
 }
 
+// The input with the boxes of the scene. Binary input is copied out of the mapping into the
+// store with the boxes found on the way. Text is parsed by parse_text_input_parallel with more
+// than one core; on one core its extra passes do not pay off. Other inputs go through the
+// sequential readers, followed by one pass for the boxes.
+template <std::floating_point T> inline io::LoadedTriangles<T> load_input() {
+    const io::MappedInput input(STDIN_FILENO);
+    const io::InputFormat format = io::detect_input_format(input.text());
+    if (format == io::InputFormat::binary)
+        return io::read_binary_input<T>(input.text());
+    if (format == io::InputFormat::text && std::thread::hardware_concurrency() > 1)
+        return io::parse_text_input_parallel<T>(input.text());
+
+    io::LoadedTriangles<T> loaded;
+    io::parse_input<T>(
+        input.text(), [&](std::size_t N) { loaded.triangles.reserve(N); },
+        [&](const Point<T> &p0, const Point<T> &p1, const Point<T> &p2, std::size_t id) {
+            loaded.triangles.push_back(p0, p1, p2, id);
+
+            // the box while the vertices are at hand, not in another pass
+            const bounding_box::AABB<T> box(
+                Point<T>(std::min({p0.x_, p1.x_, p2.x_}), std::min({p0.y_, p1.y_, p2.y_}),
+                         std::min({p0.z_, p1.z_, p2.z_})),
+                Point<T>(std::max({p0.x_, p1.x_, p2.x_}), std::max({p0.y_, p1.y_, p2.y_}),
+                         std::max({p0.z_, p1.z_, p2.z_})));
+            loaded.box.wrap_in_box_with(box);
+        });
+    return loaded;
+}
+
+// The ids on standard output in `format`, formatted into one large buffer that goes out with
+// write(2). `number_of_triangles` is the length of the bitmap format.
 inline void
-print_numbers_of_intersecting_triangles(const std::set<std::size_t> &intersecting_triangles) {
-    for (std::size_t id : intersecting_triangles) {
-        std::cout << id << '\n';
-    }
+print_numbers_of_intersecting_triangles(const std::set<std::size_t> &intersecting_triangles,
+                                        io::ResultFormat format = io::ResultFormat::text,
+                                        std::size_t number_of_triangles = 0) {
+    std::cout.flush();
+    io::write_ids(STDOUT_FILENO, intersecting_triangles, format, number_of_triangles);
+}
+
+template <std::floating_point T> std::set<std::size_t> driver(TriangleStore<T> triangles) {
+    bin_tree::BVH<T> tree_root(std::move(triangles));
+    tree_root.build();
+
+    std::set<std::size_t> intersecting_triangles =
+        std::thread::hardware_concurrency() > 1 ? tree_root.get_intersecting_triangles_pipelined()
+                                                : tree_root.get_intersecting_triangles();
+
+    return intersecting_triangles;
+}
+
+// the box of the scene from the loader saves the build a pass
+template <std::floating_point T> std::set<std::size_t> driver(io::LoadedTriangles<T> loaded) {
+    bin_tree::BVH<T> tree_root(std::move(loaded.triangles));
+    tree_root.build(loaded.box);
+
+    return std::thread::hardware_concurrency() > 1
+               ? tree_root.get_intersecting_triangles_pipelined()
+               : tree_root.get_intersecting_triangles();
+}
+
+// The input loaded and the boxes and centers of the build computed, timed as "load" and
+// "prepare". With `overlap` standard input must be in the text format; it is streamed, and
+// the prepare stage runs on a second thread while the input is parsed.
+template <std::floating_point T>
+io::PreparedTriangles<T> load_prepared(bool overlap, timing::StageTimings &timings) {
+    if (overlap)
+        return io::load_overlapped<T>(STDIN_FILENO, timings);
+
+    io::PreparedTriangles<T> prepared;
+    prepared.loaded = timings.measure("load", [] { return load_input<T>(); });
+    prepared.arrays = timings.measure(
+        "prepare", [&] { return bin_tree::BuildArrays<T>(prepared.loaded.triangles); });
+    return prepared;
+}
+
+// The id query with the time of every stage in `timings`: the input is loaded and prepared
+// by load_prepared, the tree is built and queried; the size of the input goes to
+// `number_of_triangles`.
+template <std::floating_point T>
+std::set<std::size_t> timed_driver(bool overlap, timing::StageTimings &timings,
+                                   std::size_t &number_of_triangles) {
+    io::PreparedTriangles<T> prepared = load_prepared<T>(overlap, timings);
+
+    number_of_triangles = prepared.loaded.triangles.size();
+    bin_tree::BVH<T> tree_root(std::move(prepared.loaded.triangles));
+    timings.measure("build", [&] { tree_root.build(prepared.arrays, prepared.loaded.box); });
+    prepared.arrays = bin_tree::BuildArrays<T>();
+
+    return timings.measure("query", [&] {
+        return std::thread::hardware_concurrency() > 1
+                   ? tree_root.get_intersecting_triangles_pipelined()
+                   : tree_root.get_intersecting_triangles();
+    });
+}
+
+// timed_driver with the shape of the tree and the counters of the query in `stats`. The query
+// is the sequential one with every candidate pair through the scalar tests, so its time is
+// that of the counted query, not of the one the other modes run.
+template <std::floating_point T>
+std::set<std::size_t> stats_driver(bool overlap, bin_tree::QueryStats &stats,
+                                   std::size_t &number_of_triangles) {
+    io::PreparedTriangles<T> prepared = load_prepared<T>(overlap, stats.timings);
+
+    number_of_triangles = prepared.loaded.triangles.size();
+    bin_tree::BVH<T> tree_root(std::move(prepared.loaded.triangles));
+    stats.timings.measure("build",
+                          [&] { tree_root.build(prepared.arrays, prepared.loaded.box); });
+    prepared.arrays = bin_tree::BuildArrays<T>();
+    stats.tree = tree_root.get_tree_shape();
+
+    return stats.timings.measure(
+        "query", [&] { return tree_root.get_intersecting_triangles_counted(stats.counters); });
 }
 
 template <std::floating_point T> std::set<std::size_t> driver(std::vector<Triangle<T>> triangles) {
-    std::ios::sync_with_stdio(false);
-    std::cin.tie(nullptr);
+    return driver(TriangleStore<T>(triangles));
+}
+
+// The tree is built over the caller's triangles through a TriangleView: they are neither
+// copied nor reordered
+template <std::floating_point T>
+std::set<std::size_t> view_driver(std::span<const Triangle<T>> triangles) {
+    bin_tree::BVH<T, TriangleView<T>> tree_root{TriangleView<T>(triangles)};
+    tree_root.build();
+
+    return std::thread::hardware_concurrency() > 1
+               ? tree_root.get_intersecting_triangles_pipelined()
+               : tree_root.get_intersecting_triangles();
+}
+
+// The soup welded into an indexed mesh first, so the BVH and the narrowphase work on shared
+// vertices; the size of the mesh goes to `stats`
+template <std::floating_point T>
+std::set<std::size_t> mesh_driver(TriangleStore<T> soup, std::ostream &stats = std::cerr) {
+    IndexedMesh<T> mesh = weld_vertices(soup);
+    const std::size_t soup_bytes = soup.size() * TriangleStore<T>::bytes_per_triangle;
+    soup = TriangleStore<T>();
+
+    const double per_triangle =
+        mesh.empty() ? 0.0 : static_cast<double>(mesh.get_memory_size()) / mesh.size();
+    stats << "indexed mesh: " << mesh.size() << " triangles, " << mesh.get_number_of_vertices()
+          << " vertices, " << mesh.get_memory_size() << " bytes (" << per_triangle
+          << " per triangle, soup " << soup_bytes << " bytes)\n";
+
+    bin_tree::BVH<T, IndexedMesh<T>> tree_root(std::move(mesh));
+    tree_root.build();
+
+    std::set<std::size_t> intersecting_triangles =
+        std::thread::hardware_concurrency() > 1 ? tree_root.get_intersecting_triangles_pipelined()
+                                                : tree_root.get_intersecting_triangles();
+
+    return intersecting_triangles;
+}
 
+// Float storage and narrowphase with escalation to double; the escalation counters go to
+// `stats`
+inline std::set<std::size_t> mixed_driver(std::vector<Triangle<float>> triangles,
+                                          std::ostream &stats = std::cerr) {
     bin_tree::BVH tree_root(std::move(triangles));
     tree_root.build();
 
-    std::set<std::size_t> intersecting_triangles = tree_root.get_intersecting_triangles();
+    std::set<std::size_t> intersecting_triangles = tree_root.get_intersecting_triangles_mixed();
+
+    const EscalationCounters &counters = tree_root.get_escalation_counters();
+    const double percent =
+        counters.pairs == 0 ? 0.0 : 100.0 * counters.escalated() / counters.pairs;
+    stats << "mixed precision: " << counters.pairs << " pairs, " << counters.escalated()
+          << " escalated to double (" << percent << "%): " << counters.band << " band, "
+          << counters.branch << " coplanar or touching, " << counters.degenerate
+          << " degenerate\n";
 
     return intersecting_triangles;
 }
 
+// Intersection geometry instead of ids: one line per intersecting pair,
+// "<id> <id> <number of vertices> x y z ..."
+template <std::floating_point T>
+void print_contacts(const bin_tree::ContactBuffer<T> &contacts, std::ostream &os = std::cout) {
+    for (const bin_tree::ContactRecord &record : contacts.get_records()) {
+        os << record.first_id << ' ' << record.second_id << ' ' << record.size;
+        for (const Point<T> &vertex : contacts.get_vertices(record))
+            os << ' ' << vertex.x_ << ' ' << vertex.y_ << ' ' << vertex.z_;
+        os << '\n';
+    }
+}
+
+template <std::floating_point T> void contacts_driver(std::vector<Triangle<T>> triangles) {
+    bin_tree::BVH tree_root(std::move(triangles));
+    tree_root.build();
+
+    print_contacts(std::thread::hardware_concurrency() > 1 ? tree_root.get_contacts_parallel()
+                                                           : tree_root.get_contacts());
+}
+
+// Same query with every vertex snapped to a 2^Bits grid of the scene box and exact integer
+// predicates instead of epsilon comparisons
+template <unsigned Bits, std::floating_point T>
+std::set<std::size_t> snap_driver(const std::vector<Triangle<T>> &triangles) {
+    snap::SnapBVH<Bits> tree_root(triangles);
+    tree_root.build();
+
+    return tree_root.get_intersecting_triangles();
+}
+
 } // namespace triangle
 
 #endif
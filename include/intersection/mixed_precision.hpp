@@ -0,0 +1,236 @@
+#ifndef INCLUDE_MIXED_PRECISION_HPP
+#define INCLUDE_MIXED_PRECISION_HPP
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+
+#include "common/cmp.hpp"
+#include "common/predicates.hpp"
+#include "intersection/triangle_to_triangle.hpp"
+#include "primitives/point.hpp"
+#include "primitives/triangle.hpp"
+#include "primitives/triangle_plane.hpp"
+#include "primitives/vector.hpp"
+
+namespace triangle {
+
+// Mixed precision narrowphase: triangles are stored and tested in float, and a pair is
+// re-evaluated in double only when the float answer might differ from the double one.
+// Each orientation value comes with the bound of its float rounding error (the filter
+// bound of predicates::orient_3d_adaptive); a value is uncertain when a cmp:: threshold
+// (+-epsilon, or 0 with exact predicates) lies within that bound. Outside the band the
+// float classification equals the exact one, and hence the double one, so the result
+// always matches the double narrowphase on the same float coordinates.
+
+/* ---------- how often the float narrowphase had to fall back to double ---------- */
+struct EscalationCounters {
+    std::size_t pairs = 0;      // narrowphase tests
+    std::size_t band = 0;       // escalated: an orientation value inside the uncertainty band
+    std::size_t branch = 0;     // escalated: coplanar or single vertex in the other plane
+    std::size_t degenerate = 0; // segment or point pairs, tested in double directly
+
+    std::size_t escalated() const noexcept { return band + branch + degenerate; }
+
+    EscalationCounters &operator+=(const EscalationCounters &other) noexcept {
+        pairs += other.pairs;
+        band += other.band;
+        branch += other.branch;
+        degenerate += other.degenerate;
+        return *this;
+    }
+};
+
+inline Point<double> widen(const Point<float> &point) {
+    return {point.x_, point.y_, point.z_};
+}
+
+inline Triangle<double> widen(const Triangle<float> &triangle) {
+    const auto &v = triangle.get_vertices();
+    return Triangle<double>(widen(v[0]), widen(v[1]), widen(v[2]), triangle.get_id());
+}
+
+namespace detail {
+
+/* ---------- float orientation value with the bound of its rounding error ---------- */
+struct BandedValue {
+    float value;
+    float error;
+
+    // cmp::pozitive / negative / is_zero cannot change within +-error; with exact
+    // predicates the threshold is 0 instead of +-epsilon
+    bool certain() const noexcept {
+        if constexpr (predicates::exact_mode)
+            return std::abs(value) > error;
+        else
+            return std::abs(std::abs(value) - cmp::precision<float>::epsilon) > error;
+    }
+
+    // what the scalar narrowphase classifies: the value, or its sign with exact predicates
+    float classified() const noexcept {
+        if constexpr (predicates::exact_mode)
+            return std::copysign(1.0f, value);
+        else
+            return value;
+    }
+};
+
+// orient_3d(a, b, c, d) and its error bound
+inline BandedValue orient_3d_banded(const Point<float> &a, const Point<float> &b,
+                                    const Point<float> &c, const Point<float> &d) noexcept {
+    const float ab_x = b.x_ - a.x_, ab_y = b.y_ - a.y_, ab_z = b.z_ - a.z_;
+    const float ac_x = c.x_ - a.x_, ac_y = c.y_ - a.y_, ac_z = c.z_ - a.z_;
+    const float ad_x = d.x_ - a.x_, ad_y = d.y_ - a.y_, ad_z = d.z_ - a.z_;
+
+    const float yz = ab_y * ac_z, zy = ab_z * ac_y;
+    const float zx = ab_z * ac_x, xz = ab_x * ac_z;
+    const float xy = ab_x * ac_y, yx = ab_y * ac_x;
+
+    const float value = (yz - zy) * ad_x + (zx - xz) * ad_y + (xy - yx) * ad_z;
+    const float permanent = (std::abs(yz) + std::abs(zy)) * std::abs(ad_x) +
+                            (std::abs(zx) + std::abs(xz)) * std::abs(ad_y) +
+                            (std::abs(xy) + std::abs(yx)) * std::abs(ad_z);
+
+    return {value, predicates::orient_3d_error_bound<float> * permanent};
+}
+
+// the three vertices of `base` against the plane of `ref`, each value computed like
+// TrianglePlane::orient; false if any of them is uncertain
+inline bool banded_signs(const Triangle<float> &base, const Triangle<float> &ref,
+                         const TrianglePlane<float> &ref_plane,
+                         const Vector<float> &ref_magnitude, std::array<float, 3> &signs) noexcept {
+    const Point<float> &origin = ref.get_vertices()[0];
+    const auto &v = base.get_vertices();
+
+    bool certain = true;
+    for (std::size_t i = 0; i < 3; ++i) {
+        const Vector<float> to_point(origin, v[i]);
+        const float permanent = ref_magnitude.x_ * std::abs(to_point.x_) +
+                                ref_magnitude.y_ * std::abs(to_point.y_) +
+                                ref_magnitude.z_ * std::abs(to_point.z_);
+        const BandedValue value{scalar_product(ref_plane.normal, to_point),
+                                predicates::orient_3d_error_bound<float> * permanent};
+
+        signs[i] = value.classified();
+        certain &= value.certain();
+    }
+    return certain;
+}
+
+enum class FloatVerdict {
+    separated,
+    intersecting,
+    uncertain, // an orientation inside the band
+    branch,    // coplanar or common vertex: decided by the double narrowphase
+};
+
+// intersect_triangles in float with every orientation checked against its band
+inline FloatVerdict intersect_triangles_float(const Triangle<float> &first,
+                                              const TrianglePlane<float> &first_plane,
+                                              const Vector<float> &first_magnitude,
+                                              const Triangle<float> &second,
+                                              const TrianglePlane<float> &second_plane,
+                                              const Vector<float> &second_magnitude) noexcept {
+    const auto &A = first.get_vertices();
+    const auto &B = second.get_vertices();
+
+    std::array<float, 3> signs;
+    if (!banded_signs(first, second, second_plane, second_magnitude, signs))
+        return FloatVerdict::uncertain;
+
+    const SignBits first_bits(signs);
+    if (first_bits.separated())
+        return FloatVerdict::separated;
+    if (first_bits.coplanar() || first_bits.common_vertice() < 3)
+        return FloatVerdict::branch;
+
+    if (!banded_signs(second, first, first_plane, first_magnitude, signs))
+        return FloatVerdict::uncertain;
+
+    const SignBits second_bits(signs);
+    if (second_bits.separated())
+        return FloatVerdict::separated;
+    if (second_bits.coplanar() || second_bits.common_vertice() < 3)
+        return FloatVerdict::branch;
+
+    const Permutation &m = canonical_permutation(first_bits);
+    const Permutation &r = canonical_permutation(second_bits);
+
+    const BandedValue sign_1 = orient_3d_banded(A[m[0]], A[m[1]], B[r[0]], B[r[1]]);
+    const BandedValue sign_2 = orient_3d_banded(A[m[0]], A[m[2]], B[r[2]], B[r[0]]);
+    if (!sign_1.certain() || !sign_2.certain())
+        return FloatVerdict::uncertain;
+
+    const float s_1 = sign_1.classified();
+    const float s_2 = sign_2.classified();
+    const bool overlap = (cmp::non_negative(s_1) && cmp::non_negative(s_2)) ||
+                         (cmp::non_pozitive(s_1) && cmp::non_pozitive(s_2));
+    return overlap ? FloatVerdict::intersecting : FloatVerdict::separated;
+}
+
+} // namespace detail
+
+// |products| of every component of the plane normal, the part of the error bound of
+// TrianglePlane::orient that does not depend on the point
+inline Vector<float> normal_magnitude(const TrianglePlane<float> &plane) noexcept {
+    const Vector<float> &e_1 = plane.edge_1;
+    const Vector<float> &e_2 = plane.edge_2;
+    return {std::abs(e_1.y_ * e_2.z_) + std::abs(e_1.z_ * e_2.y_),
+            std::abs(e_1.z_ * e_2.x_) + std::abs(e_1.x_ * e_2.z_),
+            std::abs(e_1.x_ * e_2.y_) + std::abs(e_1.y_ * e_2.x_)};
+}
+
+// intersect_triangles for two triangles of TypeTriangle::triangle stored in float, with
+// the double narrowphase as the fallback
+inline bool intersect_triangles_mixed(const Triangle<float> &first,
+                                      const TrianglePlane<float> &first_plane,
+                                      const Vector<float> &first_magnitude,
+                                      const Triangle<float> &second,
+                                      const TrianglePlane<float> &second_plane,
+                                      const Vector<float> &second_magnitude,
+                                      EscalationCounters &counters) {
+    ++counters.pairs;
+
+    switch (detail::intersect_triangles_float(first, first_plane, first_magnitude, second,
+                                              second_plane, second_magnitude)) {
+    case detail::FloatVerdict::separated:
+        return false;
+    case detail::FloatVerdict::intersecting:
+        return true;
+    case detail::FloatVerdict::uncertain:
+        ++counters.band;
+        break;
+    case detail::FloatVerdict::branch:
+        ++counters.branch;
+        break;
+    }
+
+    const Triangle<double> wide_first = widen(first);
+    const Triangle<double> wide_second = widen(second);
+    return intersect_triangles(wide_first, TrianglePlane<double>(wide_first), wide_second,
+                               TrianglePlane<double>(wide_second));
+}
+
+inline bool intersect_triangles_mixed(const Triangle<float> &first, const Triangle<float> &second,
+                                      EscalationCounters &counters) {
+    const TrianglePlane<float> first_plane(first);
+    const TrianglePlane<float> second_plane(second);
+    return intersect_triangles_mixed(first, first_plane, normal_magnitude(first_plane), second,
+                                     second_plane, normal_magnitude(second_plane), counters);
+}
+
+// intersect() with the same policy: proper triangle pairs go through the float filter,
+// pairs with a segment or a point are rare and tested in double
+inline bool intersect_mixed(const Triangle<float> &first, const Triangle<float> &second,
+                            EscalationCounters &counters) {
+    if (first.get_type() == TypeTriangle::triangle && second.get_type() == TypeTriangle::triangle)
+        return intersect_triangles_mixed(first, second, counters);
+
+    ++counters.pairs;
+    ++counters.degenerate;
+    return intersect(widen(first), widen(second));
+}
+
+} // namespace triangle
+
+#endif // INCLUDE_MIXED_PRECISION_HPP
@@ -5,6 +5,7 @@
 #include "intersection/point_to_segment.hpp"
 #include "primitives/point.hpp"
 #include "primitives/triangle.hpp"
+#include "primitives/triangle_plane.hpp"
 
 namespace triangle {
 
@@ -18,7 +19,8 @@ bool is_in_plane(const Point<T> &point, const Triangle<T> &triangle) {
 }
 
 template <std::floating_point T>
-bool point_inside_triangle(const Triangle<T> &triangle, const Point<T> &point) {
+bool point_inside_triangle(const Triangle<T> &triangle, const TrianglePlane<T> &plane,
+                           const Point<T> &point) {
     if (triangle.get_type() == TypeTriangle::point)
         return triangle.get_vertices()[0] == point;
 
@@ -28,16 +30,18 @@ bool point_inside_triangle(const Triangle<T> &triangle, const Point<T> &point) {
         return is_point_on_segment(vertices[segment.first], vertices[segment.second], point);
     }
 
-    if (!is_in_plane(point, triangle))
-        return false;
-
-    auto vertices = triangle.get_vertices();
+    const auto &vertices = triangle.get_vertices();
 
     // Calculate vectors from the vertices of the triangle to the point
-    Vector<T> v0(vertices[0], vertices[1]);
-    Vector<T> v1(vertices[0], vertices[2]);
+    const Vector<T> &v0 = plane.edge_1;
+    const Vector<T> &v1 = plane.edge_2;
     Vector<T> v2(vertices[0], point);
 
+    // the point is usually a constructed one, so the plane test keeps its epsilon
+    // tolerance even with exact predicates
+    if (!cmp::is_zero(scalar_product(plane.normal, v2)))
+        return false;
+
     // Calculate dot-products
     T dot00 = scalar_product(v0, v0);
     T dot01 = scalar_product(v0, v1);
@@ -55,6 +59,11 @@ bool point_inside_triangle(const Triangle<T> &triangle, const Point<T> &point) {
            (u + v <= 1.0 + cmp::precision<T>::epsilon);
 }
 
+template <std::floating_point T>
+bool point_inside_triangle(const Triangle<T> &triangle, const Point<T> &point) {
+    return point_inside_triangle(triangle, TrianglePlane<T>(triangle), point);
+}
+
 } // namespace triangle
 
 #endif
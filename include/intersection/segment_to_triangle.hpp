@@ -31,26 +31,23 @@ bool check_segment_triangle_intersection_2d(const Point<T> &seg_start, const Poi
     return false;
 }
 
+// both arguments of TypeTriangle::interval
 template <std::floating_point T>
-inline bool segment_intersect_triangle(const Triangle<T> &triangle, const Triangle<T> &interval) {
-    if (triangle.get_type() == TypeTriangle::point) {
-        auto vertices = interval.get_vertices();
-        auto ends = interval.get_interval();
-        return is_point_on_segment(vertices[ends.first], vertices[ends.second],
-                                   triangle.get_vertices()[0]);
-    }
-
-    if (triangle.get_type() == TypeTriangle::interval) {
-        auto vertices_2 = triangle.get_vertices();
-        auto ends_2 = triangle.get_interval();
+inline bool segment_intersect_segment(const Triangle<T> &first, const Triangle<T> &second) {
+    const auto &vertices_2 = second.get_vertices();
+    auto ends_2 = second.get_interval();
 
-        auto vertices_1 = interval.get_vertices();
-        auto ends_1 = interval.get_interval();
+    const auto &vertices_1 = first.get_vertices();
+    auto ends_1 = first.get_interval();
 
-        return check_segments_intersect_3d(vertices_1[ends_1.first], vertices_1[ends_1.second],
-                                           vertices_2[ends_2.first], vertices_2[ends_2.second]);
-    }
+    return check_segments_intersect_3d(vertices_1[ends_1.first], vertices_1[ends_1.second],
+                                       vertices_2[ends_2.first], vertices_2[ends_2.second]);
+}
 
+// segment_intersect_triangle for a triangle of TypeTriangle::triangle, without the type dispatch
+template <std::floating_point T>
+inline bool segment_intersect_proper_triangle(const Triangle<T> &triangle,
+                                              const Triangle<T> &interval) {
     std::pair<size_t, size_t> interval_ends = interval.get_interval();
 
     auto interval_vertices = interval.get_vertices();
@@ -95,6 +92,21 @@ inline bool segment_intersect_triangle(const Triangle<T> &triangle, const Triang
     return false;
 }
 
+template <std::floating_point T>
+inline bool segment_intersect_triangle(const Triangle<T> &triangle, const Triangle<T> &interval) {
+    if (triangle.get_type() == TypeTriangle::point) {
+        auto vertices = interval.get_vertices();
+        auto ends = interval.get_interval();
+        return is_point_on_segment(vertices[ends.first], vertices[ends.second],
+                                   triangle.get_vertices()[0]);
+    }
+
+    if (triangle.get_type() == TypeTriangle::interval)
+        return segment_intersect_segment(/*first=*/interval, /*second=*/triangle);
+
+    return segment_intersect_proper_triangle(triangle, interval);
+}
+
 } // namespace triangle
 
 #endif
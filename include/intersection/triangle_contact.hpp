@@ -0,0 +1,266 @@
+#ifndef INCLUDE_TRIANGLE_CONTACT_HPP
+#define INCLUDE_TRIANGLE_CONTACT_HPP
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+
+#include "common/cmp.hpp"
+#include "intersection/triangle_to_triangle.hpp"
+#include "intersection/triangle_to_triangle_2d.hpp"
+#include "primitives/contact.hpp"
+#include "primitives/point.hpp"
+#include "primitives/triangle.hpp"
+#include "primitives/triangle_plane.hpp"
+#include "primitives/vector.hpp"
+
+namespace triangle {
+
+// Construction of the intersection set. The yes/no answer always comes from intersect(),
+// so a contact is empty exactly when intersect() is false; the geometry is then built in
+// floating point with the same cmp:: tolerances.
+
+namespace detail {
+
+template <std::floating_point T> Point<T> lerp(const Point<T> &p, const Point<T> &q, T t) {
+    return {p.x_ + (q.x_ - p.x_) * t, p.y_ + (q.y_ - p.y_) * t, p.z_ + (q.z_ - p.z_) * t};
+}
+
+template <std::floating_point T> Point<T> midpoint(const Point<T> &p, const Point<T> &q) {
+    return lerp(p, q, T{0.5});
+}
+
+template <std::floating_point T> T dot(const Vector<T> &direction, const Point<T> &p) {
+    return direction.x_ * p.x_ + direction.y_ * p.y_ + direction.z_ * p.z_;
+}
+
+// the two points of [start, end] and [first, last] (ordered by `key`) that bound their
+// overlap, or the middle of the gap when tolerance let intersect() accept disjoint ranges
+template <std::floating_point T, typename Key>
+Contact<T> overlap(const Point<T> &start_1, const Point<T> &end_1, const Point<T> &start_2,
+                   const Point<T> &end_2, Key key) {
+    const Point<T> &start = key(start_1) >= key(start_2) ? start_1 : start_2;
+    const Point<T> &end = key(end_1) <= key(end_2) ? end_1 : end_2;
+
+    if (key(start) > key(end))
+        return Contact<T>(midpoint(start, end));
+    return Contact<T>(start, end);
+}
+
+/* ---------- part of a triangle lying in a plane it crosses ---------- */
+template <std::floating_point T> struct PlaneSection {
+    Contact<T> points; // vertices in the plane and edge crossings
+    std::size_t closest = 0; // vertex nearest to the plane, if tolerance left no points
+
+    PlaneSection(const std::array<Point<T>, 3> &vertices, const std::array<T, 3> &distances) {
+        for (std::size_t i = 0; i < 3; ++i) {
+            const std::size_t j = (i + 1) % 3;
+            if (std::abs(distances[i]) < std::abs(distances[closest]))
+                closest = i;
+
+            if (cmp::is_zero(distances[i]))
+                points.push(vertices[i]);
+
+            const bool crosses = (cmp::pozitive(distances[i]) && cmp::negative(distances[j])) ||
+                                 (cmp::negative(distances[i]) && cmp::pozitive(distances[j]));
+            if (crosses)
+                points.push(
+                    lerp(vertices[i], vertices[j], distances[i] / (distances[i] - distances[j])));
+        }
+        points.close();
+        if (points.empty())
+            points.push(vertices[closest]);
+    }
+};
+
+// signed plane values of the vertices of `base`, as update_sign_orient computes them
+template <std::floating_point T>
+std::array<T, 3> plane_distances(const Triangle<T> &base, const Triangle<T> &ref,
+                                 const TrianglePlane<T> &ref_plane) {
+    const auto &v = base.get_vertices();
+    const Point<T> &origin = ref.get_vertices()[0];
+
+    return {scalar_product(ref_plane.normal, Vector<T>(origin, v[0])),
+            scalar_product(ref_plane.normal, Vector<T>(origin, v[1])),
+            scalar_product(ref_plane.normal, Vector<T>(origin, v[2]))};
+}
+
+// Both triangles cross the line where the planes meet; the contact is the overlap of the
+// two sections along that line
+template <std::floating_point T>
+Contact<T> triangles_contact_3d(const Triangle<T> &first, const TrianglePlane<T> &first_plane,
+                                const Triangle<T> &second, const TrianglePlane<T> &second_plane) {
+    const PlaneSection<T> section_1(first.get_vertices(),
+                                    plane_distances(first, second, second_plane));
+    const PlaneSection<T> section_2(second.get_vertices(),
+                                    plane_distances(second, first, first_plane));
+
+    const Vector<T> direction = vector_product(first_plane.normal, second_plane.normal);
+    auto key = [&direction](const Point<T> &p) { return dot(direction, p); };
+
+    auto extremes = [&key](const Contact<T> &points) {
+        const auto vertices = points.get_vertices();
+        std::size_t low = 0, high = 0;
+        for (std::size_t i = 1; i < vertices.size(); ++i) {
+            if (key(vertices[i]) < key(vertices[low]))
+                low = i;
+            if (key(vertices[i]) > key(vertices[high]))
+                high = i;
+        }
+        return std::array<Point<T>, 2>{vertices[low], vertices[high]};
+    };
+
+    const auto range_1 = extremes(section_1.points);
+    const auto range_2 = extremes(section_2.points);
+    return overlap(range_1[0], range_1[1], range_2[0], range_2[1], key);
+}
+
+// Sutherland-Hodgman: the convex `polygon` (a segment counts as a two-vertex polygon)
+// clipped by the half-planes of the edges of `tri`, in the projection of their common plane
+template <std::floating_point T>
+Contact<T> clip_by_triangle(const Contact<T> &polygon, const Triangle<T> &tri,
+                            const PlaneProjection<T> &projection) {
+    const auto &t = tri.get_vertices();
+    const auto t_2d = projection.project(t);
+    const T winding = projection.orient(t_2d[0], t_2d[1], t_2d[2]) < 0 ? T{-1} : T{1};
+    const T eps = cmp::precision<T>::epsilon;
+
+    Contact<T> current = polygon;
+    for (std::size_t edge = 0; edge < 3 && !current.empty(); ++edge) {
+        const auto &a = t_2d[edge];
+        const auto &b = t_2d[(edge + 1) % 3];
+        auto side = [&](const Point<T> &p) {
+            return winding * projection.orient(a, b, projection.project(p));
+        };
+
+        const auto vertices = current.get_vertices();
+        Contact<T> clipped;
+        for (std::size_t i = 0; i < vertices.size(); ++i) {
+            const Point<T> &p = vertices[i];
+            const Point<T> &q = vertices[(i + 1) % vertices.size()];
+            const T s_p = side(p);
+            const T s_q = side(q);
+
+            if (s_p >= -eps)
+                clipped.push(p);
+            if ((s_p > eps && s_q < -eps) || (s_p < -eps && s_q > eps))
+                clipped.push(lerp(p, q, s_p / (s_p - s_q)));
+        }
+        clipped.close();
+        current = clipped;
+    }
+    return current;
+}
+
+template <std::floating_point T>
+Contact<T> coplanar_contact(const Contact<T> &polygon, const Triangle<T> &tri,
+                            const Vector<T> &n) {
+    const PlaneProjection<T> projection(n);
+    if (!projection.is_valid())
+        return Contact<T>(polygon.get_vertices()[0]);
+
+    Contact<T> contact = clip_by_triangle(polygon, tri, projection);
+    if (contact.empty()) // touching within tolerance, outside the clip epsilon
+        contact.push(polygon.get_vertices()[0]);
+    return contact;
+}
+
+template <std::floating_point T>
+Contact<T> segments_contact(const Point<T> &a, const Point<T> &b, const Point<T> &c,
+                            const Point<T> &d) {
+    const Vector<T> ab{a, b};
+    const Vector<T> cd{c, d};
+    const Vector<T> ac{a, c};
+    const Vector<T> n = vector_product(ab, cd);
+    const T denom = scalar_product(n, n);
+
+    if (cmp::is_zero(denom)) { // collinear: overlap along ab
+        const T length = scalar_product(ab, ab);
+        if (cmp::is_zero(length))
+            return Contact<T>(a);
+
+        auto key = [&](const Point<T> &p) { return scalar_product(ab, Vector<T>(a, p)); };
+        const bool forward = key(c) <= key(d);
+        return overlap(a, b, forward ? c : d, forward ? d : c, key);
+    }
+
+    // closest points of the two lines, as in check_segments_intersect_3d
+    auto clamp = [](T value) { return std::min(std::max(value, T{0}), T{1}); };
+    const T t = clamp(scalar_product(vector_product(ac, cd), n) / denom);
+    const T u = clamp(scalar_product(vector_product(ac, ab), n) / denom);
+
+    return Contact<T>(midpoint(lerp(a, b, t), lerp(c, d, u)));
+}
+
+template <std::floating_point T>
+Contact<T> segment_triangle_contact(const Point<T> &start, const Point<T> &end,
+                                    const Triangle<T> &tri, const TrianglePlane<T> &plane) {
+    const Vector<T> direction{start, end};
+    const T denom = scalar_product(plane.normal, direction);
+
+    if (cmp::is_zero(denom)) // lies in the plane
+        return coplanar_contact(Contact<T>(start, end), tri, plane.normal);
+
+    const T t = scalar_product(plane.normal, Vector<T>(start, tri.get_vertices()[0])) / denom;
+    return Contact<T>(lerp(start, end, std::min(std::max(t, T{0}), T{1})));
+}
+
+template <std::floating_point T> std::array<Point<T>, 2> interval_ends(const Triangle<T> &tr) {
+    const auto &v = tr.get_vertices();
+    const auto [first, second] = tr.get_interval();
+    return {v[first], v[second]};
+}
+
+} // namespace detail
+
+// Intersection set of two triangles: a point, a segment, or for coplanar triangles the
+// overlap polygon; empty when intersect() is false. Degenerate triangles take part as the
+// point or segment they are.
+template <std::floating_point T>
+Contact<T> intersection(const Triangle<T> &first, const TrianglePlane<T> &first_plane,
+                        const Triangle<T> &second, const TrianglePlane<T> &second_plane) {
+    if (!intersect(first, first_plane, second, second_plane))
+        return {};
+
+    if (first.get_type() == TypeTriangle::point)
+        return Contact<T>(first.get_vertices()[0]);
+    if (second.get_type() == TypeTriangle::point)
+        return Contact<T>(second.get_vertices()[0]);
+
+    if (first.get_type() == TypeTriangle::interval) {
+        const auto ends = detail::interval_ends(first);
+        if (second.get_type() == TypeTriangle::interval) {
+            const auto other = detail::interval_ends(second);
+            return detail::segments_contact(ends[0], ends[1], other[0], other[1]);
+        }
+        return detail::segment_triangle_contact(ends[0], ends[1], second, second_plane);
+    }
+    if (second.get_type() == TypeTriangle::interval) {
+        const auto ends = detail::interval_ends(second);
+        return detail::segment_triangle_contact(ends[0], ends[1], first, first_plane);
+    }
+
+    // intersect() takes the 2d path if either triangle lies in the plane of the other
+    auto in_plane = [](const std::array<T, 3> &d) {
+        return cmp::is_zero(d[0]) && cmp::is_zero(d[1]) && cmp::is_zero(d[2]);
+    };
+    if (in_plane(detail::plane_distances(first, second, second_plane)) ||
+        in_plane(detail::plane_distances(second, first, first_plane))) {
+        Contact<T> polygon;
+        for (const auto &vertex : first.get_vertices())
+            polygon.push(vertex);
+        polygon.close();
+        return detail::coplanar_contact(polygon, second, first_plane.normal);
+    }
+
+    return detail::triangles_contact_3d(first, first_plane, second, second_plane);
+}
+
+template <std::floating_point T>
+Contact<T> intersection(const Triangle<T> &first, const Triangle<T> &second) {
+    return intersection(first, TrianglePlane<T>(first), second, TrianglePlane<T>(second));
+}
+
+} // namespace triangle
+
+#endif // INCLUDE_TRIANGLE_CONTACT_HPP
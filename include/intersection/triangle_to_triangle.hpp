@@ -2,34 +2,78 @@
 #define INCLUDE_TRIANGLE_TO_TRIANGLE_HPP
 
 #include <array>
+#include <cstdint>
+#include <utility>
 
 #include "common/cmp.hpp"
+#include "common/predicates.hpp"
 #include "intersection/point_to_triangle.hpp"
 #include "intersection/segment_to_triangle.hpp"
 #include "intersection/triangle_to_triangle_2d.hpp"
 #include "primitives/point.hpp"
 #include "primitives/triangle.hpp"
+#include "primitives/triangle_plane.hpp"
 #include "primitives/vector.hpp"
 
 namespace triangle {
 
+namespace detail {
+
+// exact signs for the vertex-plane values the filter left at 0
+template <std::floating_point T>
+[[gnu::noinline]] void resolve_exact(const std::array<Point<T>, 3> &plane,
+                                     const std::array<Point<T>, 3> &points,
+                                     std::array<T, 3> &signs) noexcept {
+    for (std::size_t i = 0; i < 3; ++i) {
+        if (signs[i] == 0)
+            signs[i] = static_cast<T>(
+                predicates::orient_3d_exact(plane[0], plane[1], plane[2], points[i]));
+    }
+}
+
+} // namespace detail
+
+// In exact predicate mode only the sign is returned, as -1, 0 or 1
 template <std::floating_point T>
 T orient_3d(const Point<T> &p_1, const Point<T> &q_1, const Point<T> &r_1, const Point<T> &p_2) {
-    Vector<T> p_q(q_1.x_ - p_1.x_, q_1.y_ - p_1.y_, q_1.z_ - p_1.z_);
-    Vector<T> p_r(r_1.x_ - p_1.x_, r_1.y_ - p_1.y_, r_1.z_ - p_1.z_);
-    Vector<T> p_p(p_2.x_ - p_1.x_, p_2.y_ - p_1.y_, p_2.z_ - p_1.z_);
+    if constexpr (predicates::exact_mode)
+        return predicates::orient_3d_adaptive(p_1, q_1, r_1, p_2);
+
+    Vector<T> p_q(p_1, q_1);
+    Vector<T> p_r(p_1, r_1);
+    Vector<T> p_p(p_1, p_2);
 
     return mixed_product(p_q, p_r, p_p);
 }
 
 template <std::floating_point T>
-void update_sign_orient(const Triangle<T> &base, const Triangle<T> &ref, std::array<T, 3> &signs) {
-    auto vertices_base = base.get_vertices();
-    auto vertices_ref = ref.get_vertices();
+void update_sign_orient(const std::array<Point<T>, 3> &vertices_base,
+                        const std::array<Point<T>, 3> &vertices_ref,
+                        const TrianglePlane<T> &ref_plane, std::array<T, 3> &signs) {
+    if constexpr (predicates::exact_mode) {
+        // filter all three first; the rare exact fallback stays out of the hot path
+        signs[0] = ref_plane.orient_filtered(vertices_ref, vertices_base[0]);
+        signs[1] = ref_plane.orient_filtered(vertices_ref, vertices_base[1]);
+        signs[2] = ref_plane.orient_filtered(vertices_ref, vertices_base[2]);
+
+        if (signs[0] == 0 || signs[1] == 0 || signs[2] == 0)
+            detail::resolve_exact(vertices_ref, vertices_base, signs);
+    } else {
+        signs[0] = ref_plane.orient(vertices_ref, vertices_base[0]);
+        signs[1] = ref_plane.orient(vertices_ref, vertices_base[1]);
+        signs[2] = ref_plane.orient(vertices_ref, vertices_base[2]);
+    }
+}
+
+template <std::floating_point T>
+void update_sign_orient(const Triangle<T> &base, const Triangle<T> &ref,
+                        const TrianglePlane<T> &ref_plane, std::array<T, 3> &signs) {
+    update_sign_orient(base.get_vertices(), ref.get_vertices(), ref_plane, signs);
+}
 
-    signs[0] = orient_3d(vertices_ref[0], vertices_ref[1], vertices_ref[2], vertices_base[0]);
-    signs[1] = orient_3d(vertices_ref[0], vertices_ref[1], vertices_ref[2], vertices_base[1]);
-    signs[2] = orient_3d(vertices_ref[0], vertices_ref[1], vertices_ref[2], vertices_base[2]);
+template <std::floating_point T>
+void update_sign_orient(const Triangle<T> &base, const Triangle<T> &ref, std::array<T, 3> &signs) {
+    update_sign_orient(base, ref, TrianglePlane<T>(ref), signs);
 }
 
 template <std::floating_point T>
@@ -56,24 +100,25 @@ size_t get_common_vertice(T sign_plane_p, T sign_plane_r, T sign_plane_q) {
          (cmp::negative(sign_plane_r) && cmp::negative(sign_plane_q))))
         return 0;
 
-    if (cmp::is_zero(sign_plane_q) &&
-        ((cmp::pozitive(sign_plane_r) && cmp::pozitive(sign_plane_p)) ||
-         (cmp::negative(sign_plane_r) && cmp::negative(sign_plane_p))))
-        return 1;
-
     if (cmp::is_zero(sign_plane_r) &&
         ((cmp::pozitive(sign_plane_p) && cmp::pozitive(sign_plane_q)) ||
          (cmp::negative(sign_plane_p) && cmp::negative(sign_plane_q))))
+        return 1;
+
+    if (cmp::is_zero(sign_plane_q) &&
+        ((cmp::pozitive(sign_plane_r) && cmp::pozitive(sign_plane_p)) ||
+         (cmp::negative(sign_plane_r) && cmp::negative(sign_plane_p))))
         return 2;
 
     return 0;
 }
 
 template <std::floating_point T>
-Sign check_relative_positions(const Triangle<T> &first, const Triangle<T> &second) {
+Sign check_relative_positions(const Triangle<T> &first, const TrianglePlane<T> &first_plane,
+                              const Triangle<T> &second, const TrianglePlane<T> &second_plane) {
     std::array<T, 3> signs;
 
-    update_sign_orient(first, second, signs);
+    update_sign_orient(first, second, second_plane, signs);
 
     if (cmp::pozitive(signs[0]) && cmp::pozitive(signs[1]) && cmp::pozitive(signs[2]))
         return Sign::pozitive;
@@ -88,7 +133,7 @@ Sign check_relative_positions(const Triangle<T> &first, const Triangle<T> &secon
     if (check_common_vertice(signs[0], signs[1], signs[2]))
         return Sign::common_vertice_other_poz_or_neg;
 
-    update_sign_orient(second, first, signs);
+    update_sign_orient(second, first, first_plane, signs);
 
     if (cmp::pozitive(signs[0]) && cmp::pozitive(signs[1]) && cmp::pozitive(signs[2]))
         return Sign::pozitive;
@@ -105,6 +150,12 @@ Sign check_relative_positions(const Triangle<T> &first, const Triangle<T> &secon
     return Sign::different;
 }
 
+template <std::floating_point T>
+Sign check_relative_positions(const Triangle<T> &first, const Triangle<T> &second) {
+    return check_relative_positions(first, TrianglePlane<T>(first), second,
+                                    TrianglePlane<T>(second));
+}
+
 template <std::floating_point T>
 bool check_segments_intersect(const Triangle<T> &canon_main, const Triangle<T> &canon_ref) {
     auto vertices_main = canon_main.get_vertices();
@@ -123,11 +174,12 @@ bool check_segments_intersect(const Triangle<T> &canon_main, const Triangle<T> &
 }
 
 template <std::floating_point T>
-Triangle<T> canonicalize_triangle(const Triangle<T> &base, const Triangle<T> &ref) {
+Triangle<T> canonicalize_triangle(const Triangle<T> &base, const Triangle<T> &ref,
+                                  const TrianglePlane<T> &ref_plane) {
     std::array<T, 3> signs;
     auto canon = base;
 
-    update_sign_orient(canon, ref, signs);
+    update_sign_orient(canon, ref, ref_plane, signs);
 
     if (cmp::negative(signs[0]) && cmp::non_negative(signs[1]) && cmp::non_negative(signs[2]))
         return canon;
@@ -152,7 +204,7 @@ Triangle<T> canonicalize_triangle(const Triangle<T> &base, const Triangle<T> &re
         canon.rotate_clockwise();
     }
 
-    update_sign_orient(canon, ref, signs);
+    update_sign_orient(canon, ref, ref_plane, signs);
 
     if (cmp::pozitive(signs[0]))
         canon.swap_vertices(1, 2);
@@ -161,24 +213,31 @@ Triangle<T> canonicalize_triangle(const Triangle<T> &base, const Triangle<T> &re
 }
 
 template <std::floating_point T>
-bool intersect_one_vertice_in_plane(const Triangle<T> &first, const Triangle<T> &second) {
+Triangle<T> canonicalize_triangle(const Triangle<T> &base, const Triangle<T> &ref) {
+    return canonicalize_triangle(base, ref, TrianglePlane<T>(ref));
+}
+
+template <std::floating_point T>
+bool intersect_one_vertice_in_plane(const Triangle<T> &first, const TrianglePlane<T> &first_plane,
+                                    const Triangle<T> &second,
+                                    const TrianglePlane<T> &second_plane) {
     size_t common_vertex;
     std::array<T, 3> signs;
 
-    update_sign_orient(first, second, signs);
+    update_sign_orient(first, second, second_plane, signs);
 
     if (check_common_vertice(signs[0], signs[1], signs[2])) {
         common_vertex = get_common_vertice(signs[0], signs[1], signs[2]);
-        if (point_inside_triangle(second, first.get_vertices()[common_vertex]))
+        if (point_inside_triangle(second, second_plane, first.get_vertices()[common_vertex]))
             return true;
         return false;
     }
 
-    update_sign_orient(second, first, signs);
+    update_sign_orient(second, first, first_plane, signs);
 
     if (check_common_vertice(signs[0], signs[1], signs[2])) {
         common_vertex = get_common_vertice(signs[0], signs[1], signs[2]);
-        if (point_inside_triangle(first, second.get_vertices()[common_vertex]))
+        if (point_inside_triangle(first, first_plane, second.get_vertices()[common_vertex]))
             return true;
     }
 
@@ -186,31 +245,202 @@ bool intersect_one_vertice_in_plane(const Triangle<T> &first, const Triangle<T>
 }
 
 template <std::floating_point T>
-bool intersect(const Triangle<T> &first, const Triangle<T> &second) {
+bool intersect_one_vertice_in_plane(const Triangle<T> &first, const Triangle<T> &second) {
+    return intersect_one_vertice_in_plane(first, TrianglePlane<T>(first), second,
+                                          TrianglePlane<T>(second));
+}
+
+namespace detail {
+
+/* ---------- cmp:: classification of three vertex-plane values, one bit per vertex ---------- */
+struct SignBits {
+    unsigned pozitive = 0;
+    unsigned negative = 0;
+    unsigned zero = 0;
+
+    template <std::floating_point T> explicit SignBits(const std::array<T, 3> &values) {
+        pozitive = unsigned{cmp::pozitive(values[0])} | unsigned{cmp::pozitive(values[1])} << 1 |
+                   unsigned{cmp::pozitive(values[2])} << 2;
+        negative = unsigned{cmp::negative(values[0])} | unsigned{cmp::negative(values[1])} << 1 |
+                   unsigned{cmp::negative(values[2])} << 2;
+        zero = unsigned{cmp::is_zero(values[0])} | unsigned{cmp::is_zero(values[1])} << 1 |
+               unsigned{cmp::is_zero(values[2])} << 2;
+    }
+
+    bool separated() const noexcept { return pozitive == 0b111 || negative == 0b111; }
+    bool coplanar() const noexcept { return zero == 0b111; }
+
+    // vertex lying in the other plane while the remaining two are strictly on one side,
+    // 3 if there is none (check_common_vertice / get_common_vertice)
+    unsigned common_vertice() const noexcept {
+        for (unsigned i = 0; i < 3; ++i) {
+            const unsigned others = 0b111 & ~(1u << i);
+            const bool others_on_one_side =
+                (pozitive & others) == others || (negative & others) == others;
+            if ((zero >> i & 1u) && others_on_one_side)
+                return i;
+        }
+        return 3;
+    }
+};
+
+using Permutation = std::array<std::uint8_t, 3>;
+
+// canonicalize_triangle as a vertex permutation, indexed by pozitive | negative << 3
+constexpr std::array<Permutation, 64> make_canonical_permutations() {
+    constexpr Permutation identity{0, 1, 2};
+    constexpr Permutation rotate_once{2, 0, 1};  // rotate_clockwise()
+    constexpr Permutation rotate_twice{1, 2, 0}; // rotate_clockwise() twice
+
+    std::array<Permutation, 64> table{};
+    for (unsigned index = 0; index < 64; ++index) {
+        const unsigned pos = index & 0b111;
+        const unsigned neg = index >> 3;
+        auto is_pos = [pos](unsigned i) { return (pos >> i & 1u) != 0; };
+        auto is_neg = [neg](unsigned i) { return (neg >> i & 1u) != 0; };
+
+        if (is_neg(0) && !is_neg(1) && !is_neg(2)) {
+            table[index] = identity;
+            continue;
+        }
+        if (!is_neg(0) && !is_neg(1) && is_neg(2)) {
+            table[index] = rotate_once;
+            continue;
+        }
+        if (!is_neg(0) && is_neg(1) && !is_neg(2)) {
+            table[index] = rotate_twice;
+            continue;
+        }
+
+        Permutation perm = identity;
+        if (!is_pos(0) && !is_pos(1) && is_pos(2))
+            perm = rotate_once;
+        else if (!is_pos(0) && is_pos(1) && !is_pos(2))
+            perm = rotate_twice;
+
+        if (is_pos(perm[0]))
+            perm = Permutation{perm[0], perm[2], perm[1]};
+
+        table[index] = perm;
+    }
+    return table;
+}
+
+inline constexpr std::array<Permutation, 64> canonical_permutations =
+    make_canonical_permutations();
+
+inline const Permutation &canonical_permutation(const SignBits &bits) noexcept {
+    return canonical_permutations[bits.pozitive | bits.negative << 3];
+}
+
+} // namespace detail
+
+// intersect() for two triangles of TypeTriangle::triangle, without the type dispatch.
+// Single pass of Devillers-Guigue: the six vertex-plane values are computed once, and the
+// canonical vertex order is looked up instead of rotating copies of the triangles.
+// on_branch(Sign) is told which case decided the pair, as check_relative_positions names it.
+// Takes the vertices alone, so callers reading coordinate columns build no Triangle objects;
+// only the rare coplanar and vertex-in-plane branches make them.
+template <std::floating_point T, typename OnBranch>
+bool intersect_triangles(const std::array<Point<T>, 3> &A, const TrianglePlane<T> &first_plane,
+                         const std::array<Point<T>, 3> &B, const TrianglePlane<T> &second_plane,
+                         OnBranch &&on_branch) {
+    auto triangle_of = [](const std::array<Point<T>, 3> &vertices) {
+        return Triangle<T>(vertices[0], vertices[1], vertices[2], TypeTriangle::triangle, 0);
+    };
+
+    std::array<T, 3> signs;
+
+    update_sign_orient(A, B, second_plane, signs);
+    const detail::SignBits first_bits(signs);
+
+    if (first_bits.separated()) {
+        on_branch(first_bits.pozitive == 0b111 ? Sign::pozitive : Sign::negative);
+        return false;
+    }
+    if (first_bits.coplanar()) {
+        on_branch(Sign::common_plane);
+        return intersect_2d(triangle_of(A), triangle_of(B), first_plane.normal); // 2d case
+    }
+    if (unsigned vertex = first_bits.common_vertice(); vertex < 3) {
+        on_branch(Sign::common_vertice_other_poz_or_neg);
+        return point_inside_triangle(triangle_of(B), second_plane, A[vertex]);
+    }
+
+    update_sign_orient(B, A, first_plane, signs);
+    const detail::SignBits second_bits(signs);
+
+    if (second_bits.separated()) {
+        on_branch(second_bits.pozitive == 0b111 ? Sign::pozitive : Sign::negative);
+        return false;
+    }
+    if (second_bits.coplanar()) {
+        on_branch(Sign::common_plane);
+        return intersect_2d(triangle_of(A), triangle_of(B), first_plane.normal);
+    }
+    if (unsigned vertex = second_bits.common_vertice(); vertex < 3) {
+        on_branch(Sign::common_vertice_other_poz_or_neg);
+        return point_inside_triangle(triangle_of(A), first_plane, B[vertex]);
+    }
+
+    // check_segments_intersect on the canonical orders
+    on_branch(Sign::different);
+    const detail::Permutation &m = detail::canonical_permutation(first_bits);
+    const detail::Permutation &r = detail::canonical_permutation(second_bits);
+
+    T sign_1, sign_2;
+    if constexpr (predicates::exact_mode) {
+        sign_1 = predicates::orient_3d_filtered(A[m[0]], A[m[1]], B[r[0]], B[r[1]]);
+        sign_2 = predicates::orient_3d_filtered(A[m[0]], A[m[2]], B[r[2]], B[r[0]]);
+
+        if (sign_1 == 0 || sign_2 == 0) {
+            sign_1 = orient_3d(A[m[0]], A[m[1]], B[r[0]], B[r[1]]);
+            sign_2 = orient_3d(A[m[0]], A[m[2]], B[r[2]], B[r[0]]);
+        }
+    } else {
+        sign_1 = orient_3d(A[m[0]], A[m[1]], B[r[0]], B[r[1]]);
+        sign_2 = orient_3d(A[m[0]], A[m[2]], B[r[2]], B[r[0]]);
+    }
+
+    if (cmp::non_negative(sign_1) && cmp::non_negative(sign_2))
+        return true;
+
+    return cmp::non_pozitive(sign_1) && cmp::non_pozitive(sign_2);
+}
+
+template <std::floating_point T, typename OnBranch>
+bool intersect_triangles(const Triangle<T> &first, const TrianglePlane<T> &first_plane,
+                         const Triangle<T> &second, const TrianglePlane<T> &second_plane,
+                         OnBranch &&on_branch) {
+    return intersect_triangles(first.get_vertices(), first_plane, second.get_vertices(),
+                               second_plane, std::forward<OnBranch>(on_branch));
+}
+
+template <std::floating_point T>
+bool intersect_triangles(const Triangle<T> &first, const TrianglePlane<T> &first_plane,
+                         const Triangle<T> &second, const TrianglePlane<T> &second_plane) {
+    return intersect_triangles(first, first_plane, second, second_plane, [](Sign) {});
+}
+
+// Same test as intersect(first, second) with the plane data of both triangles precomputed
+template <std::floating_point T>
+bool intersect(const Triangle<T> &first, const TrianglePlane<T> &first_plane,
+               const Triangle<T> &second, const TrianglePlane<T> &second_plane) {
     if (first.get_type() == TypeTriangle::point)
-        return point_inside_triangle(second, first.get_vertices()[0]);
+        return point_inside_triangle(second, second_plane, first.get_vertices()[0]);
     if (second.get_type() == TypeTriangle::point)
-        return point_inside_triangle(first, second.get_vertices()[0]);
+        return point_inside_triangle(first, first_plane, second.get_vertices()[0]);
     if (first.get_type() == TypeTriangle::interval)
         return segment_intersect_triangle(/*triangle=*/second, /*interval=*/first);
     if (second.get_type() == TypeTriangle::interval)
         return segment_intersect_triangle(/*triangle=*/first, /*interval=*/second);
 
-    Sign relative_positions = check_relative_positions(first, second);
-
-    if (relative_positions == Sign::pozitive || relative_positions == Sign::negative)
-        return false;
-
-    if (relative_positions == Sign::common_plane)
-        return intersect_2d(first, second); // 2d case
-
-    if (relative_positions == Sign::common_vertice_other_poz_or_neg)
-        return intersect_one_vertice_in_plane(first, second);
-
-    auto canon_main = canonicalize_triangle(first, second);
-    auto canon_ref = canonicalize_triangle(second, first);
+    return intersect_triangles(first, first_plane, second, second_plane);
+}
 
-    return check_segments_intersect(canon_main, canon_ref);
+template <std::floating_point T>
+bool intersect(const Triangle<T> &first, const Triangle<T> &second) {
+    return intersect(first, TrianglePlane<T>(first), second, TrianglePlane<T>(second));
 }
 
 } // namespace triangle
@@ -1,6 +1,8 @@
 #ifndef TRIANGLE_TO_TRIANGLE_2D_HPP
 #define TRIANGLE_TO_TRIANGLE_2D_HPP
 
+#include <array>
+#include <cmath>
 #include <cstddef>
 
 #include "primitives/triangle.hpp"
@@ -88,13 +90,113 @@ bool check_segment_intersect_2d(const Point<T> &a, const Point<T> &b, const Poin
     return false;
 }
 
+/* ---------- projection of a plane onto the coordinate plane of its dominant axis ---------- */
+template <std::floating_point T> struct ProjectedPoint {
+    T u;
+    T v;
+};
+
+template <std::floating_point T> class PlaneProjection {
+  private:
+    std::size_t u_ = 1;
+    std::size_t v_ = 2;
+    T scale_ = 0; // turns the projected orientation into orient_2d(a, b, c, n)
+
+    static T coordinate(const Point<T> &p, std::size_t axis) noexcept {
+        return axis == 0 ? p.x_ : (axis == 1 ? p.y_ : p.z_);
+    }
+
+  public:
+    explicit PlaneProjection(const Vector<T> &n) {
+        const T a_x = std::abs(n.x_), a_y = std::abs(n.y_), a_z = std::abs(n.z_);
+        const std::size_t axis = (a_x >= a_y && a_x >= a_z) ? 0 : (a_y >= a_z ? 1 : 2);
+        const T n_axis = axis == 0 ? n.x_ : (axis == 1 ? n.y_ : n.z_);
+
+        u_ = (axis + 1) % 3;
+        v_ = (axis + 2) % 3;
+        if (n_axis != 0)
+            scale_ = scalar_product(n, n) / n_axis;
+    }
+
+    // false for a zero normal, where there is no plane to project on
+    bool is_valid() const noexcept { return scale_ != 0; }
+
+    ProjectedPoint<T> project(const Point<T> &point) const noexcept {
+        return {coordinate(point, u_), coordinate(point, v_)};
+    }
+
+    std::array<ProjectedPoint<T>, 3> project(const std::array<Point<T>, 3> &points) const {
+        return {ProjectedPoint<T>{coordinate(points[0], u_), coordinate(points[0], v_)},
+                ProjectedPoint<T>{coordinate(points[1], u_), coordinate(points[1], v_)},
+                ProjectedPoint<T>{coordinate(points[2], u_), coordinate(points[2], v_)}};
+    }
+
+    // For points of the plane, (ab x ac) = k n and its dropped component is k n_axis, so
+    // scaling by |n|^2 / n_axis reproduces the mixed product orient_2d(a, b, c, n)
+    T orient(const ProjectedPoint<T> &a, const ProjectedPoint<T> &b,
+             const ProjectedPoint<T> &c) const noexcept {
+        return scale_ * ((b.u - a.u) * (c.v - a.v) - (b.v - a.v) * (c.u - a.u));
+    }
+};
+
+namespace detail {
+
 template <std::floating_point T>
-bool intersect_2d(const Triangle<T> &first, const Triangle<T> &second) {
+bool inside_triangle_2d(const PlaneProjection<T> &projection, const ProjectedPoint<T> &p,
+                        const std::array<ProjectedPoint<T>, 3> &triangle) {
+    const T s1 = projection.orient(triangle[0], triangle[1], p);
+    const T s2 = projection.orient(triangle[1], triangle[2], p);
+    const T s3 = projection.orient(triangle[2], triangle[0], p);
+
+    // check_relative_positions_2d == Sign::pozitive or Sign::negative
+    return (s1 >= -cmp::precision<T>::epsilon && s2 >= -cmp::precision<T>::epsilon &&
+            s3 >= -cmp::precision<T>::epsilon) ||
+           (s1 <= cmp::precision<T>::epsilon && s2 <= cmp::precision<T>::epsilon &&
+            s3 <= cmp::precision<T>::epsilon);
+}
+
+// on_segment_in_plane once the orientation is known to be zero
+template <std::floating_point T>
+bool within_segment(const Point<T> &a, const Point<T> &b, const Point<T> &p) {
+    Vector ab = Vector(a, b);
+    Vector ap = Vector(a, p);
+
+    auto t = scalar_product(ap, ab);
+    auto L2 = scalar_product(ab, ab);
+
+    return t >= -cmp::precision<T>::epsilon && t <= L2 + cmp::precision<T>::epsilon;
+}
+
+// check_segment_intersect_2d on projected points; a, b, c, d are the 3D originals
+template <std::floating_point T>
+bool segments_intersect_2d(const PlaneProjection<T> &projection, const Point<T> &a,
+                           const Point<T> &b, const Point<T> &c, const Point<T> &d,
+                           const ProjectedPoint<T> &a_2d, const ProjectedPoint<T> &b_2d,
+                           const ProjectedPoint<T> &c_2d, const ProjectedPoint<T> &d_2d) {
+    const T o1 = projection.orient(a_2d, b_2d, c_2d);
+    const T o2 = projection.orient(a_2d, b_2d, d_2d);
+    const T o3 = projection.orient(c_2d, d_2d, a_2d);
+    const T o4 = projection.orient(c_2d, d_2d, b_2d);
+
+    const T eps = cmp::precision<T>::epsilon;
+    const bool straddle1 = (o1 > eps && o2 < -eps) || (o1 < -eps && o2 > eps);
+    const bool straddle2 = (o3 > eps && o4 < -eps) || (o3 < -eps && o4 > eps);
+    if (straddle1 && straddle2)
+        return true;
+
+    return (std::abs(o1) <= eps && within_segment(a, b, c)) ||
+           (std::abs(o2) <= eps && within_segment(a, b, d)) ||
+           (std::abs(o3) <= eps && within_segment(c, d, a)) ||
+           (std::abs(o4) <= eps && within_segment(c, d, b));
+}
+
+// the same test with every orientation as a 3D mixed product against n
+template <std::floating_point T>
+bool intersect_2d_mixed_product(const Triangle<T> &first, const Triangle<T> &second,
+                                const Vector<T> &n) {
     const auto &A = first.get_vertices();
     const auto &B = second.get_vertices();
 
-    Vector<T> n = vector_product(Vector(A[0], A[1]), Vector(A[0], A[2]));
-
     for (std::size_t i = 0; i < 3; ++i) {
         auto relative_positions_2d = check_relative_positions_2d(A[i], B[0], B[1], B[2], n);
         if (relative_positions_2d == Sign::pozitive || relative_positions_2d == Sign::negative)
@@ -119,6 +221,46 @@ bool intersect_2d(const Triangle<T> &first, const Triangle<T> &second) {
     return false;
 }
 
+} // namespace detail
+
+// Coplanar triangles: both are projected once onto the coordinate plane of the largest
+// normal component, and the containment and edge-edge tests run on 2D points
+template <std::floating_point T>
+bool intersect_2d(const Triangle<T> &first, const Triangle<T> &second, const Vector<T> &n) {
+    const PlaneProjection<T> projection(n);
+    if (!projection.is_valid())
+        return detail::intersect_2d_mixed_product(first, second, n);
+
+    const auto &A = first.get_vertices();
+    const auto &B = second.get_vertices();
+    const auto a = projection.project(A);
+    const auto b = projection.project(B);
+
+    for (std::size_t i = 0; i < 3; ++i) {
+        if (detail::inside_triangle_2d(projection, a[i], b) ||
+            detail::inside_triangle_2d(projection, b[i], a))
+            return true;
+    }
+
+    for (std::size_t i = 0; i < 3; ++i) {
+        std::size_t inext = (i + 1) % 3;
+        for (std::size_t j = 0; j < 3; ++j) {
+            std::size_t jnext = (j + 1) % 3;
+            if (detail::segments_intersect_2d(projection, A[i], A[inext], B[j], B[jnext], a[i],
+                                              a[inext], b[j], b[jnext]))
+                return true;
+        }
+    }
+
+    return false;
+}
+
+template <std::floating_point T>
+bool intersect_2d(const Triangle<T> &first, const Triangle<T> &second) {
+    const auto &A = first.get_vertices();
+    return intersect_2d(first, second, vector_product(Vector(A[0], A[1]), Vector(A[0], A[2])));
+}
+
 } // namespace triangle
 
 #endif
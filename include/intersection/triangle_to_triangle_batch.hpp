@@ -0,0 +1,480 @@
+#ifndef INCLUDE_TRIANGLE_TO_TRIANGLE_BATCH_HPP
+#define INCLUDE_TRIANGLE_TO_TRIANGLE_BATCH_HPP
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "common/cmp.hpp"
+#include "common/predicates.hpp"
+#include "common/simd.hpp"
+#include "intersection/triangle_to_triangle.hpp"
+#include "primitives/triangle.hpp"
+#include "primitives/triangle_plane.hpp"
+#include "primitives/triangle_store.hpp"
+
+namespace triangle {
+
+/* ---------- triangles of a packet in structure-of-arrays form ---------- */
+template <std::size_t Width> struct TriangleLanes {
+    alignas(64) std::array<std::array<float, Width>, 3> x{}; // [vertex][lane]
+    alignas(64) std::array<std::array<float, Width>, 3> y{};
+    alignas(64) std::array<std::array<float, Width>, 3> z{};
+
+    void set_lane(std::size_t lane, const Triangle<float> &triangle) noexcept {
+        const auto &vertices = triangle.get_vertices();
+        for (std::size_t i = 0; i < 3; ++i) {
+            x[i][lane] = vertices[i].x_;
+            y[i][lane] = vertices[i].y_;
+            z[i][lane] = vertices[i].z_;
+        }
+    }
+
+    template <triangle_columns Triangles>
+    void set_lane(std::size_t lane, const Triangles &triangles, std::size_t index) noexcept {
+        for (std::size_t i = 0; i < 3; ++i) {
+            const Point<float> vertex = triangles.get_vertex(index, i);
+            x[i][lane] = vertex.x_;
+            y[i][lane] = vertex.y_;
+            z[i][lane] = vertex.z_;
+        }
+    }
+};
+
+/* ---------- up to Width candidate pairs processed together ---------- */
+template <std::size_t Width> struct PairPacket {
+    static_assert(Width <= 32, "lane masks are 32 bit wide");
+
+    TriangleLanes<Width> first;
+    TriangleLanes<Width> second;
+    std::uint32_t active = 0; // lanes holding a pair
+    std::uint32_t scalar = 0; // lanes that must take the scalar path (points and segments)
+
+    void set_lane(std::size_t lane, const Triangle<float> &a, const Triangle<float> &b) noexcept {
+        first.set_lane(lane, a);
+        second.set_lane(lane, b);
+
+        const std::uint32_t bit = std::uint32_t{1} << lane;
+        active |= bit;
+        if (a.get_type() != TypeTriangle::triangle || b.get_type() != TypeTriangle::triangle)
+            scalar |= bit;
+    }
+
+    template <triangle_columns Triangles>
+    void set_lane(std::size_t lane, const Triangles &triangles, std::size_t a,
+                  std::size_t b) noexcept {
+        first.set_lane(lane, triangles, a);
+        second.set_lane(lane, triangles, b);
+
+        const std::uint32_t bit = std::uint32_t{1} << lane;
+        active |= bit;
+        if (triangles.get_type(a) != TypeTriangle::triangle ||
+            triangles.get_type(b) != TypeTriangle::triangle)
+            scalar |= bit;
+    }
+
+    // both triangles known to be of TypeTriangle::triangle
+    void set_triangle_lane(std::size_t lane, const Triangle<float> &a,
+                           const Triangle<float> &b) noexcept {
+        first.set_lane(lane, a);
+        second.set_lane(lane, b);
+        active |= std::uint32_t{1} << lane;
+    }
+
+    template <triangle_columns Triangles>
+    void set_triangle_lane(std::size_t lane, const Triangles &triangles, std::size_t a,
+                           std::size_t b) noexcept {
+        first.set_lane(lane, triangles, a);
+        second.set_lane(lane, triangles, b);
+        active |= std::uint32_t{1} << lane;
+    }
+
+    void clear() noexcept { active = scalar = 0; }
+};
+
+struct PacketResult {
+    std::uint32_t hits;       // lanes proven to intersect
+    std::uint32_t unresolved; // lanes left for the scalar triangle::intersect
+};
+
+namespace detail {
+
+template <typename V> struct LanePoint {
+    V x;
+    V y;
+    V z;
+};
+
+template <typename V, std::size_t Width>
+LanePoint<V> load_vertex(const TriangleLanes<Width> &lanes, std::size_t vertex) noexcept {
+    return {V::load(lanes.x[vertex].data()), V::load(lanes.y[vertex].data()),
+            V::load(lanes.z[vertex].data())};
+}
+
+template <typename V>
+LanePoint<V> select_point(std::uint32_t mask, const LanePoint<V> &a, const LanePoint<V> &b) {
+    return {select(mask, a.x, b.x), select(mask, a.y, b.y), select(mask, a.z, b.z)};
+}
+
+// same operations in the same order as triangle::orient_3d
+template <typename V>
+V orient_3d(const LanePoint<V> &p_1, const LanePoint<V> &q_1, const LanePoint<V> &r_1,
+            const LanePoint<V> &p_2) noexcept {
+    const V pq_x = q_1.x - p_1.x, pq_y = q_1.y - p_1.y, pq_z = q_1.z - p_1.z;
+    const V pr_x = r_1.x - p_1.x, pr_y = r_1.y - p_1.y, pr_z = r_1.z - p_1.z;
+    const V pp_x = p_2.x - p_1.x, pp_y = p_2.y - p_1.y, pp_z = p_2.z - p_1.z;
+
+    const V n_x = pq_y * pr_z - pq_z * pr_y;
+    const V n_y = pq_z * pr_x - pq_x * pr_z;
+    const V n_z = pq_x * pr_y - pq_y * pr_x;
+
+    return n_x * pp_x + n_y * pp_y + n_z * pp_z;
+}
+
+// error bound of orient_3d for the exact predicate filter, see predicates::orient_3d_adaptive
+template <typename V>
+V orient_3d_error(const LanePoint<V> &p_1, const LanePoint<V> &q_1, const LanePoint<V> &r_1,
+                  const LanePoint<V> &p_2) noexcept {
+    const V pq_x = q_1.x - p_1.x, pq_y = q_1.y - p_1.y, pq_z = q_1.z - p_1.z;
+    const V pr_x = r_1.x - p_1.x, pr_y = r_1.y - p_1.y, pr_z = r_1.z - p_1.z;
+    const V pp_x = p_2.x - p_1.x, pp_y = p_2.y - p_1.y, pp_z = p_2.z - p_1.z;
+
+    const V permanent = (abs(pq_y * pr_z) + abs(pq_z * pr_y)) * abs(pp_x) +
+                        (abs(pq_z * pr_x) + abs(pq_x * pr_z)) * abs(pp_y) +
+                        (abs(pq_x * pr_y) + abs(pq_y * pr_x)) * abs(pp_z);
+
+    return V::broadcast(predicates::orient_3d_error_bound<float>) * permanent;
+}
+
+// lanes whose sign is certain: value beyond +-error (exact predicate mode)
+template <typename V> std::uint32_t certain_sign(V value, V error) noexcept {
+    return greater(value, error) | lower(value, V::broadcast(0.0f) - error);
+}
+
+/* ---------- cmp:: predicates of three orientation values as lane masks ---------- */
+struct SignMasks {
+    std::array<std::uint32_t, 3> pozitive; // cmp::pozitive
+    std::array<std::uint32_t, 3> negative; // cmp::negative
+    std::array<std::uint32_t, 3> zero;     // cmp::is_zero
+
+    std::uint32_t all_pozitive() const noexcept { return pozitive[0] & pozitive[1] & pozitive[2]; }
+    std::uint32_t all_negative() const noexcept { return negative[0] & negative[1] & negative[2]; }
+    std::uint32_t all_zero() const noexcept { return zero[0] & zero[1] & zero[2]; }
+
+    // lane-wise triangle::check_common_vertice
+    std::uint32_t common_vertice() const noexcept {
+        auto same_side = [this](std::size_t i, std::size_t j) {
+            return (pozitive[i] & pozitive[j]) | (negative[i] & negative[j]);
+        };
+        return (zero[0] & same_side(1, 2)) | (zero[1] & same_side(0, 2)) |
+               (zero[2] & same_side(0, 1));
+    }
+};
+
+template <typename V> SignMasks classify(const std::array<V, 3> &values) noexcept {
+    const V epsilon = V::broadcast(cmp::precision<float>::epsilon);
+    const V minus_epsilon = V::broadcast(-cmp::precision<float>::epsilon);
+
+    SignMasks masks;
+    for (std::size_t i = 0; i < 3; ++i) {
+        masks.pozitive[i] = greater_or_equal(values[i], epsilon);
+        masks.negative[i] = lower_or_equal(values[i], minus_epsilon);
+        masks.zero[i] = lower(abs(values[i]), epsilon);
+    }
+    return masks;
+}
+
+// Exact predicate mode: only signs beyond the error bound are classified, exact zeros never
+// are. Lanes with an uncertain value are added to `uncertain` for the exact scalar path.
+template <typename V>
+SignMasks classify(const std::array<V, 3> &values, const std::array<V, 3> &errors,
+                   std::uint32_t &uncertain) noexcept {
+    SignMasks masks;
+    for (std::size_t i = 0; i < 3; ++i) {
+        masks.pozitive[i] = greater(values[i], errors[i]);
+        masks.negative[i] = lower(values[i], V::broadcast(0.0f) - errors[i]);
+        masks.zero[i] = 0;
+        uncertain |= ~(masks.pozitive[i] | masks.negative[i]);
+    }
+    return masks;
+}
+
+// lane-wise triangle::canonicalize_triangle: vertex 0 ends up alone on its side of the
+// other plane, and vertices 1 and 2 are swapped when vertex 0 lies on the positive side
+template <typename V>
+std::array<LanePoint<V>, 3> canonicalize(const std::array<LanePoint<V>, 3> &vertices,
+                                         const SignMasks &signs) noexcept {
+    // cmp::non_negative(x) == !cmp::negative(x) and cmp::non_pozitive(x) == !cmp::pozitive(x)
+    const auto &pos = signs.pozitive;
+    const auto &neg = signs.negative;
+
+    const std::uint32_t keep = neg[0] & ~neg[1] & ~neg[2];
+    const std::uint32_t rotate_once = ~neg[0] & ~neg[1] & neg[2];
+    const std::uint32_t rotate_twice = ~neg[0] & neg[1] & ~neg[2];
+    const std::uint32_t done = keep | rotate_once | rotate_twice;
+
+    const std::uint32_t late_once = ~done & ~pos[0] & ~pos[1] & pos[2];
+    const std::uint32_t late_twice = ~done & ~late_once & ~pos[0] & pos[1] & ~pos[2];
+    const std::uint32_t once = rotate_once | late_once;
+    const std::uint32_t twice = rotate_twice | late_twice;
+
+    const std::uint32_t new_first_pozitive =
+        (once & pos[2]) | (twice & pos[1]) | (~once & ~twice & pos[0]);
+    const std::uint32_t swap = ~done & new_first_pozitive;
+
+    // rotate_clockwise once: (2, 0, 1), twice: (1, 2, 0)
+    const auto &[v0, v1, v2] = vertices;
+    LanePoint<V> c0 = select_point(once, v2, select_point(twice, v1, v0));
+    LanePoint<V> c1 = select_point(once, v0, select_point(twice, v2, v1));
+    LanePoint<V> c2 = select_point(once, v1, select_point(twice, v0, v2));
+
+    return {c0, select_point(swap, c2, c1), select_point(swap, c1, c2)};
+}
+
+} // namespace detail
+
+// Vectorized triangle::intersect for Width = V::width pairs. Lanes that are separated by
+// a plane or cross in the general position are decided here; coplanar pairs, pairs with a
+// single vertex in the other plane and degenerate triangles are reported as unresolved.
+// With exact predicates, lanes whose float orientation is within its error bound are too.
+template <typename V>
+PacketResult intersect_packet(const PairPacket<V::width> &packet) noexcept {
+    using detail::LanePoint;
+
+    std::array<LanePoint<V>, 3> first;
+    std::array<LanePoint<V>, 3> second;
+    for (std::size_t i = 0; i < 3; ++i) {
+        first[i] = detail::load_vertex<V>(packet.first, i);
+        second[i] = detail::load_vertex<V>(packet.second, i);
+    }
+
+    // update_sign_orient(first, second) and update_sign_orient(second, first)
+    std::array<V, 3> first_values;
+    std::array<V, 3> second_values;
+    for (std::size_t i = 0; i < 3; ++i) {
+        first_values[i] = detail::orient_3d(second[0], second[1], second[2], first[i]);
+        second_values[i] = detail::orient_3d(first[0], first[1], first[2], second[i]);
+    }
+
+    std::uint32_t uncertain = 0;
+    detail::SignMasks first_signs;
+    detail::SignMasks second_signs;
+    if constexpr (predicates::exact_mode) {
+        std::array<V, 3> first_errors;
+        std::array<V, 3> second_errors;
+        for (std::size_t i = 0; i < 3; ++i) {
+            first_errors[i] = detail::orient_3d_error(second[0], second[1], second[2], first[i]);
+            second_errors[i] = detail::orient_3d_error(first[0], first[1], first[2], second[i]);
+        }
+        first_signs = detail::classify(first_values, first_errors, uncertain);
+        second_signs = detail::classify(second_values, second_errors, uncertain);
+    } else {
+        first_signs = detail::classify(first_values);
+        second_signs = detail::classify(second_values);
+    }
+
+    // check_relative_positions tests the first triangle completely before the second
+    const std::uint32_t first_separated = first_signs.all_pozitive() | first_signs.all_negative();
+    const std::uint32_t first_decided =
+        first_separated | first_signs.all_zero() | first_signs.common_vertice();
+
+    const std::uint32_t second_separated =
+        second_signs.all_pozitive() | second_signs.all_negative();
+    const std::uint32_t second_decided =
+        second_separated | second_signs.all_zero() | second_signs.common_vertice();
+
+    const std::uint32_t vector_lanes = packet.active & ~packet.scalar;
+    const std::uint32_t separated = first_separated | (~first_decided & second_separated);
+    const std::uint32_t crossing = ~first_decided & ~second_decided;
+
+    // check_segments_intersect on the canonical vertex orders
+    const auto main = detail::canonicalize(first, first_signs);
+    const auto ref = detail::canonicalize(second, second_signs);
+
+    const V sign_1 = detail::orient_3d(main[0], main[1], ref[0], ref[1]);
+    const V sign_2 = detail::orient_3d(main[0], main[2], ref[2], ref[0]);
+
+    std::uint32_t overlap;
+    if constexpr (predicates::exact_mode) {
+        const V error_1 = detail::orient_3d_error(main[0], main[1], ref[0], ref[1]);
+        const V error_2 = detail::orient_3d_error(main[0], main[2], ref[2], ref[0]);
+        const V zero = V::broadcast(0.0f);
+
+        uncertain |= crossing & ~(detail::certain_sign(sign_1, error_1) &
+                                  detail::certain_sign(sign_2, error_2));
+        overlap = (greater(sign_1, zero) & greater(sign_2, zero)) |
+                  (lower(sign_1, zero) & lower(sign_2, zero));
+    } else {
+        const V epsilon = V::broadcast(cmp::precision<float>::epsilon);
+        const V minus_epsilon = V::broadcast(-cmp::precision<float>::epsilon);
+
+        overlap = (greater(sign_1, minus_epsilon) & greater(sign_2, minus_epsilon)) |
+                  (lower(sign_1, epsilon) & lower(sign_2, epsilon));
+    }
+
+    const std::uint32_t resolved = vector_lanes & (separated | crossing) & ~uncertain;
+    return {vector_lanes & crossing & overlap, packet.active & ~resolved};
+}
+
+template <std::floating_point T>
+inline constexpr bool has_intersect_packet = std::same_as<T, float> && simd::has_native<T>;
+
+namespace detail {
+
+// the three vertices of triangle i of a triangle_columns container
+template <std::floating_point T, triangle_columns Triangles>
+std::array<Point<T>, 3> get_vertices(const Triangles &triangles, std::size_t i) noexcept {
+    return {triangles.get_vertex(i, 0), triangles.get_vertex(i, 1), triangles.get_vertex(i, 2)};
+}
+
+// The first test of intersect_triangles: the side of the plane of triangle `ref` all vertices
+// of triangle `base` are strictly on, Sign::pozitive or Sign::negative, and Sign::different if
+// there is none. The values are computed like TrianglePlane::orient; with exact predicates
+// only signs decided by the filter count, anything else gives Sign::different.
+template <std::floating_point T, triangle_columns Triangles>
+Sign separating_side(const Triangles &triangles, std::size_t base, std::size_t ref,
+                     const TrianglePlane<T> &ref_plane) noexcept {
+    const Vector<T> &n = ref_plane.normal;
+    const Point<T> origin = triangles.get_vertex(ref, 0);
+
+    std::array<T, 3> signs;
+    for (std::size_t k = 0; k < 3; ++k) {
+        const Point<T> v = triangles.get_vertex(base, k);
+        const T dx = v.x_ - origin.x_;
+        const T dy = v.y_ - origin.y_;
+        const T dz = v.z_ - origin.z_;
+        const T value = n.x_ * dx + n.y_ * dy + n.z_ * dz;
+
+        if constexpr (predicates::exact_mode) {
+            const auto &magnitude = ref_plane.normal_magnitude;
+            const T permanent = magnitude.x_ * std::abs(dx) + magnitude.y_ * std::abs(dy) +
+                                magnitude.z_ * std::abs(dz);
+            signs[k] = predicates::orient_3d_filter(value, permanent);
+            if (signs[k] == 0)
+                return Sign::different;
+        } else {
+            signs[k] = value;
+        }
+    }
+
+    const SignBits bits(signs);
+    if (bits.pozitive == 0b111)
+        return Sign::pozitive;
+    return bits.negative == 0b111 ? Sign::negative : Sign::different;
+}
+
+template <std::floating_point T, triangle_columns Triangles>
+bool separated_by_plane(const Triangles &triangles, std::size_t base, std::size_t ref,
+                        const TrianglePlane<T> &ref_plane) noexcept {
+    return separating_side(triangles, base, ref, ref_plane) != Sign::different;
+}
+
+// `triangles` is a span of Triangle or a triangle_columns container, indexed by the pair
+// members
+template <std::floating_point T, bool AllTriangles = false, typename Triangles, typename Pair,
+          typename ScalarIntersect, typename OnHit>
+void intersect_pairs(const Triangles &triangles, std::span<const Pair> pairs,
+                     ScalarIntersect &&scalar_intersect, OnHit &&on_hit) {
+    if constexpr (has_intersect_packet<T>) {
+        using V = simd::native_t<T>;
+        PairPacket<V::width> packet;
+
+        for (std::size_t begin = 0; begin < pairs.size(); begin += V::width) {
+            const std::size_t count = std::min(V::width, pairs.size() - begin);
+
+            packet.clear();
+            for (std::size_t lane = 0; lane < count; ++lane) {
+                const Pair &pair = pairs[begin + lane];
+                if constexpr (triangle_columns<Triangles>) {
+                    if constexpr (AllTriangles)
+                        packet.set_triangle_lane(lane, triangles, pair.first, pair.second);
+                    else
+                        packet.set_lane(lane, triangles, pair.first, pair.second);
+                } else if constexpr (AllTriangles) {
+                    packet.set_triangle_lane(lane, triangles[pair.first], triangles[pair.second]);
+                } else {
+                    packet.set_lane(lane, triangles[pair.first], triangles[pair.second]);
+                }
+            }
+
+            const PacketResult result = intersect_packet<V>(packet);
+
+            for (std::size_t lane = 0; lane < count; ++lane) {
+                const std::uint32_t bit = std::uint32_t{1} << lane;
+                const Pair &pair = pairs[begin + lane];
+
+                if ((result.hits & bit) || ((result.unresolved & bit) && scalar_intersect(pair)))
+                    on_hit(pair);
+            }
+        }
+    } else {
+        for (const Pair &pair : pairs) {
+            if (scalar_intersect(pair))
+                on_hit(pair);
+        }
+    }
+}
+
+} // namespace detail
+
+// Runs triangle::intersect on every (first, second) index pair and calls on_hit(pair) for
+// the intersecting ones. Uses the vectorized kernel when the build targets AVX2/AVX-512.
+template <std::floating_point T, typename Pair, typename OnHit>
+void intersect_pairs(std::span<const Triangle<T>> triangles, std::span<const Pair> pairs,
+                     OnHit &&on_hit) {
+    auto scalar_intersect = [triangles](const Pair &pair) {
+        return intersect(triangles[pair.first], triangles[pair.second]);
+    };
+    detail::intersect_pairs<T>(triangles, pairs, scalar_intersect, on_hit);
+}
+
+// Same, with the plane data of every triangle precomputed (planes[i] belongs to triangles[i])
+template <std::floating_point T, typename Pair, typename OnHit>
+void intersect_pairs(std::span<const Triangle<T>> triangles,
+                     std::span<const TrianglePlane<T>> planes, std::span<const Pair> pairs,
+                     OnHit &&on_hit) {
+    auto scalar_intersect = [triangles, planes](const Pair &pair) {
+        return intersect(triangles[pair.first], planes[pair.first], triangles[pair.second],
+                         planes[pair.second]);
+    };
+    detail::intersect_pairs<T>(triangles, pairs, scalar_intersect, on_hit);
+}
+
+// Same, for pairs whose triangles are all of TypeTriangle::triangle: no per-pair type checks
+template <std::floating_point T, typename Pair, typename OnHit>
+void intersect_triangle_pairs(std::span<const Triangle<T>> triangles,
+                              std::span<const TrianglePlane<T>> planes,
+                              std::span<const Pair> pairs, OnHit &&on_hit) {
+    auto scalar_intersect = [triangles, planes](const Pair &pair) {
+        return intersect_triangles(triangles[pair.first], planes[pair.first],
+                                   triangles[pair.second], planes[pair.second]);
+    };
+    detail::intersect_pairs<T, /*AllTriangles=*/true>(triangles, pairs, scalar_intersect, on_hit);
+}
+
+// Same, reading the triangles straight from the columns of a TriangleStore or an IndexedMesh.
+// The scalar path runs intersect_triangles on the vertices of the pair, no Triangle objects
+// are built for it.
+template <std::floating_point T, triangle_columns Triangles, typename Pair, typename OnHit>
+void intersect_triangle_pairs(const Triangles &triangles,
+                              std::span<const TrianglePlane<T>> planes,
+                              std::span<const Pair> pairs, OnHit &&on_hit) {
+    auto scalar_intersect = [&triangles, planes](const Pair &pair) {
+        if (detail::separated_by_plane(triangles, pair.first, pair.second, planes[pair.second]))
+            return false;
+
+        return intersect_triangles(detail::get_vertices<T>(triangles, pair.first),
+                                   planes[pair.first],
+                                   detail::get_vertices<T>(triangles, pair.second),
+                                   planes[pair.second], [](Sign) {});
+    };
+    detail::intersect_pairs<T, /*AllTriangles=*/true>(triangles, pairs, scalar_intersect, on_hit);
+}
+
+} // namespace triangle
+
+#endif // INCLUDE_TRIANGLE_TO_TRIANGLE_BATCH_HPP
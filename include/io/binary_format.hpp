@@ -0,0 +1,286 @@
+#ifndef INCLUDE_IO_BINARY_FORMAT_HPP
+#define INCLUDE_IO_BINARY_FORMAT_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <ostream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "BVH/AABB.hpp"
+#include "common/parallel.hpp"
+#include "common/trace.hpp"
+#include "io/loaded_triangles.hpp"
+#include "primitives/indexed_mesh.hpp"
+#include "primitives/point.hpp"
+#include "primitives/triangle_store.hpp"
+#include "primitives/triangle_view.hpp"
+
+namespace io {
+
+// Binary triangle file, little-endian:
+//   header      32 bytes, BinaryHeader
+//   vertices    vertex_count triples x y z of float32 or float64
+//   indices     soup: none, the vertices of triangle i are 3i, 3i + 1, 3i + 2
+//               indexed: 3 * triangle_count uint32 vertex numbers
+// The id of a triangle is its position in the file, as in the text format.
+
+constexpr std::array<char, 8> binary_magic{'3', 'D', 'T', 'R', 'I', 'B', 'I', 'N'};
+constexpr std::uint32_t binary_version = 1;
+
+enum class BinaryLayout : std::uint8_t { soup = 0, indexed = 1 };
+
+struct BinaryHeader {
+    std::array<char, 8> magic = binary_magic;
+    std::uint32_t version = binary_version;
+    std::uint8_t precision = 4; // bytes per coordinate: 4 or 8
+    BinaryLayout layout = BinaryLayout::soup;
+    std::uint16_t reserved = 0;
+    std::uint64_t triangle_count = 0;
+    std::uint64_t vertex_count = 0;
+};
+static_assert(sizeof(BinaryHeader) == 32 && std::is_trivially_copyable_v<BinaryHeader>);
+
+inline bool is_binary_input(std::string_view data) noexcept {
+    return data.size() >= binary_magic.size() &&
+           std::equal(binary_magic.begin(), binary_magic.end(), data.begin());
+}
+
+/* ---------- a binary file in memory, e.g. a MappedInput ---------- */
+// Checks the header and the size and gives the vertex and index arrays in place
+class BinaryInput {
+  private:
+    BinaryHeader header_;
+    const std::byte *vertices_ = nullptr;
+    const std::byte *indices_ = nullptr;
+
+  public:
+    explicit BinaryInput(std::string_view data) {
+        static_assert(std::endian::native == std::endian::little,
+                      "the binary format is read in place on little-endian hosts only");
+
+        if (data.size() < sizeof(BinaryHeader) || !is_binary_input(data))
+            throw std::runtime_error("Binary input: no header");
+        std::memcpy(&header_, data.data(), sizeof(BinaryHeader));
+
+        if (header_.version != binary_version)
+            throw std::runtime_error("Binary input: unsupported version " +
+                                     std::to_string(header_.version));
+        if (header_.precision != 4 && header_.precision != 8)
+            throw std::runtime_error("Binary input: precision must be 4 or 8 bytes");
+        if (header_.layout != BinaryLayout::soup && header_.layout != BinaryLayout::indexed)
+            throw std::runtime_error("Binary input: unknown layout");
+        if (header_.triangle_count > std::numeric_limits<std::uint32_t>::max() ||
+            header_.vertex_count > std::numeric_limits<std::uint32_t>::max() * std::uint64_t{3})
+            throw std::length_error("Binary input: too many triangles");
+        if (header_.layout == BinaryLayout::soup &&
+            header_.vertex_count != 3 * header_.triangle_count)
+            throw std::runtime_error("Binary input: a soup has three vertices per triangle");
+
+        const std::uint64_t vertex_bytes = header_.vertex_count * 3 * header_.precision;
+        const std::uint64_t index_bytes =
+            header_.layout == BinaryLayout::indexed ? header_.triangle_count * 3 * 4 : 0;
+        if (data.size() - sizeof(BinaryHeader) < vertex_bytes + index_bytes)
+            throw std::runtime_error("Binary input: truncated");
+
+        // mapped files and MappedInput buffers are aligned; a string_view into the middle of
+        // some other buffer may not be
+        if (reinterpret_cast<std::uintptr_t>(data.data()) % header_.precision != 0)
+            throw std::invalid_argument("Binary input: data is not aligned");
+
+        vertices_ = reinterpret_cast<const std::byte *>(data.data()) + sizeof(BinaryHeader);
+        indices_ = vertices_ + vertex_bytes;
+    }
+
+    const BinaryHeader &header() const noexcept { return header_; }
+    std::size_t size() const noexcept { return header_.triangle_count; }
+
+    // the coordinates in place, x y z per vertex; Stored must match the precision
+    template <std::floating_point Stored> std::span<const Stored> coordinates() const {
+        if (sizeof(Stored) != header_.precision)
+            throw std::invalid_argument("Binary input: wrong precision requested");
+        return {reinterpret_cast<const Stored *>(vertices_), 3 * header_.vertex_count};
+    }
+
+    std::span<const std::uint32_t> indices() const noexcept {
+        if (header_.layout != BinaryLayout::indexed)
+            return {};
+        return {reinterpret_cast<const std::uint32_t *>(indices_), 3 * header_.triangle_count};
+    }
+
+    // The triangles of a soup in place, nothing copied; T must match the precision
+    template <std::floating_point T> triangle::TriangleView<T> view() const {
+        if (header_.layout != BinaryLayout::soup)
+            throw std::invalid_argument("Binary input: only a soup can be viewed in place");
+        return triangle::TriangleView<T>(coordinates<T>());
+    }
+
+    // number of vertex k of triangle i
+    std::size_t vertex_number(std::size_t i, std::size_t k) const noexcept {
+        if (header_.layout == BinaryLayout::indexed)
+            return indices()[3 * i + k];
+        return 3 * i + k;
+    }
+
+    // coordinate `axis` of vertex `vertex`, converted to T
+    template <std::floating_point T> T coordinate(std::size_t vertex, std::size_t axis) const {
+        if (header_.precision == 4)
+            return static_cast<T>(coordinates<float>()[3 * vertex + axis]);
+        return static_cast<T>(coordinates<double>()[3 * vertex + axis]);
+    }
+};
+
+// The binary counterpart of parse_text_input: reserve(N), then add(p0, p1, p2, id) for
+// every triangle. Coordinates of the other precision are converted with static_cast.
+template <std::floating_point T, typename Reserve, typename Add>
+void parse_binary_input(std::string_view data, Reserve &&reserve, Add &&add) {
+    const BinaryInput input(data);
+    const std::size_t N = input.size();
+    const std::size_t number_of_vertices = input.header().vertex_count;
+    reserve(N);
+
+    auto point = [&](std::size_t i, std::size_t k) {
+        const std::size_t v = input.vertex_number(i, k);
+        if (v >= number_of_vertices)
+            throw std::runtime_error("Binary input: vertex number out of range in triangle " +
+                                     std::to_string(i));
+        return triangle::Point<T>(input.coordinate<T>(v, 0), input.coordinate<T>(v, 1),
+                                  input.coordinate<T>(v, 2));
+    };
+    for (std::size_t i = 0; i < N; ++i)
+        add(point(i, 0), point(i, 1), point(i, 2), i);
+}
+
+// The store, copied out of the file in parallel into the coordinate columns, and the box
+// of the scene found on the way
+template <std::floating_point T>
+LoadedTriangles<T> read_binary_input(std::string_view data,
+                                     std::size_t number_of_threads =
+                                         std::thread::hardware_concurrency()) {
+    const BinaryInput input(data);
+    const std::size_t N = input.size();
+    const std::size_t number_of_vertices = input.header().vertex_count;
+    number_of_threads = std::max<std::size_t>(number_of_threads, 1);
+
+    std::array<std::vector<T>, 3> columns;
+    for (auto &column : columns)
+        column.resize(3 * N);
+
+    const std::size_t number_of_ranges = (N + triangles_per_task - 1) / triangles_per_task;
+    std::vector<bounding_box::AABB<T>> boxes(number_of_ranges);
+    std::vector<char> failed(number_of_ranges, 0);
+
+    parallel::run_tasks(number_of_ranges, number_of_threads, [&](std::size_t r) {
+        const std::size_t begin = r * triangles_per_task;
+        const std::size_t end = std::min(N, begin + triangles_per_task);
+        const trace::Span span("read binary range", end - begin);
+        bounding_box::AABB<T> box;
+
+        for (std::size_t i = begin; i < end; ++i) {
+            for (std::size_t k = 0; k < 3; ++k) {
+                const std::size_t v = input.vertex_number(i, k);
+                if (v >= number_of_vertices) {
+                    failed[r] = 1;
+                    return;
+                }
+                const triangle::Point<T> p(input.coordinate<T>(v, 0), input.coordinate<T>(v, 1),
+                                           input.coordinate<T>(v, 2));
+                columns[0][3 * i + k] = p.x_;
+                columns[1][3 * i + k] = p.y_;
+                columns[2][3 * i + k] = p.z_;
+                box.wrap_in_box_with(bounding_box::AABB<T>(p, p));
+            }
+        }
+        boxes[r] = box;
+    });
+    if (std::ranges::find(failed, 1) != failed.end())
+        throw std::runtime_error("Binary input: vertex number out of range");
+
+    bounding_box::AABB<T> box;
+    for (const auto &range_box : boxes)
+        box.wrap_in_box_with(range_box);
+    return load_columns(std::move(columns), box, number_of_threads);
+}
+
+namespace detail {
+
+template <typename Value> void write_values(std::ostream &os, std::span<const Value> values) {
+    os.write(reinterpret_cast<const char *>(values.data()),
+             static_cast<std::streamsize>(values.size_bytes()));
+}
+
+// vertices converted to Stored and written in blocks
+template <std::floating_point Stored, typename Vertex>
+void write_vertices(std::ostream &os, std::size_t number_of_vertices, Vertex &&vertex) {
+    constexpr std::size_t block = 4096;
+    std::vector<Stored> values;
+    values.reserve(3 * block);
+
+    for (std::size_t v = 0; v < number_of_vertices; ++v) {
+        const auto point = vertex(v);
+        values.insert(values.end(), {static_cast<Stored>(point.x_),
+                                     static_cast<Stored>(point.y_),
+                                     static_cast<Stored>(point.z_)});
+        if (values.size() == 3 * block) {
+            write_values<Stored>(os, values);
+            values.clear();
+        }
+    }
+    write_values<Stored>(os, values);
+}
+
+inline void write_header(std::ostream &os, const BinaryHeader &header) {
+    os.write(reinterpret_cast<const char *>(&header), sizeof(header));
+}
+
+} // namespace detail
+
+// the triangles of `store` in store order as a soup of Stored coordinates
+template <std::floating_point Stored, std::floating_point T>
+void write_binary(std::ostream &os, const triangle::TriangleStore<T> &store) {
+    BinaryHeader header;
+    header.precision = sizeof(Stored);
+    header.layout = BinaryLayout::soup;
+    header.triangle_count = store.size();
+    header.vertex_count = 3 * store.size();
+
+    detail::write_header(os, header);
+    detail::write_vertices<Stored>(os, 3 * store.size(), [&](std::size_t v) {
+        return store.get_vertex(v / 3, v % 3);
+    });
+    if (!os)
+        throw std::runtime_error("Binary output: write failed");
+}
+
+// the vertex buffer and the index triples of `mesh`
+template <std::floating_point Stored, std::floating_point T>
+void write_binary(std::ostream &os, const triangle::IndexedMesh<T> &mesh) {
+    BinaryHeader header;
+    header.precision = sizeof(Stored);
+    header.layout = BinaryLayout::indexed;
+    header.triangle_count = mesh.size();
+    header.vertex_count = mesh.get_number_of_vertices();
+
+    detail::write_header(os, header);
+    detail::write_vertices<Stored>(os, mesh.get_number_of_vertices(),
+                                   [&](std::size_t v) { return mesh.point(v); });
+    detail::write_values(os, mesh.get_indices());
+    if (!os)
+        throw std::runtime_error("Binary output: write failed");
+}
+
+} // namespace io
+
+#endif // INCLUDE_IO_BINARY_FORMAT_HPP
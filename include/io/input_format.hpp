@@ -0,0 +1,61 @@
+#ifndef INCLUDE_IO_INPUT_FORMAT_HPP
+#define INCLUDE_IO_INPUT_FORMAT_HPP
+
+#include <concepts>
+#include <string_view>
+#include <utility>
+
+#include "io/binary_format.hpp"
+#include "io/obj_input.hpp"
+#include "io/ply_input.hpp"
+#include "io/stl_input.hpp"
+#include "io/text_input.hpp"
+
+namespace io {
+
+enum class InputFormat { text, binary, binary_stl, ascii_stl, obj, ply };
+
+// The format of an input by its content. A binary STL header may start with "solid" like an
+// ASCII one, so its size is checked first; OBJ is recognized by its first statement, and
+// everything else is taken for the text format.
+inline InputFormat detect_input_format(std::string_view data) noexcept {
+    if (is_binary_input(data))
+        return InputFormat::binary;
+    if (is_ply_input(data))
+        return InputFormat::ply;
+    if (is_binary_stl(data))
+        return InputFormat::binary_stl;
+
+    std::string_view word;
+    TextScanner(data).next_word(word);
+    if (word == "solid")
+        return InputFormat::ascii_stl;
+    if (detail::is_obj_keyword(word))
+        return InputFormat::obj;
+    return InputFormat::text;
+}
+
+// Any supported input: calls reserve(N) and then add(p0, p1, p2, id) for every triangle, with
+// ids 0 .. N - 1 in the order of the triangles in the file
+template <std::floating_point T, typename Reserve, typename Add>
+void parse_input(std::string_view data, Reserve &&reserve, Add &&add) {
+    switch (detect_input_format(data)) {
+    case InputFormat::binary:
+        return parse_binary_input<T>(data, std::forward<Reserve>(reserve), std::forward<Add>(add));
+    case InputFormat::binary_stl:
+        return parse_binary_stl<T>(data, std::forward<Reserve>(reserve), std::forward<Add>(add));
+    case InputFormat::ascii_stl:
+        return parse_ascii_stl<T>(data, std::forward<Reserve>(reserve), std::forward<Add>(add));
+    case InputFormat::obj:
+        return parse_obj_input<T>(data, std::forward<Reserve>(reserve), std::forward<Add>(add));
+    case InputFormat::ply:
+        return parse_ply_input<T>(data, std::forward<Reserve>(reserve), std::forward<Add>(add));
+    case InputFormat::text:
+        break;
+    }
+    parse_text_input<T>(data, std::forward<Reserve>(reserve), std::forward<Add>(add));
+}
+
+} // namespace io
+
+#endif // INCLUDE_IO_INPUT_FORMAT_HPP
@@ -0,0 +1,66 @@
+#ifndef INCLUDE_IO_LOADED_TRIANGLES_HPP
+#define INCLUDE_IO_LOADED_TRIANGLES_HPP
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "BVH/AABB.hpp"
+#include "common/parallel.hpp"
+#include "common/trace.hpp"
+#include "primitives/point.hpp"
+#include "primitives/triangle.hpp"
+#include "primitives/triangle_store.hpp"
+
+namespace io {
+
+constexpr std::size_t triangles_per_task = std::size_t{1} << 16;
+
+/* ---------- triangles with the boxes found while loading them ---------- */
+// so the BVH build does not need another pass to get the box of the scene
+template <std::floating_point T> struct LoadedTriangles {
+    triangle::TriangleStore<T> triangles;
+    bounding_box::AABB<T> box; // of all triangles
+};
+
+// The store for coordinate columns filled by a loader (vertex k of triangle i at 3i + k)
+// with `box` already known: types and ids 0 .. N - 1 are computed on `number_of_threads`
+// threads
+template <std::floating_point T>
+LoadedTriangles<T> load_columns(std::array<std::vector<T>, 3> columns,
+                                const bounding_box::AABB<T> &box,
+                                std::size_t number_of_threads) {
+    const std::size_t N = columns[0].size() / 3;
+    std::vector<std::uint32_t> ids(N);
+    std::vector<std::uint8_t> types(N);
+    const std::size_t number_of_ranges = (N + triangles_per_task - 1) / triangles_per_task;
+
+    parallel::run_tasks(number_of_ranges, number_of_threads, [&](std::size_t r) {
+        const std::size_t begin = r * triangles_per_task;
+        const std::size_t end = std::min(N, begin + triangles_per_task);
+        const trace::Span span("classify range", end - begin);
+        const auto &[xs, ys, zs] = columns;
+
+        for (std::size_t i = begin; i < end; ++i) {
+            const std::size_t v = 3 * i;
+            const triangle::Point<T> p_0(xs[v], ys[v], zs[v]);
+            const triangle::Point<T> p_1(xs[v + 1], ys[v + 1], zs[v + 1]);
+            const triangle::Point<T> p_2(xs[v + 2], ys[v + 2], zs[v + 2]);
+
+            ids[i] = static_cast<std::uint32_t>(i);
+            types[i] = static_cast<std::uint8_t>(triangle::classify_triangle(p_0, p_1, p_2));
+        }
+    });
+
+    return {triangle::TriangleStore<T>(std::move(columns[0]), std::move(columns[1]),
+                                       std::move(columns[2]), std::move(ids), std::move(types)),
+            box};
+}
+
+} // namespace io
+
+#endif // INCLUDE_IO_LOADED_TRIANGLES_HPP
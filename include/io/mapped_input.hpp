@@ -0,0 +1,138 @@
+#ifndef INCLUDE_IO_MAPPED_INPUT_HPP
+#define INCLUDE_IO_MAPPED_INPUT_HPP
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace io {
+
+constexpr std::size_t input_block_size = std::size_t{1} << 20;
+
+/* ---------- the whole input as one read-only character range ---------- */
+// A regular file is memory-mapped and never copied. Anything else (a pipe, a terminal) is
+// read in large blocks into a buffer owned by the object.
+class MappedInput {
+  private:
+    const char *data_ = nullptr;
+    std::size_t size_ = 0;
+    void *mapping_ = nullptr;
+    std::unique_ptr<char[]> buffer_;
+
+    static std::system_error last_error(const char *what) {
+        return std::system_error(errno, std::generic_category(), what);
+    }
+
+    void unmap() noexcept {
+        if (mapping_)
+            ::munmap(mapping_, size_);
+        mapping_ = nullptr;
+    }
+
+    void map(int fd, std::size_t size) {
+        if (size == 0)
+            return;
+
+        void *mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping == MAP_FAILED)
+            throw last_error("MappedInput: mmap failed");
+        ::madvise(mapping, size, MADV_SEQUENTIAL);
+
+        mapping_ = mapping;
+        data_ = static_cast<const char *>(mapping);
+        size_ = size;
+    }
+
+    void read_blocks(int fd) {
+        std::size_t capacity = input_block_size;
+        buffer_ = std::make_unique<char[]>(capacity);
+
+        for (;;) {
+            if (size_ == capacity) {
+                auto grown = std::make_unique<char[]>(2 * capacity);
+                std::copy(buffer_.get(), buffer_.get() + size_, grown.get());
+                buffer_ = std::move(grown);
+                capacity *= 2;
+            }
+
+            const ::ssize_t count = ::read(fd, buffer_.get() + size_, capacity - size_);
+            if (count == 0)
+                break;
+            if (count < 0) {
+                if (errno == EINTR)
+                    continue;
+                throw last_error("MappedInput: read failed");
+            }
+            size_ += static_cast<std::size_t>(count);
+        }
+        data_ = buffer_.get();
+    }
+
+    void load(int fd) {
+        struct ::stat status;
+        if (::fstat(fd, &status) != 0)
+            throw last_error("MappedInput: fstat failed");
+
+        // a file read from stdin may already be partly consumed
+        const ::off_t position = S_ISREG(status.st_mode) ? ::lseek(fd, 0, SEEK_CUR) : -1;
+        if (position == 0)
+            map(fd, static_cast<std::size_t>(status.st_size));
+        else
+            read_blocks(fd);
+    }
+
+  public:
+    // everything that is left to read from `fd`, e.g. STDIN_FILENO; the descriptor stays open
+    explicit MappedInput(int fd) { load(fd); }
+
+    explicit MappedInput(const std::filesystem::path &path) {
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            throw last_error("MappedInput: cannot open input file");
+
+        try {
+            load(fd);
+        } catch (...) {
+            ::close(fd);
+            throw;
+        }
+        ::close(fd);
+    }
+
+    MappedInput(const MappedInput &) = delete;
+    MappedInput &operator=(const MappedInput &) = delete;
+
+    MappedInput(MappedInput &&other) noexcept
+        : data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0)),
+          mapping_(std::exchange(other.mapping_, nullptr)), buffer_(std::move(other.buffer_)) {}
+
+    MappedInput &operator=(MappedInput &&other) noexcept {
+        if (this != &other) {
+            unmap();
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+            mapping_ = std::exchange(other.mapping_, nullptr);
+            buffer_ = std::move(other.buffer_);
+        }
+        return *this;
+    }
+
+    ~MappedInput() { unmap(); }
+
+    std::string_view text() const noexcept { return {data_, size_}; }
+    bool is_mapped() const noexcept { return mapping_ != nullptr; }
+};
+
+} // namespace io
+
+#endif // INCLUDE_IO_MAPPED_INPUT_HPP
@@ -0,0 +1,111 @@
+#ifndef INCLUDE_IO_OBJ_INPUT_HPP
+#define INCLUDE_IO_OBJ_INPUT_HPP
+
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include "io/text_input.hpp"
+#include "primitives/point.hpp"
+
+namespace io {
+
+namespace detail {
+
+// The statements that mark a Wavefront OBJ file, for telling it from the text format
+inline bool is_obj_keyword(std::string_view word) noexcept {
+    for (std::string_view keyword :
+         {"v", "vt", "vn", "vp", "f", "l", "p", "o", "g", "s", "mtllib", "usemtl"})
+        if (word == keyword)
+            return true;
+    return word.starts_with('#');
+}
+
+} // namespace detail
+
+inline bool is_obj_input(std::string_view text) noexcept {
+    std::string_view word;
+    return TextScanner(text).next_word(word) && detail::is_obj_keyword(word);
+}
+
+// Wavefront OBJ: the "v" positions and the "f" faces, other statements are ignored. A face
+// "f a b c d ..." may be any polygon; it is fan-triangulated into (a, b, c), (a, c, d), ...
+// Face corners may be written "i", "i/t", "i//n" or "i/t/n", and negative numbers count back
+// from the last vertex read. Calls reserve(N) and then add(p0, p1, p2, id) with ids 0 .. N - 1
+// in the order of the triangles produced.
+template <std::floating_point T, typename Reserve, typename Add>
+void parse_obj_input(std::string_view text, Reserve &&reserve, Add &&add) {
+    std::vector<triangle::Point<T>> vertices;
+    std::vector<std::uint32_t> corners; // three per triangle
+    std::vector<std::uint32_t> face;
+    std::size_t line_number = 0;
+
+    auto fail = [&](const std::string &what) {
+        throw std::runtime_error("OBJ input: " + what + " on line " +
+                                 std::to_string(line_number));
+    };
+
+    // vertex number of a face corner, from 0
+    auto corner = [&](std::string_view word) -> std::uint32_t {
+        long long number = 0;
+        const auto [stop, error] = std::from_chars(word.data(), word.data() + word.size(), number);
+        if (error != std::errc() || (stop != word.data() + word.size() && *stop != '/'))
+            fail("malformed face corner");
+
+        const long long index =
+            number < 0 ? static_cast<long long>(vertices.size()) + number : number - 1;
+        if (number == 0 || index < 0 || index > std::numeric_limits<std::uint32_t>::max())
+            fail("face corner out of range");
+        return static_cast<std::uint32_t>(index);
+    };
+
+    while (!text.empty()) {
+        ++line_number;
+        const std::size_t end = text.find('\n');
+        std::string_view line = text.substr(0, end);
+        text = end == std::string_view::npos ? std::string_view() : text.substr(end + 1);
+        line = line.substr(0, line.find('#'));
+
+        TextScanner scanner(line);
+        std::string_view keyword;
+        if (!scanner.next_word(keyword))
+            continue;
+
+        if (keyword == "v") {
+            T x, y, z;
+            if (!scanner.next(x) || !scanner.next(y) || !scanner.next(z))
+                fail("malformed vertex");
+            vertices.emplace_back(x, y, z);
+        } else if (keyword == "f") {
+            face.clear();
+            for (std::string_view word; scanner.next_word(word);)
+                face.push_back(corner(word));
+            if (face.size() < 3)
+                fail("a face needs three vertices");
+            for (std::size_t k = 1; k + 1 < face.size(); ++k)
+                corners.insert(corners.end(), {face[0], face[k], face[k + 1]});
+        }
+    }
+
+    for (const std::uint32_t v : corners)
+        if (v >= vertices.size())
+            throw std::runtime_error("OBJ input: face refers to vertex " + std::to_string(v + 1) +
+                                     " of " + std::to_string(vertices.size()));
+
+    const std::size_t N = corners.size() / 3;
+    reserve(N);
+    for (std::size_t i = 0; i < N; ++i)
+        add(vertices[corners[3 * i]], vertices[corners[3 * i + 1]], vertices[corners[3 * i + 2]],
+            i);
+}
+
+} // namespace io
+
+#endif // INCLUDE_IO_OBJ_INPUT_HPP
@@ -0,0 +1,169 @@
+#ifndef INCLUDE_IO_OVERLAPPED_INPUT_HPP
+#define INCLUDE_IO_OVERLAPPED_INPUT_HPP
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "BVH/AABB.hpp"
+#include "BVH/build_arrays.hpp"
+#include "BVH/candidate_pairs.hpp"
+#include "common/stage_timings.hpp"
+#include "common/trace.hpp"
+#include "io/loaded_triangles.hpp"
+#include "io/streaming_text_input.hpp"
+#include "primitives/point.hpp"
+#include "primitives/triangle.hpp"
+#include "primitives/triangle_store.hpp"
+
+namespace io {
+
+constexpr std::size_t default_block_queue_capacity = 16;
+
+// the triangles with everything the BVH build needs from them computed ahead
+template <std::floating_point T> struct PreparedTriangles {
+    LoadedTriangles<T> loaded;
+    bin_tree::BuildArrays<T> arrays;
+};
+
+namespace detail {
+
+// appends a block to the store columns and computes its types, boxes and centers
+template <std::floating_point T> class BlockPreparer {
+  private:
+    std::array<std::vector<T>, 3> columns_;
+    std::vector<std::uint32_t> ids_;
+    std::vector<std::uint8_t> types_;
+    PreparedTriangles<T> prepared_;
+
+  public:
+    void reserve(std::size_t N) {
+        for (auto &column : columns_)
+            column.reserve(3 * N);
+        ids_.reserve(N);
+        types_.reserve(N);
+        prepared_.arrays.reserve(N);
+    }
+
+    void add(const TriangleBlock<T> &block) {
+        const auto &[xs, ys, zs] = block.columns;
+        for (std::size_t i = 0; i < block.size(); ++i) {
+            const std::size_t v = 3 * i;
+            const triangle::Point<T> p_0(xs[v], ys[v], zs[v]);
+            const triangle::Point<T> p_1(xs[v + 1], ys[v + 1], zs[v + 1]);
+            const triangle::Point<T> p_2(xs[v + 2], ys[v + 2], zs[v + 2]);
+
+            ids_.push_back(static_cast<std::uint32_t>(block.first_id + i));
+            types_.push_back(static_cast<std::uint8_t>(triangle::classify_triangle(p_0, p_1, p_2)));
+
+            const bounding_box::AABB<T> box(
+                triangle::Point<T>(std::min({p_0.x_, p_1.x_, p_2.x_}),
+                                   std::min({p_0.y_, p_1.y_, p_2.y_}),
+                                   std::min({p_0.z_, p_1.z_, p_2.z_})),
+                triangle::Point<T>(std::max({p_0.x_, p_1.x_, p_2.x_}),
+                                   std::max({p_0.y_, p_1.y_, p_2.y_}),
+                                   std::max({p_0.z_, p_1.z_, p_2.z_})));
+            prepared_.arrays.push_back(box);
+            prepared_.loaded.box.wrap_in_box_with(box);
+        }
+        for (std::size_t axis = 0; axis < 3; ++axis)
+            columns_[axis].insert(columns_[axis].end(), block.columns[axis].begin(),
+                                  block.columns[axis].end());
+    }
+
+    PreparedTriangles<T> finish() && {
+        prepared_.loaded.triangles = triangle::TriangleStore<T>(
+            std::move(columns_[0]), std::move(columns_[1]), std::move(columns_[2]),
+            std::move(ids_), std::move(types_));
+        return std::move(prepared_);
+    }
+};
+
+} // namespace detail
+
+/* ---------- loading overlapped with the per-triangle work of the build ---------- */
+// The text format is read from `fd` and parsed on the calling thread while a second thread
+// takes the parsed blocks from a bounded queue and turns them into the store, the boxes of
+// the scene and the boxes and centers of the BVH build. When the input ends, only the
+// partition of the tree is left to do. "load" (read and parse), "prepare" (the busy time of
+// the second thread) and "load + prepare" (the wall time of both) go to `timings`.
+// Parsing is the slower side, so the queue rarely fills. This pays off when the input comes
+// through a pipe; a file is read faster mapped and parsed on all cores by load_input.
+template <std::floating_point T>
+PreparedTriangles<T> load_overlapped(int fd, timing::StageTimings &timings,
+                                     std::size_t block_size = triangles_per_block,
+                                     std::size_t queue_capacity = default_block_queue_capacity) {
+    const auto start = timing::Clock::now();
+
+    bin_tree::BoundedQueue<TriangleBlock<T>> queue(queue_capacity);
+    std::size_t N = 0; // written before the first push, so the consumer may read it after a pop
+    detail::BlockPreparer<T> preparer;
+    std::exception_ptr prepare_error;
+    double prepare_seconds = 0;
+
+    std::jthread prepare([&] {
+        try {
+            bool first = true;
+            while (auto block = queue.pop()) {
+                const trace::Span span("prepare block", block->size());
+                const auto block_start = timing::Clock::now();
+                if (first)
+                    preparer.reserve(N);
+                first = false;
+                preparer.add(*block);
+                prepare_seconds += timing::seconds_since(block_start);
+            }
+        } catch (...) {
+            prepare_error = std::current_exception();
+        }
+        queue.close();
+    });
+
+    double load_seconds = 0;
+    try {
+        const auto load_start = timing::Clock::now();
+        stream_text_input<T>(
+            fd,
+            [&](std::size_t count) {
+                if (count > std::numeric_limits<std::uint32_t>::max())
+                    throw std::length_error("TriangleStore ids are limited to 32 bits");
+                N = count;
+            },
+            [&](TriangleBlock<T> &&block) {
+                const trace::Span span("push block", block.size()); // waits when the queue is full
+                if (!queue.push(std::move(block)))
+                    throw std::runtime_error("load_overlapped: the block consumer stopped");
+            },
+            block_size);
+        load_seconds = timing::seconds_since(load_start);
+    } catch (...) {
+        queue.close();
+        prepare.join();
+        if (prepare_error)
+            std::rethrow_exception(prepare_error);
+        throw;
+    }
+
+    queue.close();
+    prepare.join();
+    if (prepare_error)
+        std::rethrow_exception(prepare_error);
+
+    PreparedTriangles<T> prepared = std::move(preparer).finish();
+    timings.add("load", load_seconds);
+    timings.add("prepare", prepare_seconds);
+    timings.add("load + prepare", timing::seconds_since(start));
+    return prepared;
+}
+
+} // namespace io
+
+#endif // INCLUDE_IO_OVERLAPPED_INPUT_HPP
@@ -0,0 +1,143 @@
+#ifndef INCLUDE_IO_PARALLEL_TEXT_INPUT_HPP
+#define INCLUDE_IO_PARALLEL_TEXT_INPUT_HPP
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "BVH/AABB.hpp"
+#include "common/parallel.hpp"
+#include "common/trace.hpp"
+#include "io/loaded_triangles.hpp"
+#include "io/text_input.hpp"
+#include "primitives/point.hpp"
+
+namespace io {
+
+constexpr std::size_t default_chunk_size = std::size_t{4} << 20; // bytes per parse task
+
+namespace detail {
+
+// number of whitespace separated tokens
+inline std::size_t count_tokens(std::string_view text) noexcept {
+    std::size_t count = 0;
+    bool in_token = false;
+    for (const char c : text) {
+        const bool space = is_space(c);
+        count += !space && !in_token;
+        in_token = !space;
+    }
+    return count;
+}
+
+// consecutive pieces of about `chunk_size` bytes; every piece ends before whitespace or at
+// the end of the text, so no token is split
+inline std::vector<std::string_view> split_on_whitespace(std::string_view text,
+                                                         std::size_t chunk_size) {
+    std::vector<std::string_view> chunks;
+    std::size_t begin = 0;
+    while (begin < text.size()) {
+        std::size_t end = std::min(text.size(), begin + std::max<std::size_t>(chunk_size, 1));
+        while (end < text.size() && !is_space(text[end]))
+            ++end;
+        chunks.push_back(text.substr(begin, end - begin));
+        begin = end;
+    }
+    return chunks;
+}
+
+// the error parse_text_input reports for `text`
+template <std::floating_point T> [[noreturn]] void throw_input_error(std::string_view text) {
+    parse_text_input<T>(
+        text, [](std::size_t) {},
+        [](const triangle::Point<T> &, const triangle::Point<T> &, const triangle::Point<T> &,
+           std::size_t) {});
+    throw std::runtime_error("Failed to read triangle coordinates");
+}
+
+} // namespace detail
+
+/* ---------- text input parsed on several threads ---------- */
+// parse_text_input on `number_of_threads` threads. The text after the triangle count is cut
+// into chunks on whitespace; the numbers of every chunk are counted, and a prefix sum of the
+// counts gives the index of its first number, hence the triangle, vertex and coordinate
+// each number belongs to. The ids are the same as with the sequential reader, and so are
+// the errors: on malformed input the text is parsed again by parse_text_input.
+template <std::floating_point T>
+LoadedTriangles<T> parse_text_input_parallel(
+    std::string_view text, std::size_t number_of_threads = std::thread::hardware_concurrency(),
+    std::size_t chunk_size = default_chunk_size) {
+    number_of_threads = std::max<std::size_t>(number_of_threads, 1);
+
+    TextScanner header(text);
+    std::size_t N;
+    if (!header.next(N))
+        throw std::runtime_error("Failed to read number of triangles.");
+    if (N > std::numeric_limits<std::uint32_t>::max())
+        throw std::length_error("TriangleStore ids are limited to 32 bits");
+
+    const std::vector<std::string_view> chunks =
+        detail::split_on_whitespace(text.substr(header.offset()), chunk_size);
+
+    // first number of every chunk
+    std::vector<std::size_t> first(chunks.size() + 1, 0);
+    parallel::run_tasks(chunks.size(), number_of_threads, [&](std::size_t c) {
+        const trace::Span span("count chunk", chunks[c].size());
+        first[c + 1] = detail::count_tokens(chunks[c]);
+    });
+    for (std::size_t c = 0; c < chunks.size(); ++c)
+        first[c + 1] += first[c];
+
+    const std::size_t number_of_values = 9 * N;
+    if (first.back() < number_of_values)
+        detail::throw_input_error<T>(text);
+
+    std::array<std::vector<T>, 3> columns; // x, y, z of vertex 3i + k
+    for (auto &column : columns)
+        column.resize(3 * N);
+
+    std::vector<bounding_box::AABB<T>> chunk_boxes(chunks.size());
+    std::vector<char> chunk_failed(chunks.size(), 0);
+    parallel::run_tasks(chunks.size(), number_of_threads, [&](std::size_t c) {
+        const trace::Span span("parse chunk", chunks[c].size());
+        TextScanner scanner(chunks[c]);
+        std::array<T, 3> low{chunk_boxes[c].p_min.x_, chunk_boxes[c].p_min.y_,
+                             chunk_boxes[c].p_min.z_};
+        std::array<T, 3> high{chunk_boxes[c].p_max.x_, chunk_boxes[c].p_max.y_,
+                              chunk_boxes[c].p_max.z_};
+
+        const std::size_t last = std::min(first[c + 1], number_of_values);
+        for (std::size_t number = first[c]; number < last; ++number) {
+            T value;
+            if (!scanner.next(value)) {
+                chunk_failed[c] = 1;
+                return;
+            }
+            const std::size_t axis = number % 3;
+            columns[axis][number / 3] = value;
+            low[axis] = std::min(low[axis], value);
+            high[axis] = std::max(high[axis], value);
+        }
+        chunk_boxes[c] = bounding_box::AABB<T>(triangle::Point<T>(low[0], low[1], low[2]),
+                                               triangle::Point<T>(high[0], high[1], high[2]));
+    });
+    if (std::ranges::find(chunk_failed, 1) != chunk_failed.end())
+        detail::throw_input_error<T>(text);
+
+    bounding_box::AABB<T> box;
+    for (const auto &chunk_box : chunk_boxes)
+        box.wrap_in_box_with(chunk_box);
+    return load_columns(std::move(columns), box, number_of_threads);
+}
+
+} // namespace io
+
+#endif // INCLUDE_IO_PARALLEL_TEXT_INPUT_HPP
@@ -0,0 +1,315 @@
+#ifndef INCLUDE_IO_PLY_INPUT_HPP
+#define INCLUDE_IO_PLY_INPUT_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "io/text_input.hpp"
+#include "primitives/point.hpp"
+
+namespace io {
+
+inline bool is_ply_input(std::string_view data) noexcept {
+    return data.starts_with("ply\n") || data.starts_with("ply\r\n");
+}
+
+namespace detail {
+
+enum class PlyType : std::uint8_t { int8, uint8, int16, uint16, int32, uint32, float32, float64 };
+
+inline std::optional<PlyType> ply_type(std::string_view name) noexcept {
+    constexpr std::array<std::pair<std::string_view, PlyType>, 16> names{{
+        {"char", PlyType::int8},     {"int8", PlyType::int8},       {"uchar", PlyType::uint8},
+        {"uint8", PlyType::uint8},   {"short", PlyType::int16},     {"int16", PlyType::int16},
+        {"ushort", PlyType::uint16}, {"uint16", PlyType::uint16},   {"int", PlyType::int32},
+        {"int32", PlyType::int32},   {"uint", PlyType::uint32},     {"uint32", PlyType::uint32},
+        {"float", PlyType::float32}, {"float32", PlyType::float32}, {"double", PlyType::float64},
+        {"float64", PlyType::float64},
+    }};
+    for (const auto &[type_name, type] : names)
+        if (name == type_name)
+            return type;
+    return std::nullopt;
+}
+
+constexpr std::size_t ply_size(PlyType type) noexcept {
+    constexpr std::array<std::size_t, 8> sizes{1, 1, 2, 2, 4, 4, 4, 8};
+    return sizes[static_cast<std::size_t>(type)];
+}
+
+struct PlyProperty {
+    std::string name;
+    PlyType type;
+    std::optional<PlyType> count_type; // set for a list property
+};
+
+struct PlyElement {
+    std::string name;
+    std::uint64_t count = 0;
+    std::vector<PlyProperty> properties;
+
+    std::optional<std::size_t> find(std::string_view property) const noexcept {
+        for (std::size_t p = 0; p < properties.size(); ++p)
+            if (properties[p].name == property)
+                return p;
+        return std::nullopt;
+    }
+};
+
+struct PlyHeader {
+    bool big_endian = false;
+    std::vector<PlyElement> elements;
+    std::size_t body_offset = 0;
+};
+
+inline PlyHeader read_ply_header(std::string_view data) {
+    if (!is_ply_input(data))
+        throw std::runtime_error("PLY input: no header");
+
+    PlyHeader header;
+    bool has_format = false;
+    std::size_t line_begin = 0;
+    while (true) {
+        const std::size_t line_end = data.find('\n', line_begin);
+        if (line_end == std::string_view::npos)
+            throw std::runtime_error("PLY input: no end_header");
+        TextScanner line(data.substr(line_begin, line_end - line_begin));
+        line_begin = line_end + 1;
+
+        std::string_view keyword, word;
+        if (!line.next_word(keyword) || keyword == "ply" || keyword == "comment" ||
+            keyword == "obj_info")
+            continue;
+
+        if (keyword == "end_header")
+            break;
+        if (keyword == "format") {
+            line.next_word(word);
+            if (word == "ascii")
+                throw std::runtime_error("PLY input: only binary PLY is supported");
+            if (word != "binary_little_endian" && word != "binary_big_endian")
+                throw std::runtime_error("PLY input: unknown format " + std::string(word));
+            header.big_endian = word == "binary_big_endian";
+            has_format = true;
+        } else if (keyword == "element") {
+            PlyElement element;
+            if (!line.next_word(word) || !line.next(element.count))
+                throw std::runtime_error("PLY input: malformed element");
+            element.name = word;
+            header.elements.push_back(std::move(element));
+        } else if (keyword == "property") {
+            if (header.elements.empty() || !line.next_word(word))
+                throw std::runtime_error("PLY input: malformed property");
+
+            PlyProperty property;
+            if (word == "list") {
+                std::string_view count_type, item_type;
+                line.next_word(count_type);
+                line.next_word(item_type);
+                property.count_type = ply_type(count_type);
+                const auto type = ply_type(item_type);
+                if (!property.count_type || !type)
+                    throw std::runtime_error("PLY input: unknown list property type");
+                property.type = *type;
+            } else {
+                const auto type = ply_type(word);
+                if (!type)
+                    throw std::runtime_error("PLY input: unknown property type " +
+                                             std::string(word));
+                property.type = *type;
+            }
+            if (!line.next_word(word))
+                throw std::runtime_error("PLY input: property without a name");
+            property.name = word;
+            header.elements.back().properties.push_back(std::move(property));
+        } else {
+            throw std::runtime_error("PLY input: unknown header line " + std::string(keyword));
+        }
+    }
+    if (!has_format)
+        throw std::runtime_error("PLY input: no format");
+
+    header.body_offset = line_begin;
+    return header;
+}
+
+// value of `type` at p, converted to Out; the copy and the byte swap have the size of the
+// type, known at compile time in every branch
+template <typename Out> Out read_ply_value(const char *p, PlyType type, bool swap) noexcept {
+    auto as = [p, swap]<typename Value>(Value value) {
+        std::array<char, sizeof(Value)> bytes;
+        std::memcpy(bytes.data(), p, bytes.size());
+        if (swap)
+            std::reverse(bytes.begin(), bytes.end());
+        std::memcpy(&value, bytes.data(), sizeof(value));
+        return static_cast<Out>(value);
+    };
+    switch (type) {
+    case PlyType::int8:
+        return as(std::int8_t{});
+    case PlyType::uint8:
+        return as(std::uint8_t{});
+    case PlyType::int16:
+        return as(std::int16_t{});
+    case PlyType::uint16:
+        return as(std::uint16_t{});
+    case PlyType::int32:
+        return as(std::int32_t{});
+    case PlyType::uint32:
+        return as(std::uint32_t{});
+    case PlyType::float32:
+        return as(float{});
+    case PlyType::float64:
+        return as(double{});
+    }
+    return Out{};
+}
+
+// Walks the `element.count` records starting at `cursor`, calls list(count, items) for the
+// list property number `target`, and returns the end of the records
+template <typename List>
+const char *walk_ply_records(const PlyElement &element, const char *cursor, const char *end,
+                             bool swap, std::size_t target, List &&list) {
+    auto take = [&](std::size_t bytes) {
+        if (static_cast<std::size_t>(end - cursor) < bytes)
+            throw std::runtime_error("PLY input: truncated " + element.name + " element");
+        const char *p = cursor;
+        cursor += bytes;
+        return p;
+    };
+
+    for (std::uint64_t r = 0; r < element.count; ++r) {
+        for (std::size_t p = 0; p < element.properties.size(); ++p) {
+            const PlyProperty &property = element.properties[p];
+            if (!property.count_type) {
+                take(ply_size(property.type));
+                continue;
+            }
+            const auto count = read_ply_value<std::int64_t>(
+                take(ply_size(*property.count_type)), *property.count_type, swap);
+            if (count < 0)
+                throw std::runtime_error("PLY input: negative list length");
+            const char *items = take(static_cast<std::size_t>(count) * ply_size(property.type));
+            if (p == target)
+                list(static_cast<std::size_t>(count), items);
+        }
+    }
+    return cursor;
+}
+
+} // namespace detail
+
+// Binary PLY, little- or big-endian: the x, y, z properties of the "vertex" element and the
+// "vertex_indices" (or "vertex_index") list of the "face" element; other elements and
+// properties are skipped. Faces are fan-triangulated. Everything is read in place from the
+// mapping: positions are looked up in the vertex records when a face refers to them, so the
+// vertex element is never copied. Calls reserve(N) and then add(p0, p1, p2, id) with ids
+// 0 .. N - 1 in the order of the triangles produced.
+template <std::floating_point T, typename Reserve, typename Add>
+void parse_ply_input(std::string_view data, Reserve &&reserve, Add &&add) {
+    using namespace detail;
+
+    const PlyHeader header = read_ply_header(data);
+    const bool swap = header.big_endian != (std::endian::native == std::endian::big);
+    const char *const end = data.data() + data.size();
+
+    const PlyElement *vertex = nullptr, *face = nullptr;
+    const char *vertex_begin = nullptr, *face_begin = nullptr;
+    std::size_t vertex_stride = 0, face_list = 0;
+    std::array<std::size_t, 3> offsets{};   // of x, y, z in a vertex record
+    std::array<PlyType, 3> coordinate_types{};
+    std::size_t number_of_triangles = 0;
+
+    const char *cursor = data.data() + header.body_offset;
+    for (const PlyElement &element : header.elements) {
+        if (element.name == "vertex" && !vertex) {
+            vertex = &element;
+            for (const PlyProperty &property : element.properties) {
+                if (property.count_type)
+                    throw std::runtime_error("PLY input: list in the vertex element");
+                vertex_stride += ply_size(property.type);
+            }
+            for (std::size_t axis = 0; axis < 3; ++axis) {
+                const auto p = element.find(std::array{"x", "y", "z"}[axis]);
+                if (!p)
+                    throw std::runtime_error("PLY input: vertex without x, y or z");
+                coordinate_types[axis] = element.properties[*p].type;
+                for (std::size_t q = 0; q < *p; ++q)
+                    offsets[axis] += ply_size(element.properties[q].type);
+            }
+            if (static_cast<std::uint64_t>(end - cursor) / std::max<std::size_t>(vertex_stride, 1) <
+                element.count)
+                throw std::runtime_error("PLY input: truncated vertex element");
+            vertex_begin = cursor;
+            cursor += element.count * vertex_stride;
+            continue;
+        }
+
+        std::size_t target = element.properties.size();
+        if (element.name == "face" && !face) {
+            auto list = element.find("vertex_indices");
+            if (!list)
+                list = element.find("vertex_index");
+            if (!list || !element.properties[*list].count_type ||
+                element.properties[*list].type == PlyType::float32 ||
+                element.properties[*list].type == PlyType::float64)
+                throw std::runtime_error("PLY input: face without a vertex_indices list");
+            face = &element;
+            face_begin = cursor;
+            face_list = target = *list;
+        }
+        cursor = walk_ply_records(element, cursor, end, swap, target,
+                                  [&](std::size_t count, const char *) {
+                                      if (count < 3)
+                                          throw std::runtime_error(
+                                              "PLY input: a face needs three vertices");
+                                      number_of_triangles += count - 2;
+                                  });
+    }
+    if (!vertex || !face)
+        throw std::runtime_error("PLY input: no vertex or face element");
+    if (number_of_triangles > std::numeric_limits<std::uint32_t>::max())
+        throw std::length_error("PLY input: too many triangles");
+
+    const std::size_t index_size = ply_size(face->properties[face_list].type);
+    const PlyType index_type = face->properties[face_list].type;
+    auto point = [&](const char *item) {
+        const auto v = read_ply_value<std::int64_t>(item, index_type, swap);
+        if (v < 0 || static_cast<std::uint64_t>(v) >= vertex->count)
+            throw std::runtime_error("PLY input: face refers to vertex " + std::to_string(v) +
+                                     " of " + std::to_string(vertex->count));
+        const char *record = vertex_begin + static_cast<std::size_t>(v) * vertex_stride;
+        return triangle::Point<T>(
+            read_ply_value<T>(record + offsets[0], coordinate_types[0], swap),
+            read_ply_value<T>(record + offsets[1], coordinate_types[1], swap),
+            read_ply_value<T>(record + offsets[2], coordinate_types[2], swap));
+    };
+
+    reserve(number_of_triangles);
+    std::size_t id = 0;
+    walk_ply_records(*face, face_begin, end, swap, face_list,
+                     [&](std::size_t count, const char *items) {
+                         const triangle::Point<T> first = point(items);
+                         triangle::Point<T> previous = point(items + index_size);
+                         for (std::size_t k = 2; k < count; ++k) {
+                             const triangle::Point<T> next = point(items + k * index_size);
+                             add(first, previous, next, id++);
+                             previous = next;
+                         }
+                     });
+}
+
+} // namespace io
+
+#endif // INCLUDE_IO_PLY_INPUT_HPP
@@ -0,0 +1,157 @@
+#ifndef INCLUDE_IO_RESULT_OUTPUT_HPP
+#define INCLUDE_IO_RESULT_OUTPUT_HPP
+
+#include <algorithm>
+#include <bit>
+#include <cerrno>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include <unistd.h>
+
+namespace io {
+
+constexpr std::size_t output_buffer_size = std::size_t{1} << 20;
+
+/* ---------- output collected in a large buffer and written with write(2) ---------- */
+// No stream, no locale: numbers are formatted with std::to_chars. The buffer goes out when it
+// is full and on flush(); the destructor flushes too but cannot report an error, so call
+// flush() to find out whether everything was written.
+class OutputBuffer {
+  private:
+    int fd_;
+    std::unique_ptr<char[]> buffer_;
+    std::size_t capacity_;
+    std::size_t size_ = 0;
+
+  public:
+    explicit OutputBuffer(int fd, std::size_t capacity = output_buffer_size)
+        : fd_(fd), buffer_(std::make_unique<char[]>(std::max<std::size_t>(capacity, 64))),
+          capacity_(std::max<std::size_t>(capacity, 64)) {}
+
+    OutputBuffer(const OutputBuffer &) = delete;
+    OutputBuffer &operator=(const OutputBuffer &) = delete;
+
+    ~OutputBuffer() {
+        try {
+            flush();
+        } catch (...) {
+        }
+    }
+
+    void flush() {
+        std::size_t written = 0;
+        while (written < size_) {
+            const ::ssize_t count = ::write(fd_, buffer_.get() + written, size_ - written);
+            if (count < 0) {
+                if (errno == EINTR)
+                    continue;
+                size_ = 0;
+                throw std::system_error(errno, std::generic_category(),
+                                        "OutputBuffer: write failed");
+            }
+            written += static_cast<std::size_t>(count);
+        }
+        size_ = 0;
+    }
+
+    void append(std::string_view bytes) {
+        while (!bytes.empty()) {
+            if (size_ == capacity_)
+                flush();
+            const std::size_t count = std::min(bytes.size(), capacity_ - size_);
+            std::memcpy(buffer_.get() + size_, bytes.data(), count);
+            size_ += count;
+            bytes.remove_prefix(count);
+        }
+    }
+
+    // the decimal digits of `number` and then `separator`
+    void append_number(std::uint64_t number, char separator = '\n') {
+        if (capacity_ - size_ < std::numeric_limits<std::uint64_t>::digits10 + 2)
+            flush();
+        char *end = std::to_chars(buffer_.get() + size_, buffer_.get() + capacity_, number).ptr;
+        *end++ = separator;
+        size_ = static_cast<std::size_t>(end - buffer_.get());
+    }
+};
+
+/* ---------- the intersecting ids in the formats of the --output option ---------- */
+enum class ResultFormat {
+    text,   // one decimal id per line, ascending
+    uint32, // ascending ids as packed little-endian uint32
+    bitmap  // number_of_triangles bits, bit i (byte i / 8, bit i % 8 from the least
+            // significant one) set if triangle i intersects another
+};
+
+inline ResultFormat parse_result_format(std::string_view name) {
+    if (name == "text")
+        return ResultFormat::text;
+    if (name == "uint32")
+        return ResultFormat::uint32;
+    if (name == "bitmap")
+        return ResultFormat::bitmap;
+    throw std::invalid_argument("Unknown output format: " + std::string(name));
+}
+
+inline void write_ids_text(int fd, const std::set<std::size_t> &ids) {
+    OutputBuffer output(fd);
+    for (const std::size_t id : ids)
+        output.append_number(id);
+    output.flush();
+}
+
+inline void write_ids_uint32(int fd, const std::set<std::size_t> &ids) {
+    static_assert(std::endian::native == std::endian::little,
+                  "ids are written as little-endian uint32 on little-endian hosts only");
+
+    OutputBuffer output(fd);
+    for (const std::size_t id : ids) {
+        if (id > std::numeric_limits<std::uint32_t>::max())
+            throw std::length_error("write_ids_uint32: id does not fit 32 bits");
+        const auto value = static_cast<std::uint32_t>(id);
+        output.append(std::string_view(reinterpret_cast<const char *>(&value), sizeof(value)));
+    }
+    output.flush();
+}
+
+inline void write_ids_bitmap(int fd, const std::set<std::size_t> &ids,
+                             std::size_t number_of_triangles) {
+    std::vector<unsigned char> bits((number_of_triangles + 7) / 8, 0);
+    for (const std::size_t id : ids) {
+        if (id >= number_of_triangles)
+            throw std::out_of_range("write_ids_bitmap: id " + std::to_string(id) +
+                                    " is not below the number of triangles");
+        bits[id / 8] |= static_cast<unsigned char>(1u << (id % 8));
+    }
+
+    OutputBuffer output(fd);
+    output.append(std::string_view(reinterpret_cast<const char *>(bits.data()), bits.size()));
+    output.flush();
+}
+
+inline void write_ids(int fd, const std::set<std::size_t> &ids, ResultFormat format,
+                      std::size_t number_of_triangles) {
+    switch (format) {
+    case ResultFormat::text:
+        return write_ids_text(fd, ids);
+    case ResultFormat::uint32:
+        return write_ids_uint32(fd, ids);
+    case ResultFormat::bitmap:
+        return write_ids_bitmap(fd, ids, number_of_triangles);
+    }
+}
+
+} // namespace io
+
+#endif // INCLUDE_IO_RESULT_OUTPUT_HPP
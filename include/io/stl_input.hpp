@@ -0,0 +1,128 @@
+#ifndef INCLUDE_IO_STL_INPUT_HPP
+#define INCLUDE_IO_STL_INPUT_HPP
+
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "io/text_input.hpp"
+#include "primitives/point.hpp"
+
+namespace io {
+
+constexpr std::size_t stl_header_size = 84; // 80 bytes of anything, uint32 triangle count
+constexpr std::size_t stl_record_size = 50; // normal, 3 vertices as float32, uint16 attribute
+
+// A binary STL file: the triangle count in the header accounts for the size exactly
+inline bool is_binary_stl(std::string_view data) noexcept {
+    if (data.size() < stl_header_size)
+        return false;
+    std::uint32_t count;
+    std::memcpy(&count, data.data() + 80, sizeof(count));
+    return data.size() == stl_header_size + std::uint64_t{count} * stl_record_size;
+}
+
+// Binary STL read straight from the mapping: reserve(N), then add(p0, p1, p2, id) with ids
+// 0 .. N - 1 in file order. The 50 byte records leave the floats unaligned, so the vertices
+// are copied out of every record with memcpy instead of being viewed in place. Normals and
+// attributes are ignored.
+template <std::floating_point T, typename Reserve, typename Add>
+void parse_binary_stl(std::string_view data, Reserve &&reserve, Add &&add) {
+    static_assert(std::endian::native == std::endian::little,
+                  "binary STL is read in place on little-endian hosts only");
+
+    if (data.size() < stl_header_size)
+        throw std::runtime_error("STL input: no header");
+    std::uint32_t count;
+    std::memcpy(&count, data.data() + 80, sizeof(count));
+    if (data.size() - stl_header_size < std::uint64_t{count} * stl_record_size)
+        throw std::runtime_error("STL input: truncated, " + std::to_string(count) +
+                                 " triangles expected");
+    reserve(count);
+
+    const char *record = data.data() + stl_header_size;
+    std::array<float, 9> c;
+    for (std::size_t i = 0; i < count; ++i, record += stl_record_size) {
+        std::memcpy(c.data(), record + 12, sizeof(c));
+        add(triangle::Point<T>(c[0], c[1], c[2]), triangle::Point<T>(c[3], c[4], c[5]),
+            triangle::Point<T>(c[6], c[7], c[8]), i);
+    }
+}
+
+// ASCII STL, any number of solids of the grammar
+//     solid [name]
+//       facet normal nx ny nz
+//         outer loop
+//           vertex x y z    (3 times)
+//         endloop
+//       endfacet
+//     endsolid [name]
+// with the same callbacks as parse_binary_stl. Anything else, or a file without any facet,
+// is an error.
+template <std::floating_point T, typename Reserve, typename Add>
+void parse_ascii_stl(std::string_view text, Reserve &&reserve, Add &&add) {
+    TextScanner scanner(text);
+    std::vector<triangle::Point<T>> vertices;
+    std::string_view word;
+
+    auto fail = [&](const std::string &what) {
+        throw std::runtime_error("STL input: " + what + ", byte " +
+                                 std::to_string(scanner.offset()));
+    };
+    auto expect = [&](std::string_view keyword) {
+        if (!scanner.next_word(word) || word != keyword)
+            fail("\"" + std::string(keyword) + "\" expected");
+    };
+    auto number = [&] {
+        T value;
+        if (!scanner.next(value))
+            fail("malformed number");
+        return value;
+    };
+
+    while (scanner.next_word(word)) {
+        if (word != "solid")
+            fail("\"solid\" expected");
+        scanner.skip_line(); // the name
+
+        while (scanner.next_word(word) && word == "facet") {
+            expect("normal");
+            for (int i = 0; i < 3; ++i)
+                number();
+            expect("outer");
+            expect("loop");
+            for (int i = 0; i < 3; ++i) {
+                expect("vertex");
+                const T x = number();
+                const T y = number();
+                const T z = number();
+                vertices.emplace_back(x, y, z);
+            }
+            expect("endloop");
+            expect("endfacet");
+        }
+        if (word.empty())
+            fail("unterminated solid");
+        if (word != "endsolid")
+            fail("unknown keyword \"" + std::string(word) + "\"");
+        scanner.skip_line();
+    }
+    if (vertices.empty())
+        fail("no facets");
+
+    const std::size_t N = vertices.size() / 3;
+    reserve(N);
+    for (std::size_t i = 0; i < N; ++i)
+        add(vertices[3 * i], vertices[3 * i + 1], vertices[3 * i + 2], i);
+}
+
+} // namespace io
+
+#endif // INCLUDE_IO_STL_INPUT_HPP
@@ -0,0 +1,133 @@
+#ifndef INCLUDE_IO_STREAMING_TEXT_INPUT_HPP
+#define INCLUDE_IO_STREAMING_TEXT_INPUT_HPP
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <concepts>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include <unistd.h>
+
+#include "io/mapped_input.hpp"
+#include "io/text_input.hpp"
+
+namespace io {
+
+constexpr std::size_t triangles_per_block = std::size_t{1} << 14;
+
+/* ---------- consecutive triangles of the input ---------- */
+// vertex k of triangle first_id + i at 3i + k of the coordinate columns
+template <std::floating_point T> struct TriangleBlock {
+    std::size_t first_id = 0;
+    std::array<std::vector<T>, 3> columns;
+
+    std::size_t size() const noexcept { return columns[0].size() / 3; }
+};
+
+// The text format read from `fd` as it arrives, in reads of `read_size` bytes: after the
+// header it calls count(N), then emit(block) with blocks of `block_size` triangles in input
+// order, the last one possibly shorter. Only whole tokens are parsed, the bytes after the
+// last whitespace wait for the next read. Reading stops once N triangles are parsed; the
+// errors are those of parse_text_input, with byte offsets counted from the first byte read.
+template <std::floating_point T, typename Count, typename Emit>
+void stream_text_input(int fd, Count &&count, Emit &&emit,
+                       std::size_t block_size = triangles_per_block,
+                       std::size_t read_size = input_block_size) {
+    block_size = std::max<std::size_t>(block_size, 1);
+    read_size = std::max<std::size_t>(read_size, 1);
+
+    std::vector<char> pending; // bytes not parsed yet
+    std::size_t pending_offset = 0;
+    bool end_of_input = false;
+
+    bool have_count = false;
+    std::size_t N = 0;
+    std::size_t number_of_values = 0; // parsed so far, 9 per triangle
+    TriangleBlock<T> block;
+
+    auto start_block = [&] {
+        block.first_id = number_of_values / 9;
+        const std::size_t size = 3 * std::min(block_size, N - block.first_id);
+        for (auto &column : block.columns) {
+            column.clear();
+            column.reserve(size);
+        }
+    };
+
+    while (!have_count || number_of_values < 9 * N) {
+        if (!end_of_input) {
+            const std::size_t old_size = pending.size();
+            pending.resize(old_size + read_size);
+            const ::ssize_t bytes = ::read(fd, pending.data() + old_size, read_size);
+            if (bytes < 0) {
+                pending.resize(old_size);
+                if (errno == EINTR)
+                    continue;
+                throw std::system_error(errno, std::generic_category(),
+                                        "stream_text_input: read failed");
+            }
+            pending.resize(old_size + static_cast<std::size_t>(bytes));
+            end_of_input = bytes == 0;
+        }
+
+        // whole tokens only: up to the last whitespace, or everything at the end of the input
+        std::string_view text(pending.data(), pending.size());
+        if (!end_of_input) {
+            const auto last_space = std::find_if(text.rbegin(), text.rend(), is_space);
+            text = text.substr(0, static_cast<std::size_t>(text.rend() - last_space));
+        }
+
+        TextScanner scanner(text);
+        // true if the scanner failed on a token rather than at the end of the text
+        auto malformed = [&] {
+            return end_of_input ||
+                   !std::all_of(text.begin() + scanner.offset(), text.end(), is_space);
+        };
+
+        if (!have_count) {
+            if (!scanner.next(N)) {
+                if (malformed())
+                    throw std::runtime_error("Failed to read number of triangles.");
+                continue;
+            }
+            have_count = true;
+            count(N);
+            start_block();
+        }
+
+        T value;
+        std::size_t parsed = scanner.offset();
+        while (number_of_values < 9 * N) {
+            if (!scanner.next(value)) {
+                if (malformed())
+                    throw std::runtime_error(
+                        "Failed to read triangle coordinates: triangle " +
+                        std::to_string(number_of_values / 9) + ", byte " +
+                        std::to_string(pending_offset + scanner.offset()));
+                break;
+            }
+            parsed = scanner.offset();
+            block.columns[number_of_values % 3].push_back(value);
+
+            if (++number_of_values % (9 * block_size) == 0 || number_of_values == 9 * N) {
+                emit(std::move(block));
+                block = TriangleBlock<T>();
+                if (number_of_values < 9 * N)
+                    start_block();
+            }
+        }
+
+        pending.erase(pending.begin(), pending.begin() + static_cast<std::ptrdiff_t>(parsed));
+        pending_offset += parsed;
+    }
+}
+
+} // namespace io
+
+#endif // INCLUDE_IO_STREAMING_TEXT_INPUT_HPP
@@ -0,0 +1,124 @@
+#ifndef INCLUDE_IO_TEXT_INPUT_HPP
+#define INCLUDE_IO_TEXT_INPUT_HPP
+
+#include <charconv>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdlib>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+#include "primitives/point.hpp"
+
+namespace io {
+
+inline bool is_space(char c) noexcept {
+    return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+namespace detail {
+
+// from_chars reports a number beyond the range of T as out of range both when it overflows and
+// when it underflows. Stream extraction keeps an underflow as 0 or a denormal, so the token is
+// read again with strtold, whose range is wider, and only an overflow is an error.
+template <std::floating_point T>
+std::errc read_out_of_range(const char *first, const char *last, T &value) {
+    const std::string token(first, last);
+    const long double wide = std::strtold(token.c_str(), nullptr);
+    if (!(std::abs(wide) <= std::numeric_limits<T>::max()))
+        return std::errc::result_out_of_range;
+    value = static_cast<T>(wide);
+    return std::errc();
+}
+
+} // namespace detail
+
+/* ---------- whitespace separated numbers read with std::from_chars ---------- */
+// No locale, and no allocation but for numbers out of range. A number must be followed by
+// whitespace or the end of the text. Floating-point numbers are accepted as by stream
+// extraction: a leading '+', an underflow read as 0 or a denormal, and no nan or inf.
+class TextScanner {
+  private:
+    const char *begin_;
+    const char *cursor_;
+    const char *end_;
+
+  public:
+    explicit TextScanner(std::string_view text) noexcept
+        : begin_(text.data()), cursor_(text.data()), end_(text.data() + text.size()) {}
+
+    // false at the end of the text or on a malformed, non-finite or overflowing number
+    template <typename Number> bool next(Number &value) noexcept {
+        while (cursor_ != end_ && is_space(*cursor_))
+            ++cursor_;
+        if (cursor_ != end_ && *cursor_ == '+' && end_ - cursor_ > 1 && *(cursor_ + 1) != '-')
+            ++cursor_;
+
+        auto [stop, error] = std::from_chars(cursor_, end_, value);
+        if constexpr (std::floating_point<Number>) {
+            if (error == std::errc::result_out_of_range)
+                error = detail::read_out_of_range(cursor_, stop, value);
+            if (error == std::errc() && !std::isfinite(value))
+                return false; // nan, inf and infinity, which from_chars accepts
+        }
+        if (error != std::errc() || (stop != end_ && !is_space(*stop)))
+            return false;
+
+        cursor_ = stop;
+        return true;
+    }
+
+    // the next whitespace separated token; false at the end of the text
+    bool next_word(std::string_view &word) noexcept {
+        while (cursor_ != end_ && is_space(*cursor_))
+            ++cursor_;
+        const char *begin = cursor_;
+        while (cursor_ != end_ && !is_space(*cursor_))
+            ++cursor_;
+
+        word = std::string_view(begin, static_cast<std::size_t>(cursor_ - begin));
+        return !word.empty();
+    }
+
+    // moves to the end of the current line, past whatever is left of it
+    void skip_line() noexcept {
+        while (cursor_ != end_ && *cursor_ != '\n')
+            ++cursor_;
+    }
+
+    // bytes consumed so far
+    std::size_t offset() const noexcept { return static_cast<std::size_t>(cursor_ - begin_); }
+};
+
+// The project's text format, "N" followed by 9N coordinates: calls reserve(N) and then
+// add(p0, p1, p2, id) for every triangle, with ids 0 .. N - 1 in input order
+template <std::floating_point T, typename Reserve, typename Add>
+void parse_text_input(std::string_view text, Reserve &&reserve, Add &&add) {
+    TextScanner scanner(text);
+
+    std::size_t N;
+    if (!scanner.next(N))
+        throw std::runtime_error("Failed to read number of triangles.");
+    reserve(N);
+
+    T c[9];
+    for (std::size_t i = 0; i < N; ++i) {
+        for (T &coordinate : c) {
+            if (!scanner.next(coordinate))
+                throw std::runtime_error("Failed to read triangle coordinates: triangle " +
+                                         std::to_string(i) + ", byte " +
+                                         std::to_string(scanner.offset()));
+        }
+
+        add(triangle::Point<T>(c[0], c[1], c[2]), triangle::Point<T>(c[3], c[4], c[5]),
+            triangle::Point<T>(c[6], c[7], c[8]), i);
+    }
+}
+
+} // namespace io
+
+#endif // INCLUDE_IO_TEXT_INPUT_HPP
@@ -0,0 +1,89 @@
+#ifndef INCLUDE_PRIMITIVES_CONTACT_HPP
+#define INCLUDE_PRIMITIVES_CONTACT_HPP
+
+#include <array>
+#include <cstddef>
+#include <ostream>
+#include <span>
+
+#include "point.hpp"
+
+namespace triangle {
+
+// a triangle clipped by the three half-planes of another one has at most six vertices
+constexpr std::size_t max_contact_vertices = 6;
+
+enum class ContactType {
+    none,
+    point,
+    segment,
+    polygon, // coplanar overlap
+};
+
+/* ---------- intersection set of two triangles ---------- */
+template <std::floating_point T> class Contact {
+  private:
+    std::array<Point<T>, max_contact_vertices> vertices_{
+        Point<T>(0, 0, 0), Point<T>(0, 0, 0), Point<T>(0, 0, 0),
+        Point<T>(0, 0, 0), Point<T>(0, 0, 0), Point<T>(0, 0, 0)};
+    std::size_t size_ = 0;
+
+  public:
+    Contact() = default;
+
+    explicit Contact(const Point<T> &point) { push(point); }
+
+    Contact(const Point<T> &start, const Point<T> &end) {
+        push(start);
+        push(end);
+    }
+
+    // coincident neighbours (within cmp precision) are merged, so a touching contact
+    // degenerates to a point or a segment instead of a sliver polygon
+    void push(const Point<T> &point) noexcept {
+        if (size_ > 0 && vertices_[size_ - 1] == point)
+            return;
+        if (size_ == max_contact_vertices)
+            return;
+        vertices_[size_++] = point;
+    }
+
+    // drops a last vertex equal to the first one, closing the polygon
+    void close() noexcept {
+        while (size_ > 1 && vertices_[size_ - 1] == vertices_[0])
+            --size_;
+    }
+
+    void clear() noexcept { size_ = 0; }
+
+    ContactType get_type() const noexcept {
+        switch (size_) {
+        case 0:
+            return ContactType::none;
+        case 1:
+            return ContactType::point;
+        case 2:
+            return ContactType::segment;
+        default:
+            return ContactType::polygon;
+        }
+    }
+
+    bool empty() const noexcept { return size_ == 0; }
+    std::size_t size() const noexcept { return size_; }
+
+    std::span<const Point<T>> get_vertices() const noexcept { return {vertices_.data(), size_}; }
+
+    void print(std::ostream &os) const {
+        os << "contact {";
+        for (const auto &vertex : get_vertices()) {
+            os << "   ";
+            vertex.print(os);
+        }
+        os << '}';
+    }
+};
+
+} // namespace triangle
+
+#endif // INCLUDE_PRIMITIVES_CONTACT_HPP
@@ -0,0 +1,273 @@
+#ifndef INCLUDE_PRIMITIVES_INDEXED_MESH_HPP
+#define INCLUDE_PRIMITIVES_INDEXED_MESH_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "BVH/AABB.hpp"
+#include "common/parallel.hpp"
+#include "point.hpp"
+#include "triangle.hpp"
+#include "triangle_store.hpp"
+
+namespace triangle {
+
+/* ---------- triangles sharing one vertex buffer ---------- */
+// The distinct vertices are kept once in x/y/z columns; triangle i refers to them through
+// the index triple indices[3i], indices[3i + 1], indices[3i + 2]. Ids and types as in
+// TriangleStore.
+template <std::floating_point T> class IndexedMesh {
+  private:
+    std::vector<T> xs_;
+    std::vector<T> ys_;
+    std::vector<T> zs_;
+    std::vector<std::uint32_t> indices_;
+    std::vector<std::uint32_t> ids_;
+    std::vector<std::uint8_t> types_;
+
+  public:
+    void reserve(std::size_t number_of_triangles, std::size_t number_of_vertices) {
+        xs_.reserve(number_of_vertices);
+        ys_.reserve(number_of_vertices);
+        zs_.reserve(number_of_vertices);
+        indices_.reserve(3 * number_of_triangles);
+        ids_.reserve(number_of_triangles);
+        types_.reserve(number_of_triangles);
+    }
+
+    std::uint32_t add_vertex(const Point<T> &point) {
+        if (xs_.size() == std::numeric_limits<std::uint32_t>::max())
+            throw std::length_error("IndexedMesh supports at most 2^32 - 1 vertices");
+
+        xs_.push_back(point.x_);
+        ys_.push_back(point.y_);
+        zs_.push_back(point.z_);
+        return static_cast<std::uint32_t>(xs_.size() - 1);
+    }
+
+    void push_back(std::uint32_t vertex_0, std::uint32_t vertex_1, std::uint32_t vertex_2,
+                   std::size_t id) {
+        if (std::max({vertex_0, vertex_1, vertex_2}) >= xs_.size())
+            throw std::out_of_range("IndexedMesh: vertex index out of range");
+
+        push_back(vertex_0, vertex_1, vertex_2,
+                  classify_triangle(point(vertex_0), point(vertex_1), point(vertex_2)), id);
+    }
+
+    // the type is taken as given, e.g. from the TriangleStore the mesh was welded from
+    void push_back(std::uint32_t vertex_0, std::uint32_t vertex_1, std::uint32_t vertex_2,
+                   TypeTriangle type, std::size_t id) {
+        if (id > std::numeric_limits<std::uint32_t>::max())
+            throw std::length_error("IndexedMesh ids are limited to 32 bits");
+
+        indices_.insert(indices_.end(), {vertex_0, vertex_1, vertex_2});
+        ids_.push_back(static_cast<std::uint32_t>(id));
+        types_.push_back(static_cast<std::uint8_t>(type));
+    }
+
+    std::size_t size() const noexcept { return ids_.size(); }
+    bool empty() const noexcept { return ids_.empty(); }
+    std::size_t get_number_of_vertices() const noexcept { return xs_.size(); }
+
+    // bytes held by the mesh, without spare capacity
+    std::size_t get_memory_size() const noexcept {
+        return 3 * xs_.size() * sizeof(T) +
+               (indices_.size() + ids_.size()) * sizeof(std::uint32_t) + types_.size();
+    }
+
+    std::size_t get_id(std::size_t i) const noexcept { return ids_[i]; }
+
+    TypeTriangle get_type(std::size_t i) const noexcept {
+        return static_cast<TypeTriangle>(types_[i]);
+    }
+
+    // position of vertex k of triangle i in the coordinate columns
+    std::size_t vertex_index(std::size_t i, std::size_t k) const noexcept {
+        return indices_[3 * i + k];
+    }
+
+    Point<T> point(std::size_t vertex) const noexcept {
+        return {xs_[vertex], ys_[vertex], zs_[vertex]};
+    }
+
+    Point<T> get_vertex(std::size_t i, std::size_t k) const noexcept {
+        return point(vertex_index(i, k));
+    }
+
+    std::array<Point<T>, 3> get_vertices(std::size_t i) const noexcept {
+        return {get_vertex(i, 0), get_vertex(i, 1), get_vertex(i, 2)};
+    }
+
+    bounding_box::AABB<T> get_box(std::size_t i) const noexcept {
+        const std::size_t a = vertex_index(i, 0), b = vertex_index(i, 1), c = vertex_index(i, 2);
+        return bounding_box::AABB<T>(
+            Point<T>(std::min({xs_[a], xs_[b], xs_[c]}), std::min({ys_[a], ys_[b], ys_[c]}),
+                     std::min({zs_[a], zs_[b], zs_[c]})),
+            Point<T>(std::max({xs_[a], xs_[b], xs_[c]}), std::max({ys_[a], ys_[b], ys_[c]}),
+                     std::max({zs_[a], zs_[b], zs_[c]})));
+    }
+
+    // coordinate `axis` of the box center, as AABB::get_center computes it
+    T get_center(std::size_t i, std::size_t axis) const noexcept {
+        const std::vector<T> &c = axis == 0 ? xs_ : (axis == 1 ? ys_ : zs_);
+        const T c_0 = c[vertex_index(i, 0)], c_1 = c[vertex_index(i, 1)],
+                c_2 = c[vertex_index(i, 2)];
+        return (std::max({c_0, c_1, c_2}) + std::min({c_0, c_1, c_2})) / 2;
+    }
+
+    Triangle<T> get_triangle(std::size_t i) const {
+        return Triangle<T>(get_vertex(i, 0), get_vertex(i, 1), get_vertex(i, 2), get_type(i),
+                           get_id(i));
+    }
+
+    // coordinate columns, one entry per distinct vertex
+    std::span<const T> get_xs() const noexcept { return xs_; }
+    std::span<const T> get_ys() const noexcept { return ys_; }
+    std::span<const T> get_zs() const noexcept { return zs_; }
+
+    std::span<const std::uint32_t> get_indices() const noexcept { return indices_; }
+
+    // triangle i moves to position j for order[j] == i; the vertex buffer stays as it is
+    void permute(std::span<const std::uint32_t> order) {
+        if (order.size() != size())
+            throw std::invalid_argument("IndexedMesh::permute: wrong permutation size");
+
+        std::vector<std::uint32_t> indices;
+        std::vector<std::uint32_t> ids;
+        std::vector<std::uint8_t> types;
+        indices.reserve(indices_.size());
+        ids.reserve(ids_.size());
+        types.reserve(types_.size());
+
+        for (const std::uint32_t i : order) {
+            indices.insert(indices.end(), {indices_[3 * i], indices_[3 * i + 1],
+                                           indices_[3 * i + 2]});
+            ids.push_back(ids_[i]);
+            types.push_back(types_[i]);
+        }
+        indices_ = std::move(indices);
+        ids_ = std::move(ids);
+        types_ = std::move(types);
+    }
+};
+
+namespace detail {
+
+// bit pattern of the three coordinates: welding joins bitwise identical vertices only, so
+// the welded mesh has exactly the geometry of the soup
+template <std::floating_point T> struct VertexKey {
+    using Bits = std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t>;
+    std::array<Bits, 3> bits;
+
+    VertexKey(T x, T y, T z)
+        : bits{std::bit_cast<Bits>(x), std::bit_cast<Bits>(y), std::bit_cast<Bits>(z)} {}
+
+    bool operator==(const VertexKey &) const = default;
+
+    std::size_t hash() const noexcept {
+        std::uint64_t h = 0x9e3779b97f4a7c15ull;
+        for (const Bits b : bits)
+            h = (h ^ b) * 0xff51afd7ed558ccdull;
+        return static_cast<std::size_t>(h ^ (h >> 32));
+    }
+};
+
+template <std::floating_point T> struct VertexKeyHash {
+    std::size_t operator()(const VertexKey<T> &key) const noexcept { return key.hash(); }
+};
+
+} // namespace detail
+
+// Joins the bitwise identical vertices of a triangle soup into one shared vertex buffer.
+// The soup vertices are hashed and scattered into shards in parallel, every shard is welded
+// by one task, and a last serial pass numbers the distinct vertices in order of their first
+// occurrence, so the mesh is the same for any number of threads.
+template <std::floating_point T>
+IndexedMesh<T> weld_vertices(const TriangleStore<T> &soup,
+                             std::size_t number_of_threads = std::thread::hardware_concurrency()) {
+    const std::size_t number_of_vertices = 3 * soup.size();
+    if (number_of_vertices > std::numeric_limits<std::uint32_t>::max())
+        throw std::length_error("weld_vertices supports at most 2^32 - 1 soup vertices");
+
+    number_of_threads = std::max<std::size_t>(number_of_threads, 1);
+    const std::size_t number_of_shards = 4 * std::bit_ceil(number_of_threads);
+    const std::size_t number_of_chunks = std::min(number_of_threads, number_of_vertices + 1);
+    const std::size_t chunk_size = (number_of_vertices + number_of_chunks - 1) / number_of_chunks;
+
+    const auto xs = soup.get_xs();
+    const auto ys = soup.get_ys();
+    const auto zs = soup.get_zs();
+    auto key = [&](std::size_t v) { return detail::VertexKey<T>(xs[v], ys[v], zs[v]); };
+    auto shard_of = [&](std::size_t v) { return key(v).hash() & (number_of_shards - 1); };
+
+    // vertices per (shard, chunk), then the start of every (shard, chunk) range
+    std::vector<std::uint32_t> offsets(number_of_shards * number_of_chunks + 1, 0);
+    parallel::run_tasks(number_of_chunks, number_of_threads, [&](std::size_t chunk) {
+        const std::size_t end = std::min(number_of_vertices, (chunk + 1) * chunk_size);
+        for (std::size_t v = chunk * chunk_size; v < end; ++v)
+            ++offsets[shard_of(v) * number_of_chunks + chunk + 1];
+    });
+    for (std::size_t i = 1; i < offsets.size(); ++i)
+        offsets[i] += offsets[i - 1];
+
+    // soup vertices grouped by shard, ascending within every shard
+    std::vector<std::uint32_t> sharded(number_of_vertices);
+    parallel::run_tasks(number_of_chunks, number_of_threads, [&](std::size_t chunk) {
+        std::vector<std::uint32_t> next(number_of_shards);
+        for (std::size_t shard = 0; shard < number_of_shards; ++shard)
+            next[shard] = offsets[shard * number_of_chunks + chunk];
+
+        const std::size_t end = std::min(number_of_vertices, (chunk + 1) * chunk_size);
+        for (std::size_t v = chunk * chunk_size; v < end; ++v)
+            sharded[next[shard_of(v)]++] = static_cast<std::uint32_t>(v);
+    });
+
+    // first soup vertex with the same position
+    std::vector<std::uint32_t> representative(number_of_vertices);
+    parallel::run_tasks(number_of_shards, number_of_threads, [&](std::size_t shard) {
+        const std::uint32_t begin = offsets[shard * number_of_chunks];
+        const std::uint32_t end = offsets[(shard + 1) * number_of_chunks];
+
+        std::unordered_map<detail::VertexKey<T>, std::uint32_t, detail::VertexKeyHash<T>> first;
+        first.reserve(end - begin);
+        for (std::uint32_t k = begin; k < end; ++k) {
+            const std::uint32_t v = sharded[k];
+            representative[v] = first.try_emplace(key(v), v).first->second;
+        }
+    });
+    std::vector<std::uint32_t>().swap(sharded);
+
+    // a representative precedes its copies, so its mesh index is known when they come
+    IndexedMesh<T> mesh;
+    std::size_t number_of_distinct = 0;
+    for (std::size_t v = 0; v < number_of_vertices; ++v)
+        number_of_distinct += representative[v] == v;
+    mesh.reserve(soup.size(), number_of_distinct);
+
+    std::vector<std::uint32_t> &index = representative;
+    for (std::size_t v = 0; v < number_of_vertices; ++v) {
+        if (index[v] == v)
+            index[v] = mesh.add_vertex(Point<T>(xs[v], ys[v], zs[v]));
+        else
+            index[v] = index[index[v]];
+    }
+
+    for (std::size_t i = 0; i < soup.size(); ++i)
+        mesh.push_back(index[3 * i], index[3 * i + 1], index[3 * i + 2], soup.get_type(i),
+                       soup.get_id(i));
+    return mesh;
+}
+
+} // namespace triangle
+
+#endif // INCLUDE_PRIMITIVES_INDEXED_MESH_HPP
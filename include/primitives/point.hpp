@@ -3,15 +3,23 @@
 
 #include <cmath>
 #include <ostream>
+#include <type_traits>
+#include <variant>
 
 #include "common/cmp.hpp"
+#include "common/simd.hpp"
 
 namespace triangle {
 
-template <std::floating_point T> struct Point {
+// fourth lane of a point or vector in the xyz0 layout (simd::has_xyz0), nothing otherwise
+template <std::floating_point T>
+using PaddingLane = std::conditional_t<simd::has_xyz0<T>, T, std::monostate>;
+
+template <std::floating_point T> struct alignas(simd::has_xyz0<T> ? 16 : alignof(T)) Point {
     T x_;
     T y_;
     T z_;
+    [[no_unique_address]] PaddingLane<T> w_{}; // always 0
 
     Point(T x, T y, T z) : x_(x), y_(y), z_(z) {}
 
@@ -31,6 +31,18 @@ inline bool are_collinear(const Point<T> &point_0, const Point<T> &point_1,
     return cross.is_nul();
 }
 
+template <std::floating_point T>
+TypeTriangle classify_triangle(const Point<T> &point_0, const Point<T> &point_1,
+                               const Point<T> &point_2) {
+    if (point_0 == point_1 && point_1 == point_2)
+        return TypeTriangle::point;
+
+    if (are_collinear(point_0, point_1, point_2))
+        return TypeTriangle::interval;
+
+    return TypeTriangle::triangle;
+}
+
 template <std::floating_point T> class Triangle {
   private:
     using VerticesT = std::array<Point<T>, 3>;
@@ -41,22 +53,21 @@ template <std::floating_point T> class Triangle {
     std::size_t id_;
 
   public:
+    // with the type already known, e.g. when taken out of a TriangleStore
     Triangle(const Point<T> &point_0, const Point<T> &point_1, const Point<T> &point_2,
-             std::size_t id)
-        : vertices_{point_0, point_1, point_2},
+             TypeTriangle type, std::size_t id)
+        : vertices_{point_0, point_1, point_2}, type_(type),
           box_(Point(std::min({vertices_[0].x_, vertices_[1].x_, vertices_[2].x_}),
                      std::min({vertices_[0].y_, vertices_[1].y_, vertices_[2].y_}),
                      std::min({vertices_[0].z_, vertices_[1].z_, vertices_[2].z_})),
                Point(std::max({vertices_[0].x_, vertices_[1].x_, vertices_[2].x_}),
                      std::max({vertices_[0].y_, vertices_[1].y_, vertices_[2].y_}),
                      std::max({vertices_[0].z_, vertices_[1].z_, vertices_[2].z_}))),
-          id_(id) {
-        if (point_0 == point_1 && point_1 == point_2)
-            type_ = TypeTriangle::point;
+          id_(id) {}
 
-        else if (are_collinear(point_0, point_1, point_2))
-            type_ = TypeTriangle::interval;
-    }
+    Triangle(const Point<T> &point_0, const Point<T> &point_1, const Point<T> &point_2,
+             std::size_t id)
+        : Triangle(point_0, point_1, point_2, classify_triangle(point_0, point_1, point_2), id) {}
 
     Triangle(const Point<T> &point_0, const Point<T> &point_1, const Point<T> &point_2)
         : Triangle(point_0, point_1, point_2, 0) {}
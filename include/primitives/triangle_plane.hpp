@@ -0,0 +1,89 @@
+#ifndef INCLUDE_TRIANGLE_PLANE_HPP
+#define INCLUDE_TRIANGLE_PLANE_HPP
+
+#include <array>
+#include <cmath>
+#include <type_traits>
+#include <variant>
+
+#include "common/cmp.hpp"
+#include "common/predicates.hpp"
+#include "point.hpp"
+#include "triangle.hpp"
+#include "vector.hpp"
+
+namespace triangle {
+
+/* ---------- plane and edge data of a triangle, computed once ---------- */
+template <std::floating_point T> struct TrianglePlane {
+    Vector<T> edge_1; // v0 -> v1
+    Vector<T> edge_2; // v0 -> v2
+    Vector<T> normal; // edge_1 x edge_2, not normalized
+
+    // |products| of every normal component, the part of the orient_3d permanent that does
+    // not depend on the point; only stored with exact predicates
+    using NormalMagnitude =
+        std::conditional_t<predicates::exact_mode, Vector<T>, std::monostate>;
+    [[no_unique_address]] NormalMagnitude normal_magnitude;
+
+    explicit TrianglePlane(const Triangle<T> &triangle)
+        : edge_1(triangle.get_vertices()[0], triangle.get_vertices()[1]),
+          edge_2(triangle.get_vertices()[0], triangle.get_vertices()[2]),
+          normal(vector_product(edge_1, edge_2)),
+          normal_magnitude(make_normal_magnitude(edge_1, edge_2)) {}
+
+    static NormalMagnitude make_normal_magnitude(const Vector<T> &e_1, const Vector<T> &e_2) {
+        if constexpr (predicates::exact_mode) {
+            return {std::abs(e_1.y_ * e_2.z_) + std::abs(e_1.z_ * e_2.y_),
+                    std::abs(e_1.z_ * e_2.x_) + std::abs(e_1.x_ * e_2.z_),
+                    std::abs(e_1.x_ * e_2.y_) + std::abs(e_1.y_ * e_2.x_)};
+        } else {
+            return {};
+        }
+    }
+
+    // orient_3d(v0, v1, v2, point) of the triangle the plane was built from, with one dot
+    // product. The origin-relative form rounds exactly like orient_3d, unlike n * point - d,
+    // so the epsilon classification does not change. In exact predicate mode the same value
+    // is only the filter, and the sign is returned as -1, 0 or 1.
+    T orient(const Triangle<T> &triangle, const Point<T> &point) const noexcept {
+        return orient(triangle.get_vertices(), point);
+    }
+
+    // same, given the vertices of the triangle
+    T orient(const std::array<Point<T>, 3> &vertices, const Point<T> &point) const noexcept {
+        if constexpr (predicates::exact_mode) {
+            const T sign = orient_filtered(vertices, point);
+            if (sign != 0)
+                return sign;
+
+            return static_cast<T>(
+                predicates::orient_3d_exact(vertices[0], vertices[1], vertices[2], point));
+        } else {
+            return scalar_product(normal, Vector<T>(vertices[0], point));
+        }
+    }
+
+    // exact predicate mode: -1 or 1 when the filter decides the sign, 0 if it is uncertain
+    T orient_filtered(const Triangle<T> &triangle, const Point<T> &point) const noexcept
+        requires predicates::exact_mode
+    {
+        return orient_filtered(triangle.get_vertices(), point);
+    }
+
+    T orient_filtered(const std::array<Point<T>, 3> &vertices, const Point<T> &point) const noexcept
+        requires predicates::exact_mode
+    {
+        const Vector<T> to_point(vertices[0], point);
+        const T value = scalar_product(normal, to_point);
+        const T permanent = normal_magnitude.x_ * std::abs(to_point.x_) +
+                            normal_magnitude.y_ * std::abs(to_point.y_) +
+                            normal_magnitude.z_ * std::abs(to_point.z_);
+
+        return predicates::orient_3d_filter(value, permanent);
+    }
+};
+
+} // namespace triangle
+
+#endif // INCLUDE_TRIANGLE_PLANE_HPP
@@ -0,0 +1,172 @@
+#ifndef INCLUDE_PRIMITIVES_TRIANGLE_STORE_HPP
+#define INCLUDE_PRIMITIVES_TRIANGLE_STORE_HPP
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "BVH/AABB.hpp"
+#include "point.hpp"
+#include "triangle.hpp"
+
+namespace triangle {
+
+// Triangle containers the BVH is built over, which hand out vertex k of triangle i with
+// get_vertex(i, k): TriangleStore, IndexedMesh and TriangleView
+template <typename Triangles>
+concept triangle_columns = requires(const Triangles &triangles, std::size_t i) {
+    { triangles.get_vertex(i, i) };
+    { triangles.get_type(i) } -> std::same_as<TypeTriangle>;
+    { triangles.get_triangle(i) };
+};
+
+/* ---------- triangles in structure-of-arrays form ---------- */
+// Vertex k of triangle i is (x[3i + k], y[3i + k], z[3i + k]). Next to the coordinates only
+// a 32-bit id and a one-byte TypeTriangle are kept; boxes and centers are computed on demand.
+template <std::floating_point T> class TriangleStore {
+  private:
+    std::vector<T> xs_;
+    std::vector<T> ys_;
+    std::vector<T> zs_;
+    std::vector<std::uint32_t> ids_;
+    std::vector<std::uint8_t> types_;
+
+  public:
+    static constexpr std::size_t bytes_per_triangle =
+        9 * sizeof(T) + sizeof(std::uint32_t) + sizeof(std::uint8_t);
+
+    TriangleStore() = default;
+
+    explicit TriangleStore(const std::vector<Triangle<T>> &triangles) {
+        reserve(triangles.size());
+        for (const auto &tr : triangles) {
+            const auto &v = tr.get_vertices();
+            push_back(v[0], v[1], v[2], tr.get_type(), tr.get_id());
+        }
+    }
+
+    // takes over columns filled elsewhere, e.g. by a parallel loader: 3N coordinates each,
+    // N ids and N types
+    TriangleStore(std::vector<T> xs, std::vector<T> ys, std::vector<T> zs,
+                  std::vector<std::uint32_t> ids, std::vector<std::uint8_t> types)
+        : xs_(std::move(xs)), ys_(std::move(ys)), zs_(std::move(zs)), ids_(std::move(ids)),
+          types_(std::move(types)) {
+        const std::size_t n = ids_.size();
+        if (types_.size() != n || xs_.size() != 3 * n || ys_.size() != 3 * n ||
+            zs_.size() != 3 * n)
+            throw std::invalid_argument("TriangleStore: column sizes do not match");
+    }
+
+    void reserve(std::size_t count) {
+        xs_.reserve(3 * count);
+        ys_.reserve(3 * count);
+        zs_.reserve(3 * count);
+        ids_.reserve(count);
+        types_.reserve(count);
+    }
+
+    void push_back(const Point<T> &point_0, const Point<T> &point_1, const Point<T> &point_2,
+                   std::size_t id) {
+        push_back(point_0, point_1, point_2, classify_triangle(point_0, point_1, point_2), id);
+    }
+
+    void push_back(const Point<T> &point_0, const Point<T> &point_1, const Point<T> &point_2,
+                   TypeTriangle type, std::size_t id) {
+        if (id > std::numeric_limits<std::uint32_t>::max())
+            throw std::length_error("TriangleStore ids are limited to 32 bits");
+
+        for (const Point<T> *point : {&point_0, &point_1, &point_2}) {
+            xs_.push_back(point->x_);
+            ys_.push_back(point->y_);
+            zs_.push_back(point->z_);
+        }
+        ids_.push_back(static_cast<std::uint32_t>(id));
+        types_.push_back(static_cast<std::uint8_t>(type));
+    }
+
+    std::size_t size() const noexcept { return ids_.size(); }
+    bool empty() const noexcept { return ids_.empty(); }
+
+    void clear() noexcept {
+        xs_.clear();
+        ys_.clear();
+        zs_.clear();
+        ids_.clear();
+        types_.clear();
+    }
+
+    std::size_t get_id(std::size_t i) const noexcept { return ids_[i]; }
+
+    TypeTriangle get_type(std::size_t i) const noexcept {
+        return static_cast<TypeTriangle>(types_[i]);
+    }
+
+    // position of vertex k of triangle i in the coordinate columns
+    std::size_t vertex_index(std::size_t i, std::size_t k) const noexcept { return 3 * i + k; }
+
+    Point<T> get_vertex(std::size_t i, std::size_t k) const noexcept {
+        return {xs_[3 * i + k], ys_[3 * i + k], zs_[3 * i + k]};
+    }
+
+    std::array<Point<T>, 3> get_vertices(std::size_t i) const noexcept {
+        return {get_vertex(i, 0), get_vertex(i, 1), get_vertex(i, 2)};
+    }
+
+    bounding_box::AABB<T> get_box(std::size_t i) const noexcept {
+        const std::size_t v = 3 * i;
+        return bounding_box::AABB<T>(
+            Point<T>(std::min({xs_[v], xs_[v + 1], xs_[v + 2]}),
+                     std::min({ys_[v], ys_[v + 1], ys_[v + 2]}),
+                     std::min({zs_[v], zs_[v + 1], zs_[v + 2]})),
+            Point<T>(std::max({xs_[v], xs_[v + 1], xs_[v + 2]}),
+                     std::max({ys_[v], ys_[v + 1], ys_[v + 2]}),
+                     std::max({zs_[v], zs_[v + 1], zs_[v + 2]})));
+    }
+
+    // coordinate `axis` of the box center, as AABB::get_center computes it
+    T get_center(std::size_t i, std::size_t axis) const noexcept {
+        const std::vector<T> &c = axis == 0 ? xs_ : (axis == 1 ? ys_ : zs_);
+        const std::size_t v = 3 * i;
+        return (std::max({c[v], c[v + 1], c[v + 2]}) + std::min({c[v], c[v + 1], c[v + 2]})) / 2;
+    }
+
+    Triangle<T> get_triangle(std::size_t i) const {
+        return Triangle<T>(get_vertex(i, 0), get_vertex(i, 1), get_vertex(i, 2), get_type(i),
+                           get_id(i));
+    }
+
+    // coordinate arrays, three entries per triangle
+    std::span<const T> get_xs() const noexcept { return xs_; }
+    std::span<const T> get_ys() const noexcept { return ys_; }
+    std::span<const T> get_zs() const noexcept { return zs_; }
+
+    // triangle i moves to position j for order[j] == i; `order` must be a permutation
+    void permute(std::span<const std::uint32_t> order) {
+        if (order.size() != size())
+            throw std::invalid_argument("TriangleStore::permute: wrong permutation size");
+
+        TriangleStore permuted;
+        permuted.reserve(size());
+        for (const std::uint32_t i : order) {
+            for (std::size_t k = 0; k < 3; ++k) {
+                permuted.xs_.push_back(xs_[3 * i + k]);
+                permuted.ys_.push_back(ys_[3 * i + k]);
+                permuted.zs_.push_back(zs_[3 * i + k]);
+            }
+            permuted.ids_.push_back(ids_[i]);
+            permuted.types_.push_back(types_[i]);
+        }
+        *this = std::move(permuted);
+    }
+};
+
+} // namespace triangle
+
+#endif // INCLUDE_PRIMITIVES_TRIANGLE_STORE_HPP
@@ -0,0 +1,162 @@
+#ifndef INCLUDE_PRIMITIVES_TRIANGLE_VIEW_HPP
+#define INCLUDE_PRIMITIVES_TRIANGLE_VIEW_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "BVH/AABB.hpp"
+#include "point.hpp"
+#include "triangle.hpp"
+
+namespace triangle {
+
+/* ---------- triangles in memory owned by the caller ---------- */
+// Over Triangle objects, or over a vertex buffer where coordinate c of vertex k of source
+// triangle s is at base[s * triangle_stride + k * vertex_stride + c]. Nothing of the geometry
+// is copied: the view keeps a permutation of the source triangles (position i shows source
+// triangle order[i]) and their types, and permute() changes only that permutation. The
+// caller's memory must outlive the view and stay unchanged while it is in use.
+template <std::floating_point T> class TriangleView {
+  private:
+    const T *base_ = nullptr; // the vertex buffer, null over Triangle objects
+    std::size_t triangle_stride_ = 0; // in elements of T
+    std::size_t vertex_stride_ = 0;
+    const Triangle<T> *source_triangles_ = nullptr; // vertices and ids come from here, if set
+    std::vector<std::uint32_t> order_;
+    std::vector<std::uint8_t> types_;
+
+    void init_order(std::size_t count) {
+        if (count > std::numeric_limits<std::uint32_t>::max())
+            throw std::length_error("TriangleView supports at most 2^32 - 1 triangles");
+
+        order_.resize(count);
+        for (std::size_t i = 0; i < count; ++i)
+            order_[i] = static_cast<std::uint32_t>(i);
+        types_.reserve(count);
+    }
+
+    // one past the last coordinate of the view, counted from base_
+    std::size_t extent() const noexcept {
+        if (order_.empty() || !base_)
+            return 0;
+        return (order_.size() - 1) * triangle_stride_ + 2 * vertex_stride_ + 1;
+    }
+
+  public:
+    TriangleView() = default;
+
+    // over Triangle objects; vertices, ids and types are taken from them, the view has no
+    // coordinate columns
+    explicit TriangleView(std::span<const Triangle<T>> triangles)
+        : source_triangles_(triangles.data()) {
+        init_order(triangles.size());
+        for (const Triangle<T> &tr : triangles)
+            types_.push_back(static_cast<std::uint8_t>(tr.get_type()));
+    }
+
+    // over a vertex buffer: vertex j at vertices[j * stride], three vertices per triangle; the
+    // id of a triangle is its position in the buffer
+    explicit TriangleView(std::span<const T> vertices, std::size_t stride = 3)
+        : base_(vertices.data()), triangle_stride_(3 * stride), vertex_stride_(stride) {
+        if (stride < 3)
+            throw std::invalid_argument("TriangleView: vertex stride is less than 3");
+
+        const std::size_t number_of_vertices =
+            vertices.size() < 3 ? 0 : (vertices.size() - 3) / stride + 1;
+        if (number_of_vertices % 3 != 0)
+            throw std::invalid_argument("TriangleView: not a whole number of triangles");
+
+        init_order(number_of_vertices / 3);
+        for (std::size_t i = 0; i < order_.size(); ++i)
+            types_.push_back(static_cast<std::uint8_t>(
+                classify_triangle(get_vertex(i, 0), get_vertex(i, 1), get_vertex(i, 2))));
+    }
+
+    std::size_t size() const noexcept { return order_.size(); }
+    bool empty() const noexcept { return order_.empty(); }
+
+    // source triangle shown at position i
+    std::size_t get_source_index(std::size_t i) const noexcept { return order_[i]; }
+
+    std::size_t get_id(std::size_t i) const noexcept {
+        return source_triangles_ ? source_triangles_[order_[i]].get_id() : order_[i];
+    }
+
+    TypeTriangle get_type(std::size_t i) const noexcept {
+        return static_cast<TypeTriangle>(types_[i]);
+    }
+
+    // position of vertex k of triangle i in the coordinate columns of a vertex buffer
+    std::size_t vertex_index(std::size_t i, std::size_t k) const noexcept {
+        return order_[i] * triangle_stride_ + k * vertex_stride_;
+    }
+
+    Point<T> get_vertex(std::size_t i, std::size_t k) const noexcept {
+        if (source_triangles_)
+            return source_triangles_[order_[i]].get_vertices()[k];
+        const T *p = base_ + vertex_index(i, k);
+        return {p[0], p[1], p[2]};
+    }
+
+    std::array<Point<T>, 3> get_vertices(std::size_t i) const noexcept {
+        return {get_vertex(i, 0), get_vertex(i, 1), get_vertex(i, 2)};
+    }
+
+    bounding_box::AABB<T> get_box(std::size_t i) const noexcept {
+        const auto [a, b, c] = get_vertices(i);
+        return bounding_box::AABB<T>(
+            Point<T>(std::min({a.x_, b.x_, c.x_}), std::min({a.y_, b.y_, c.y_}),
+                     std::min({a.z_, b.z_, c.z_})),
+            Point<T>(std::max({a.x_, b.x_, c.x_}), std::max({a.y_, b.y_, c.y_}),
+                     std::max({a.z_, b.z_, c.z_})));
+    }
+
+    // coordinate `axis` of the box center, as AABB::get_center computes it
+    T get_center(std::size_t i, std::size_t axis) const noexcept {
+        const auto [a, b, c] = get_vertices(i);
+        auto coordinate = [axis](const Point<T> &p) {
+            return axis == 0 ? p.x_ : axis == 1 ? p.y_ : p.z_;
+        };
+        const T c_0 = coordinate(a), c_1 = coordinate(b), c_2 = coordinate(c);
+        return (std::max({c_0, c_1, c_2}) + std::min({c_0, c_1, c_2})) / 2;
+    }
+
+    Triangle<T> get_triangle(std::size_t i) const {
+        return Triangle<T>(get_vertex(i, 0), get_vertex(i, 1), get_vertex(i, 2), get_type(i),
+                           get_id(i));
+    }
+
+    // strided coordinate columns over the vertex buffer, indexed by vertex_index; empty over
+    // Triangle objects, whose members other than the coordinates sit between the vertices
+    std::span<const T> get_xs() const noexcept { return {base_, extent()}; }
+    std::span<const T> get_ys() const noexcept { return {base_ ? base_ + 1 : base_, extent()}; }
+    std::span<const T> get_zs() const noexcept { return {base_ ? base_ + 2 : base_, extent()}; }
+
+    // triangle i moves to position j for order[j] == i; the caller's memory is not touched
+    void permute(std::span<const std::uint32_t> order) {
+        if (order.size() != size())
+            throw std::invalid_argument("TriangleView::permute: wrong permutation size");
+
+        std::vector<std::uint32_t> permuted_order;
+        std::vector<std::uint8_t> types;
+        permuted_order.reserve(order_.size());
+        types.reserve(types_.size());
+
+        for (const std::uint32_t i : order) {
+            permuted_order.push_back(order_[i]);
+            types.push_back(types_[i]);
+        }
+        order_ = std::move(permuted_order);
+        types_ = std::move(types);
+    }
+};
+
+} // namespace triangle
+
+#endif // INCLUDE_PRIMITIVES_TRIANGLE_VIEW_HPP
@@ -5,6 +5,7 @@
 #include <ostream>
 
 #include "common/cmp.hpp"
+#include "common/simd.hpp"
 #include "point.hpp"
 
 namespace triangle {
@@ -18,13 +19,22 @@ template <std::floating_point T> Vector<T> vector_product(const Vector<T> &v1, c
 template <std::floating_point T>
 T mixed_product(const Vector<T> &a, const Vector<T> &b, const Vector<T> &c);
 
-template <std::floating_point T> struct Vector {
+template <std::floating_point T> struct alignas(simd::has_xyz0<T> ? 16 : alignof(T)) Vector {
     T x_;
     T y_;
     T z_;
-
-    Vector(const Point<T> &a, const Point<T> &b)
-        : x_(b.x_ - a.x_), y_(b.y_ - a.y_), z_(b.z_ - a.z_) {}
+    [[no_unique_address]] PaddingLane<T> w_{}; // always 0
+
+    Vector(const Point<T> &a, const Point<T> &b) {
+        if constexpr (simd::has_xyz0<T>) {
+            using Lanes = simd::xyz0_t<T>;
+            (Lanes::load(&b.x_) - Lanes::load(&a.x_)).store(&x_);
+        } else {
+            x_ = b.x_ - a.x_;
+            y_ = b.y_ - a.y_;
+            z_ = b.z_ - a.z_;
+        }
+    }
 
     Vector(T x, T y, T z) : x_(x), y_(y), z_(z) {}
 
@@ -80,11 +90,20 @@ template <std::floating_point T> struct Vector {
 // --------------------------------------------------------------------------------------
 
 template <std::floating_point T> T scalar_product(const Vector<T> &v1, const Vector<T> &v2) {
-    return v1.x_ * v2.x_ + v1.y_ * v2.y_ + v1.z_ * v2.z_;
+    if constexpr (simd::has_xyz0<T>)
+        return dot_xyz0(simd::xyz0_t<T>::load(&v1.x_), simd::xyz0_t<T>::load(&v2.x_));
+    else
+        return v1.x_ * v2.x_ + v1.y_ * v2.y_ + v1.z_ * v2.z_;
 }
 
 template <std::floating_point T>
 Vector<T> vector_product(const Vector<T> &v1, const Vector<T> &v2) {
+    if constexpr (simd::has_xyz0<T>) {
+        using Lanes = simd::xyz0_t<T>;
+        Vector<T> product(0, 0, 0);
+        cross_xyz0(Lanes::load(&v1.x_), Lanes::load(&v2.x_)).store(&product.x_);
+        return product;
+    }
 
     const T x1 = v1.x_, y1 = v1.y_, z1 = v1.z_;
     const T x2 = v2.x_, y2 = v2.y_, z2 = v2.z_;
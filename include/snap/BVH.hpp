@@ -0,0 +1,187 @@
+#ifndef INCLUDE_SNAP_BVH_HPP
+#define INCLUDE_SNAP_BVH_HPP
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <set>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "BVH/AABB.hpp"
+#include "BVH/BVH.hpp"
+#include "BVH/candidate_pairs.hpp"
+#include "primitives/triangle.hpp"
+#include "snap/grid.hpp"
+#include "snap/intersection.hpp"
+#include "snap/triangle.hpp"
+
+namespace snap {
+
+/* ---------- node of the snapped BVH ---------- */
+struct SnapNode {
+    IntBox box;
+    std::span<const IntTriangle> triangles;
+    std::unique_ptr<SnapNode> left = nullptr;
+    std::unique_ptr<SnapNode> right = nullptr;
+
+    bool is_leaf() const noexcept { return !left; }
+};
+
+/* ---------- BVH over triangles snapped to a 2^Bits grid of the scene box ---------- */
+template <unsigned Bits>
+    requires grid_bits<Bits>
+class SnapBVH {
+  private:
+    SnapGrid<Bits> grid_;
+    std::vector<IntTriangle> triangles_;
+    std::unique_ptr<SnapNode> root_ = nullptr;
+    std::set<std::size_t> intersecting_triangles_;
+
+  public:
+    template <std::floating_point T>
+    explicit SnapBVH(const std::vector<triangle::Triangle<T>> &triangles)
+        : grid_(scene_box(triangles)) {
+        if (triangles.size() > std::numeric_limits<std::uint32_t>::max())
+            throw std::length_error("BVH supports at most 2^32 - 1 triangles");
+
+        triangles_.reserve(triangles.size());
+        for (const auto &tr : triangles) {
+            const auto &v = tr.get_vertices();
+            triangles_.emplace_back(grid_.quantize(v[0]), grid_.quantize(v[1]),
+                                    grid_.quantize(v[2]), tr.get_id());
+        }
+    }
+
+    void build() {
+        root_ = triangles_.empty() ? nullptr : build_node(0, triangles_.size());
+    }
+
+    const SnapGrid<Bits> &get_grid() const noexcept { return grid_; }
+
+    std::set<std::size_t> &get_intersecting_triangles() {
+        intersecting_triangles_.clear();
+
+        bin_tree::CandidateBatch batch;
+        auto emit = [&](std::uint32_t first, std::uint32_t second) {
+            batch.push(first, second);
+            if (batch.full()) {
+                process_batch(batch);
+                batch.clear();
+            }
+        };
+
+        collect_candidate_pairs(root_.get(), root_.get(), emit);
+        process_batch(batch);
+
+        return intersecting_triangles_;
+    }
+
+  private:
+    template <std::floating_point T>
+    static bounding_box::AABB<T> scene_box(const std::vector<triangle::Triangle<T>> &triangles) {
+        bounding_box::AABB<T> box;
+        for (const auto &tr : triangles)
+            box.wrap_in_box_with(tr.get_box());
+
+        return triangles.empty() ? bounding_box::AABB<T>(triangle::Point<T>(0, 0, 0),
+                                                         triangle::Point<T>(0, 0, 0))
+                                 : box;
+    }
+
+    std::unique_ptr<SnapNode> build_node(std::size_t start, std::size_t end) {
+        auto node = std::make_unique<SnapNode>();
+        for (std::size_t i = start; i < end; ++i)
+            node->box.wrap_in_box_with(triangles_[i].get_box());
+
+        const std::size_t count = end - start;
+        if (count <= bin_tree::max_number_of_triangles_in_leaf) {
+            node->triangles = std::span<const IntTriangle>(triangles_).subspan(start, count);
+            return node;
+        }
+
+        const std::size_t axis = longest_axis(node->box);
+        auto comp = [axis](const IntTriangle &a, const IntTriangle &b) {
+            return a.get_box().get_double_center(axis) < b.get_box().get_double_center(axis);
+        };
+
+        const std::size_t mid = start + count / 2;
+        std::nth_element(triangles_.begin() + start, triangles_.begin() + mid,
+                         triangles_.begin() + end, comp);
+
+        node->left = build_node(start, mid);
+        node->right = build_node(mid, end);
+        return node;
+    }
+
+    static std::size_t longest_axis(const IntBox &box) noexcept {
+        const std::uint32_t x = box.p_max.x_ - box.p_min.x_;
+        const std::uint32_t y = box.p_max.y_ - box.p_min.y_;
+        const std::uint32_t z = box.p_max.z_ - box.p_min.z_;
+
+        if (x >= y && x >= z)
+            return 0;
+        return y >= z ? 1 : 2;
+    }
+
+    template <typename Sink>
+    void collect_candidate_pairs(const SnapNode *a, const SnapNode *b, Sink &emit) const {
+        if (!a || !b || !IntBox::intersect(a->box, b->box))
+            return;
+
+        if (a->is_leaf() && b->is_leaf()) {
+            const auto base_a = static_cast<std::uint32_t>(a->triangles.data() - triangles_.data());
+            const auto base_b = static_cast<std::uint32_t>(b->triangles.data() - triangles_.data());
+            const auto size_a = static_cast<std::uint32_t>(a->triangles.size());
+            const auto size_b = static_cast<std::uint32_t>(b->triangles.size());
+
+            for (std::uint32_t i = 0; i < size_a; ++i)
+                for (std::uint32_t j = (a == b ? i + 1 : 0); j < size_b; ++j)
+                    emit(base_a + i, base_b + j);
+            return;
+        }
+
+        if (a->is_leaf()) {
+            collect_candidate_pairs(a, b->left.get(), emit);
+            collect_candidate_pairs(a, b->right.get(), emit);
+            return;
+        }
+        if (b->is_leaf()) {
+            collect_candidate_pairs(a->left.get(), b, emit);
+            collect_candidate_pairs(a->right.get(), b, emit);
+            return;
+        }
+
+        if (a == b) {
+            collect_candidate_pairs(a->left.get(), a->left.get(), emit);
+            collect_candidate_pairs(a->left.get(), a->right.get(), emit);
+            collect_candidate_pairs(a->right.get(), a->right.get(), emit);
+        } else {
+            collect_candidate_pairs(a->left.get(), b->left.get(), emit);
+            collect_candidate_pairs(a->left.get(), b->right.get(), emit);
+            collect_candidate_pairs(a->right.get(), b->left.get(), emit);
+            collect_candidate_pairs(a->right.get(), b->right.get(), emit);
+        }
+    }
+
+    void process_batch(const bin_tree::CandidateBatch &batch) {
+        for (const bin_tree::CandidatePair &pair : batch.get_pairs()) {
+            const IntTriangle &first = triangles_[pair.first];
+            const IntTriangle &second = triangles_[pair.second];
+
+            if (IntBox::intersect(first.get_box(), second.get_box()) &&
+                intersect<Bits>(first, second)) {
+                intersecting_triangles_.insert(first.get_id());
+                intersecting_triangles_.insert(second.get_id());
+            }
+        }
+    }
+};
+
+} // namespace snap
+
+#endif // INCLUDE_SNAP_BVH_HPP
@@ -0,0 +1,107 @@
+#ifndef INCLUDE_SNAP_GRID_HPP
+#define INCLUDE_SNAP_GRID_HPP
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#include "BVH/AABB.hpp"
+#include "primitives/point.hpp"
+#include "primitives/triangle.hpp"
+
+namespace snap {
+
+// Supported grid resolutions. With 21 bits the cross products of edge vectors fit in 64-bit
+// integers and only the final dot product needs 128 bits; with 32 bits everything past the
+// coordinate differences is 128-bit.
+template <unsigned Bits>
+concept grid_bits = Bits == 21 || Bits == 32;
+
+/* ---------- vertex snapped to the grid ---------- */
+struct IntPoint {
+    std::uint32_t x_;
+    std::uint32_t y_;
+    std::uint32_t z_;
+
+    std::uint32_t operator[](std::size_t axis) const noexcept {
+        return axis == 0 ? x_ : (axis == 1 ? y_ : z_);
+    }
+
+    bool operator==(const IntPoint &) const = default;
+};
+
+/* ---------- axis-aligned bounding box in grid units ---------- */
+struct IntBox {
+    IntPoint p_min{std::numeric_limits<std::uint32_t>::max(),
+                   std::numeric_limits<std::uint32_t>::max(),
+                   std::numeric_limits<std::uint32_t>::max()};
+    IntPoint p_max{0, 0, 0};
+
+    static bool intersect(const IntBox &a, const IntBox &b) noexcept {
+        return (a.p_min.x_ <= b.p_max.x_ && a.p_max.x_ >= b.p_min.x_) &&
+               (a.p_min.y_ <= b.p_max.y_ && a.p_max.y_ >= b.p_min.y_) &&
+               (a.p_min.z_ <= b.p_max.z_ && a.p_max.z_ >= b.p_min.z_);
+    }
+
+    void wrap_in_box_with(const IntPoint &point) noexcept {
+        p_min = {std::min(p_min.x_, point.x_), std::min(p_min.y_, point.y_),
+                 std::min(p_min.z_, point.z_)};
+        p_max = {std::max(p_max.x_, point.x_), std::max(p_max.y_, point.y_),
+                 std::max(p_max.z_, point.z_)};
+    }
+
+    void wrap_in_box_with(const IntBox &box) noexcept {
+        wrap_in_box_with(box.p_min);
+        wrap_in_box_with(box.p_max);
+    }
+
+    // twice the center, so that it stays integral
+    std::uint64_t get_double_center(std::size_t axis) const noexcept {
+        return std::uint64_t{p_min[axis]} + p_max[axis];
+    }
+};
+
+/* ---------- uniform quantization of the scene box ---------- */
+template <unsigned Bits>
+    requires grid_bits<Bits>
+class SnapGrid {
+  public:
+    static constexpr std::uint32_t max_coordinate =
+        static_cast<std::uint32_t>((std::uint64_t{1} << Bits) - 1);
+
+  private:
+    std::array<double, 3> origin_;
+    double scale_; // grid units per model unit, the same on every axis
+
+  public:
+    template <std::floating_point T> explicit SnapGrid(const bounding_box::AABB<T> &scene) {
+        origin_ = {scene.p_min.x_, scene.p_min.y_, scene.p_min.z_};
+
+        const double extent =
+            std::max({double{scene.p_max.x_} - scene.p_min.x_,
+                      double{scene.p_max.y_} - scene.p_min.y_,
+                      double{scene.p_max.z_} - scene.p_min.z_});
+
+        scale_ = extent > 0 ? max_coordinate / extent : 1.0;
+    }
+
+    template <std::floating_point T> IntPoint quantize(const triangle::Point<T> &point) const {
+        auto snap = [this](double value, std::size_t axis) {
+            const double scaled = std::round((value - origin_[axis]) * scale_);
+            return static_cast<std::uint32_t>(std::clamp(scaled, 0.0, double{max_coordinate}));
+        };
+
+        return {snap(point.x_, 0), snap(point.y_, 1), snap(point.z_, 2)};
+    }
+
+    // edge length of a grid cell in model units
+    double get_resolution() const noexcept { return 1.0 / scale_; }
+};
+
+} // namespace snap
+
+#endif // INCLUDE_SNAP_GRID_HPP
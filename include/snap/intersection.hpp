@@ -0,0 +1,206 @@
+#ifndef INCLUDE_SNAP_INTERSECTION_HPP
+#define INCLUDE_SNAP_INTERSECTION_HPP
+
+#include <array>
+#include <cstddef>
+
+#include "primitives/triangle.hpp"
+#include "snap/predicates.hpp"
+#include "snap/triangle.hpp"
+
+namespace snap {
+
+// Exact intersection tests on snapped triangles. Every decision is an integer sign, so
+// there is no epsilon: touching counts as intersecting, a gap of one grid cell does not.
+
+namespace detail {
+
+inline bool same_strict_side(int a, int b) noexcept { return (a > 0 && b > 0) || (a < 0 && b < 0); }
+
+inline bool all_same_strict_side(const std::array<int, 3> &signs) noexcept {
+    return same_strict_side(signs[0], signs[1]) && same_strict_side(signs[1], signs[2]);
+}
+
+inline bool no_sign_change(int a, int b, int c) noexcept {
+    return (a >= 0 && b >= 0 && c >= 0) || (a <= 0 && b <= 0 && c <= 0);
+}
+
+// point known to lie in the plane of the non-degenerate triangle (a, b, c)
+inline bool point_inside_triangle_2d(const IntPoint &a, const IntPoint &b, const IntPoint &c,
+                                     const IntPoint &point, std::size_t axis) noexcept {
+    return no_sign_change(orient_2d(a, b, point, axis), orient_2d(b, c, point, axis),
+                          orient_2d(c, a, point, axis));
+}
+
+} // namespace detail
+
+template <unsigned Bits>
+bool segments_intersect(const IntPoint &p, const IntPoint &q, const IntPoint &r,
+                        const IntPoint &s) noexcept {
+    if (orient_3d<Bits>(p, q, r, s) != 0)
+        return false;
+
+    const IntVector n_pqr = normal(p, q, r);
+    const IntVector n_pqs = normal(p, q, s);
+    if (n_pqr.is_nul() && n_pqs.is_nul()) // r and s on the line pq
+        return on_segment(p, q, r) || on_segment(p, q, s) || on_segment(r, s, p) ||
+               on_segment(r, s, q);
+
+    const std::size_t axis = dominant_axis(n_pqr.is_nul() ? n_pqs : n_pqr);
+
+    const int d_1 = orient_2d(r, s, p, axis);
+    const int d_2 = orient_2d(r, s, q, axis);
+    const int d_3 = orient_2d(p, q, r, axis);
+    const int d_4 = orient_2d(p, q, s, axis);
+
+    if (d_1 * d_2 < 0 && d_3 * d_4 < 0)
+        return true;
+
+    return (d_1 == 0 && on_segment(r, s, p)) || (d_2 == 0 && on_segment(r, s, q)) ||
+           (d_3 == 0 && on_segment(p, q, r)) || (d_4 == 0 && on_segment(p, q, s));
+}
+
+// segment [p, q] against the non-degenerate triangle `tri`; sign_p and sign_q are the
+// orientations of p and q relative to its plane
+template <unsigned Bits>
+bool segment_intersect_triangle(const IntPoint &p, const IntPoint &q, int sign_p, int sign_q,
+                                const IntTriangle &tri) noexcept {
+    const auto &t = tri.get_vertices();
+
+    if (detail::same_strict_side(sign_p, sign_q))
+        return false;
+
+    if (sign_p == 0 && sign_q == 0) {
+        const std::size_t axis = dominant_axis(normal(t[0], t[1], t[2]));
+        if (detail::point_inside_triangle_2d(t[0], t[1], t[2], p, axis) ||
+            detail::point_inside_triangle_2d(t[0], t[1], t[2], q, axis))
+            return true;
+
+        for (std::size_t i = 0; i < 3; ++i) {
+            if (segments_intersect<Bits>(p, q, t[i], t[(i + 1) % 3]))
+                return true;
+        }
+        return false;
+    }
+
+    // the segment reaches the plane: the line pq has to pass through the triangle
+    return detail::no_sign_change(orient_3d<Bits>(p, q, t[0], t[1]),
+                                  orient_3d<Bits>(p, q, t[1], t[2]),
+                                  orient_3d<Bits>(p, q, t[2], t[0]));
+}
+
+template <unsigned Bits>
+bool segment_intersect_triangle(const IntPoint &p, const IntPoint &q,
+                                const IntTriangle &tri) noexcept {
+    const auto &t = tri.get_vertices();
+    return segment_intersect_triangle<Bits>(p, q, orient_3d<Bits>(t[0], t[1], t[2], p),
+                                            orient_3d<Bits>(t[0], t[1], t[2], q), tri);
+}
+
+template <unsigned Bits>
+bool point_inside_triangle(const IntTriangle &tri, const IntPoint &point) noexcept {
+    const auto &t = tri.get_vertices();
+
+    switch (tri.get_type()) {
+    case triangle::TypeTriangle::point:
+        return t[0] == point;
+    case triangle::TypeTriangle::interval: {
+        const auto [first, second] = tri.get_interval();
+        return on_segment(t[first], t[second], point);
+    }
+    default:
+        if (orient_3d<Bits>(t[0], t[1], t[2], point) != 0)
+            return false;
+        return detail::point_inside_triangle_2d(t[0], t[1], t[2], point,
+                                                dominant_axis(normal(t[0], t[1], t[2])));
+    }
+}
+
+namespace detail {
+
+// both triangles lie in one plane
+template <unsigned Bits>
+bool intersect_coplanar(const IntTriangle &first, const IntTriangle &second) noexcept {
+    const auto &a = first.get_vertices();
+    const auto &b = second.get_vertices();
+    const std::size_t axis = dominant_axis(normal(a[0], a[1], a[2]));
+
+    for (std::size_t i = 0; i < 3; ++i) {
+        if (point_inside_triangle_2d(a[0], a[1], a[2], b[i], axis) ||
+            point_inside_triangle_2d(b[0], b[1], b[2], a[i], axis))
+            return true;
+    }
+
+    for (std::size_t i = 0; i < 3; ++i) {
+        for (std::size_t j = 0; j < 3; ++j) {
+            if (segments_intersect<Bits>(a[i], a[(i + 1) % 3], b[j], b[(j + 1) % 3]))
+                return true;
+        }
+    }
+    return false;
+}
+
+// Two non-coplanar triangles meet along a segment of the line where their planes cross;
+// its ends lie on edges, so some edge of one triangle must hit the other triangle.
+template <unsigned Bits>
+bool intersect_triangles(const IntTriangle &first, const IntTriangle &second) noexcept {
+    const auto &a = first.get_vertices();
+    const auto &b = second.get_vertices();
+
+    const std::array<int, 3> signs_b{orient_3d<Bits>(a[0], a[1], a[2], b[0]),
+                                     orient_3d<Bits>(a[0], a[1], a[2], b[1]),
+                                     orient_3d<Bits>(a[0], a[1], a[2], b[2])};
+    if (all_same_strict_side(signs_b))
+        return false;
+    if (signs_b[0] == 0 && signs_b[1] == 0 && signs_b[2] == 0)
+        return intersect_coplanar<Bits>(first, second);
+
+    const std::array<int, 3> signs_a{orient_3d<Bits>(b[0], b[1], b[2], a[0]),
+                                     orient_3d<Bits>(b[0], b[1], b[2], a[1]),
+                                     orient_3d<Bits>(b[0], b[1], b[2], a[2])};
+    if (all_same_strict_side(signs_a))
+        return false;
+
+    for (std::size_t i = 0; i < 3; ++i) {
+        const std::size_t j = (i + 1) % 3;
+        if (segment_intersect_triangle<Bits>(a[i], a[j], signs_a[i], signs_a[j], second) ||
+            segment_intersect_triangle<Bits>(b[i], b[j], signs_b[i], signs_b[j], first))
+            return true;
+    }
+    return false;
+}
+
+} // namespace detail
+
+template <unsigned Bits>
+bool intersect(const IntTriangle &first, const IntTriangle &second) noexcept {
+    using triangle::TypeTriangle;
+
+    if (first.get_type() == TypeTriangle::point)
+        return point_inside_triangle<Bits>(second, first.get_vertices()[0]);
+    if (second.get_type() == TypeTriangle::point)
+        return point_inside_triangle<Bits>(first, second.get_vertices()[0]);
+
+    if (first.get_type() == TypeTriangle::interval) {
+        const auto &v = first.get_vertices();
+        const auto [p, q] = first.get_interval();
+
+        if (second.get_type() == TypeTriangle::interval) {
+            const auto &w = second.get_vertices();
+            const auto [r, s] = second.get_interval();
+            return segments_intersect<Bits>(v[p], v[q], w[r], w[s]);
+        }
+        return segment_intersect_triangle<Bits>(v[p], v[q], second);
+    }
+    if (second.get_type() == TypeTriangle::interval) {
+        const auto &w = second.get_vertices();
+        const auto [r, s] = second.get_interval();
+        return segment_intersect_triangle<Bits>(w[r], w[s], first);
+    }
+
+    return detail::intersect_triangles<Bits>(first, second);
+}
+
+} // namespace snap
+
+#endif // INCLUDE_SNAP_INTERSECTION_HPP
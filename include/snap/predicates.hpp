@@ -0,0 +1,105 @@
+#ifndef INCLUDE_SNAP_PREDICATES_HPP
+#define INCLUDE_SNAP_PREDICATES_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+#include "snap/grid.hpp"
+
+namespace snap {
+
+// Exact integer predicates on grid points. Signs follow triangle::orient_3d.
+
+using int128 = __int128;
+
+struct IntVector {
+    int128 x_;
+    int128 y_;
+    int128 z_;
+
+    bool is_nul() const noexcept { return x_ == 0 && y_ == 0 && z_ == 0; }
+};
+
+template <typename I> int sign(I value) noexcept { return (value > 0) - (value < 0); }
+
+inline std::int64_t difference(std::uint32_t a, std::uint32_t b) noexcept {
+    return static_cast<std::int64_t>(a) - static_cast<std::int64_t>(b);
+}
+
+// (b - a) x (c - a)
+inline IntVector normal(const IntPoint &a, const IntPoint &b, const IntPoint &c) noexcept {
+    const int128 ab_x = difference(b.x_, a.x_), ab_y = difference(b.y_, a.y_),
+                 ab_z = difference(b.z_, a.z_);
+    const int128 ac_x = difference(c.x_, a.x_), ac_y = difference(c.y_, a.y_),
+                 ac_z = difference(c.z_, a.z_);
+
+    return {ab_y * ac_z - ab_z * ac_y, ab_z * ac_x - ab_x * ac_z, ab_x * ac_y - ab_y * ac_x};
+}
+
+// sign of ((q - p) x (r - p)) * (s - p)
+template <unsigned Bits>
+    requires grid_bits<Bits>
+int orient_3d(const IntPoint &p, const IntPoint &q, const IntPoint &r, const IntPoint &s) noexcept {
+    const std::int64_t pq_x = difference(q.x_, p.x_), pq_y = difference(q.y_, p.y_),
+                       pq_z = difference(q.z_, p.z_);
+    const std::int64_t pr_x = difference(r.x_, p.x_), pr_y = difference(r.y_, p.y_),
+                       pr_z = difference(r.z_, p.z_);
+    const std::int64_t ps_x = difference(s.x_, p.x_), ps_y = difference(s.y_, p.y_),
+                       ps_z = difference(s.z_, p.z_);
+
+    if constexpr (Bits <= 21) {
+        // |differences| < 2^21: every cross product component is below 2^43
+        const std::int64_t n_x = pq_y * pr_z - pq_z * pr_y;
+        const std::int64_t n_y = pq_z * pr_x - pq_x * pr_z;
+        const std::int64_t n_z = pq_x * pr_y - pq_y * pr_x;
+
+        return sign(int128{n_x} * ps_x + int128{n_y} * ps_y + int128{n_z} * ps_z);
+    } else {
+        const int128 n_x = int128{pq_y} * pr_z - int128{pq_z} * pr_y;
+        const int128 n_y = int128{pq_z} * pr_x - int128{pq_x} * pr_z;
+        const int128 n_z = int128{pq_x} * pr_y - int128{pq_y} * pr_x;
+
+        return sign(n_x * ps_x + n_y * ps_y + n_z * ps_z);
+    }
+}
+
+// axis with the largest normal component: dropping it projects the plane injectively
+inline std::size_t dominant_axis(const IntVector &n) noexcept {
+    const int128 a_x = n.x_ < 0 ? -n.x_ : n.x_;
+    const int128 a_y = n.y_ < 0 ? -n.y_ : n.y_;
+    const int128 a_z = n.z_ < 0 ? -n.z_ : n.z_;
+
+    if (a_x >= a_y && a_x >= a_z)
+        return 0;
+    return a_y >= a_z ? 1 : 2;
+}
+
+// orientation of (a, b, c) in the plane that drops `axis`
+inline int orient_2d(const IntPoint &a, const IntPoint &b, const IntPoint &c,
+                     std::size_t axis) noexcept {
+    const std::size_t u = (axis + 1) % 3;
+    const std::size_t v = (axis + 2) % 3;
+
+    const int128 ab_u = difference(b[u], a[u]), ab_v = difference(b[v], a[v]);
+    const int128 ac_u = difference(c[u], a[u]), ac_v = difference(c[v], a[v]);
+
+    return sign(ab_u * ac_v - ab_v * ac_u);
+}
+
+// point lies on the closed segment [p, q]
+inline bool on_segment(const IntPoint &p, const IntPoint &q, const IntPoint &point) noexcept {
+    const IntVector n = normal(p, q, point);
+    if (!n.is_nul())
+        return false;
+
+    for (std::size_t axis = 0; axis < 3; ++axis) {
+        if (point[axis] < std::min(p[axis], q[axis]) || point[axis] > std::max(p[axis], q[axis]))
+            return false;
+    }
+    return true;
+}
+
+} // namespace snap
+
+#endif // INCLUDE_SNAP_PREDICATES_HPP
@@ -0,0 +1,69 @@
+#ifndef INCLUDE_SNAP_TRIANGLE_HPP
+#define INCLUDE_SNAP_TRIANGLE_HPP
+
+#include <array>
+#include <cstddef>
+#include <utility>
+
+#include "primitives/triangle.hpp"
+#include "snap/grid.hpp"
+#include "snap/predicates.hpp"
+
+namespace snap {
+
+/* ---------- triangle with snapped vertices ---------- */
+class IntTriangle {
+  private:
+    using VerticesT = std::array<IntPoint, 3>;
+
+    VerticesT vertices_;
+    triangle::TypeTriangle type_ = triangle::TypeTriangle::triangle;
+    IntBox box_;
+    std::size_t id_;
+
+  public:
+    IntTriangle(const IntPoint &point_0, const IntPoint &point_1, const IntPoint &point_2,
+                std::size_t id)
+        : vertices_{point_0, point_1, point_2}, id_(id) {
+        for (const auto &vertex : vertices_)
+            box_.wrap_in_box_with(vertex);
+
+        // exact classification, no epsilon
+        if (point_0 == point_1 && point_1 == point_2)
+            type_ = triangle::TypeTriangle::point;
+        else if (normal(point_0, point_1, point_2).is_nul())
+            type_ = triangle::TypeTriangle::interval;
+    }
+
+    const VerticesT &get_vertices() const noexcept { return vertices_; }
+
+    triangle::TypeTriangle get_type() const noexcept { return type_; }
+
+    // the two outermost vertices of a collinear triangle
+    std::pair<std::size_t, std::size_t> get_interval() const noexcept {
+        auto dist = [](const IntPoint &a, const IntPoint &b) {
+            const int128 dx = difference(a.x_, b.x_);
+            const int128 dy = difference(a.y_, b.y_);
+            const int128 dz = difference(a.z_, b.z_);
+            return dx * dx + dy * dy + dz * dz;
+        };
+
+        const int128 d01 = dist(vertices_[0], vertices_[1]);
+        const int128 d02 = dist(vertices_[0], vertices_[2]);
+        const int128 d12 = dist(vertices_[1], vertices_[2]);
+
+        if (d01 >= d02 && d01 >= d12)
+            return {0, 1};
+        if (d02 >= d12)
+            return {0, 2};
+        return {1, 2};
+    }
+
+    std::size_t get_id() const noexcept { return id_; }
+
+    const IntBox &get_box() const noexcept { return box_; }
+};
+
+} // namespace snap
+
+#endif // INCLUDE_SNAP_TRIANGLE_HPP
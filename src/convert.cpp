@@ -0,0 +1,68 @@
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include <unistd.h>
+
+#include "io/binary_format.hpp"
+#include "io/input_format.hpp"
+#include "io/mapped_input.hpp"
+#include "primitives/indexed_mesh.hpp"
+#include "primitives/triangle_store.hpp"
+
+using namespace triangle;
+
+// Converts the input on stdin, text, STL, OBJ or PLY, to the binary format on stdout:
+//   convert [--precision=float|double] [--indexed] < triangles.txt > triangles.bin
+// The input is read at the stored precision, so the binary file gives the same coordinates
+// as the input does to the main program. --indexed welds the vertices.
+template <std::floating_point Stored> void convert(std::string_view text, bool indexed) {
+    TriangleStore<Stored> store;
+    io::parse_input<Stored>(
+        text, [&](std::size_t N) { store.reserve(N); },
+        [&](const Point<Stored> &p0, const Point<Stored> &p1, const Point<Stored> &p2,
+            std::size_t id) { store.push_back(p0, p1, p2, id); });
+
+    if (indexed)
+        io::write_binary<Stored>(std::cout, weld_vertices(store));
+    else
+        io::write_binary<Stored>(std::cout, store);
+    std::cout.flush();
+}
+
+int main(int argc, char **argv) {
+    constexpr std::string_view usage =
+        "usage: convert [--precision=float|double] [--indexed] < input > output.bin";
+
+    bool indexed = false;
+    std::string_view precision = "float";
+
+    try {
+        for (int i = 1; i < argc; ++i) {
+            const std::string_view arg = argv[i];
+            if (arg == "--indexed")
+                indexed = true;
+            else if (arg == "--precision=float" || arg == "--precision=double")
+                precision = arg.substr(arg.find('=') + 1);
+            else
+                throw std::invalid_argument("Unknown argument: " + std::string(arg));
+        }
+    } catch (const std::invalid_argument &error) {
+        std::cerr << error.what() << '\n' << usage << '\n';
+        return 1;
+    }
+
+    const io::MappedInput input(STDIN_FILENO);
+    if (io::is_binary_input(input.text())) {
+        std::cerr << "The input is already in the binary format\n";
+        return 1;
+    }
+
+    if (precision == "double")
+        convert<double>(input.text(), indexed);
+    else
+        convert<float>(input.text(), indexed);
+
+    return 0;
+}
@@ -1,13 +1,175 @@
+#include <cstddef>
+#include <exception>
+#include <iostream>
+#include <optional>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
 #include "driver.hpp"
 
 using namespace triangle;
 
-int main() {
-    auto triangles = get_input_data<float>();
+namespace {
+
+constexpr std::string_view usage =
+    "usage: 3D_triangles [--precision=float|double|mixed] [--snap=21|--snap=32] [--contacts]\n"
+    "                    [--weld] [--overlap] [--timings] [--stats[=text|json]] [--counters]\n"
+    "                    [--output=text|uint32|bitmap] [--trace=<file>] < input";
+
+} // namespace
+
+int main(int argc, char **argv) {
+    unsigned snap_bits = 0; // 0: floating-point predicates
+    bool contacts = false;  // print the intersection geometry instead of the ids
+    bool weld = false;      // weld the soup into an indexed mesh before the query
+    bool overlap = false;   // stream the text input and prepare the build while parsing it,
+                            // for input through a pipe
+    bool timings = false;   // print the time of every stage to stderr
+    std::optional<bin_tree::StatsFormat> stats; // print times, tree shape and counters to stderr
+    bool counters = false; // count hardware events around every stage (perf_event_open)
+    std::string_view precision = "float";
+    io::ResultFormat output = io::ResultFormat::text; // how the ids go to standard output
+    std::string trace_path; // write the spans of all threads there at exit (-DTRACE=ON builds)
+
+    try {
+        for (int i = 1; i < argc; ++i) {
+            const std::string_view arg = argv[i];
+            if (arg == "--snap=21")
+                snap_bits = 21;
+            else if (arg == "--snap=32")
+                snap_bits = 32;
+            else if (arg == "--contacts")
+                contacts = true;
+            else if (arg == "--weld")
+                weld = true;
+            else if (arg == "--overlap")
+                overlap = true;
+            else if (arg == "--timings")
+                timings = true;
+            else if (arg == "--stats")
+                stats = bin_tree::StatsFormat::text;
+            else if (arg.starts_with("--stats="))
+                stats = bin_tree::parse_stats_format(arg.substr(arg.find('=') + 1));
+            else if (arg == "--counters")
+                counters = true;
+            else if (arg == "--precision=float" || arg == "--precision=double" ||
+                     arg == "--precision=mixed")
+                precision = arg.substr(arg.find('=') + 1);
+            else if (arg.starts_with("--output="))
+                output = io::parse_result_format(arg.substr(arg.find('=') + 1));
+            else if (arg.starts_with("--trace="))
+                trace_path = arg.substr(arg.find('=') + 1);
+            else
+                throw std::invalid_argument("Unknown argument: " + std::string(arg));
+        }
+
+        if (contacts && snap_bits != 0)
+            throw std::invalid_argument("--contacts is not available in snap mode");
+        if (precision != "float" && (snap_bits != 0 || contacts))
+            throw std::invalid_argument("--precision only applies to the id query");
+        if (weld && (snap_bits != 0 || contacts || precision == "mixed"))
+            throw std::invalid_argument("--weld only applies to the float and double id query");
+        if ((overlap || timings || stats || counters) &&
+            (snap_bits != 0 || contacts || weld || precision == "mixed"))
+            throw std::invalid_argument("--overlap, --timings, --stats and --counters only "
+                                        "apply to the float and double id query");
+        if (contacts && output != io::ResultFormat::text)
+            throw std::invalid_argument("--output only applies to the id query");
+        if (!trace_path.empty()) {
+            if (!trace::enabled)
+                throw std::invalid_argument("--trace needs a build with -DTRACE=ON");
+            trace::Recorder::instance().write_at_exit(trace_path);
+        }
+    } catch (const std::exception &error) {
+        std::cerr << error.what() << '\n' << usage << '\n';
+        return 1;
+    }
+
+    // the bitmap format needs the number of triangles of the input
+    auto print = [output](const std::set<std::size_t> &ids, std::size_t number_of_triangles) {
+        print_numbers_of_intersecting_triangles(ids, output, number_of_triangles);
+    };
+
+    if (snap_bits != 0) {
+        const auto triangles = get_input_data<double>();
+        print(snap_bits == 21 ? snap_driver<21>(triangles) : snap_driver<32>(triangles),
+              triangles.size());
+        return 0;
+    }
+
+    // the counters go with the stage times; without hardware counters the run goes on without
+    std::optional<perf::EventCounters> event_counters;
+    if (counters) {
+        timings = true;
+        event_counters.emplace();
+        if (!event_counters->available()) {
+            std::cerr << "hardware counters unavailable (" << event_counters->get_error() << ")\n";
+            event_counters.reset();
+        }
+    }
+    perf::EventCounters *stage_counters = event_counters ? &*event_counters : nullptr;
+
+    if (stats) {
+        bin_tree::QueryStats query_stats;
+        query_stats.timings.count_events(stage_counters);
+        std::size_t number_of_triangles = 0;
+        const auto ids = precision == "double"
+                             ? stats_driver<double>(overlap, query_stats, number_of_triangles)
+                             : stats_driver<float>(overlap, query_stats, number_of_triangles);
+        query_stats.timings.measure("output", [&] { print(ids, number_of_triangles); });
+        bin_tree::print_stats(std::cerr, query_stats, *stats);
+        return 0;
+    }
+
+    if (overlap || timings) {
+        timing::StageTimings stage_timings;
+        stage_timings.count_events(stage_counters);
+        std::size_t number_of_triangles = 0;
+        const auto ids =
+            precision == "double"
+                ? timed_driver<double>(overlap, stage_timings, number_of_triangles)
+                : timed_driver<float>(overlap, stage_timings, number_of_triangles);
+        print(ids, number_of_triangles);
+        stage_timings.print(std::cerr);
+        return 0;
+    }
+
+    if (precision == "double") {
+        auto loaded = load_input<double>();
+        const std::size_t number_of_triangles = loaded.triangles.size();
+        print(weld ? mesh_driver<double>(std::move(loaded.triangles))
+                   : driver<double>(std::move(loaded)),
+              number_of_triangles);
+        return 0;
+    }
+
+    if (weld) {
+        auto loaded = load_input<float>();
+        const std::size_t number_of_triangles = loaded.triangles.size();
+        print(mesh_driver<float>(std::move(loaded.triangles)), number_of_triangles);
+        return 0;
+    }
+
+    if (precision == "mixed") {
+        auto triangles = get_input_data<float>();
+        const std::size_t number_of_triangles = triangles.size();
+        print(mixed_driver(std::move(triangles)), number_of_triangles);
+        return 0;
+    }
+
+    if (contacts) {
+        contacts_driver<float>(get_input_data<float>());
+        return 0;
+    }
 
-    auto intersecting_triangles = driver<float>(triangles);
+    auto loaded = load_input<float>();
+    const std::size_t number_of_triangles = loaded.triangles.size();
+    auto intersecting_triangles = driver<float>(std::move(loaded));
 
-    print_numbers_of_intersecting_triangles(intersecting_triangles);
+    print(intersecting_triangles, number_of_triangles);
 
     return 0;
 }
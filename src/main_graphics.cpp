@@ -8,7 +8,7 @@ using namespace triangle;
 
 int main() {
     auto triangles = get_input_data<float>();
-    auto intersect_triangles_s = driver<float>(triangles);
+    auto intersect_triangles_s = view_driver<float>(triangles);
 
     using unordered_set = std::unordered_set<std::size_t>;
 
@@ -1,8 +1,12 @@
 #include <gtest/gtest.h>
+#include <random>
+#include <set>
 #include <vector>
 
 #include "BVH.hpp"
+#include "indexed_mesh.hpp"
 #include "triangle.hpp"
+#include "triangle_view.hpp"
 #include "point.hpp"
 
 using namespace triangle;
@@ -114,4 +118,352 @@ TEST(BVH, LargeNumberOfTriangles) {
         auto& s = bvh.get_intersecting_triangles();
         (void)s;
     });
-}
\ No newline at end of file
+}
+
+TEST(BVH, PipelinedQueryMatchesSerial) {
+    std::vector<Tri> triangles;
+    for (int i = 0; i < 500; ++i) {
+        double x = static_cast<double>(i % 25);
+        double y = static_cast<double>(i / 25);
+        if (i % 2 == 0)
+            triangles.emplace_back(P{x,y,0}, P{x+1.5,y,0}, P{x,y+1.5,0}, /*id=*/static_cast<std::size_t>(i));
+        else
+            triangles.emplace_back(P{x+0.2,y+0.2,-1}, P{x+0.2,y+0.2,1}, P{x+1.2,y+0.3,0}, /*id=*/static_cast<std::size_t>(i));
+    }
+
+    auto copy = triangles;
+    BVHD serial(std::move(copy));
+    serial.build();
+    const auto expected = serial.get_intersecting_triangles();
+
+    BVHD pipelined(std::move(triangles));
+    pipelined.build();
+
+    EXPECT_FALSE(expected.empty());
+    EXPECT_EQ(pipelined.get_intersecting_triangles_pipelined(/*queue_capacity=*/1), expected);
+    EXPECT_EQ(pipelined.get_intersecting_triangles_pipelined(), expected);
+}
+
+TEST(BVH, PipelinedQueryOnEmptyTree) {
+    std::vector<Tri> empty_triangles;
+    BVHD bvh(std::move(empty_triangles));
+    bvh.build();
+
+    EXPECT_TRUE(bvh.get_intersecting_triangles_pipelined().empty());
+}
+
+TEST(BVH, MixedTypesMatchBruteForce) {
+    std::vector<Tri> triangles;
+    for (int i = 0; i < 300; ++i) {
+        double x = static_cast<double>(i % 10);
+        double y = static_cast<double>(i / 10 % 10);
+        double z = static_cast<double>(i / 100);
+        std::size_t id = static_cast<std::size_t>(i);
+        switch (i % 4) {
+        case 0: triangles.emplace_back(P{x,y,z}, P{x+1.5,y,z}, P{x,y+1.5,z}, id); break;
+        case 1: triangles.emplace_back(P{x+0.5,y+0.5,z-1}, P{x+0.5,y+0.5,z+1}, P{x+0.5,y+0.5,z}, id); break; // segment
+        case 2: triangles.emplace_back(P{x+1,y+0.2,z}, P{x+1,y+0.2,z}, P{x+1,y+0.2,z}, id); break; // point
+        default: triangles.emplace_back(P{x-0.5,y+0.7,z-0.5}, P{x+1.5,y+0.7,z+0.5}, P{x,y+0.7,z+1}, id); break;
+        }
+    }
+
+    std::set<std::size_t> expected;
+    for (std::size_t i = 0; i < triangles.size(); ++i)
+        for (std::size_t j = i + 1; j < triangles.size(); ++j)
+            if (intersect(triangles[i], triangles[j])) {
+                expected.insert(triangles[i].get_id());
+                expected.insert(triangles[j].get_id());
+            }
+
+    BVHD bvh(std::move(triangles));
+    bvh.build();
+
+    EXPECT_FALSE(expected.empty());
+    EXPECT_EQ(bvh.get_intersecting_triangles(), expected);
+    EXPECT_EQ(bvh.get_intersecting_triangles_pipelined(/*queue_capacity=*/1), expected);
+}
+
+TEST(BVH, ContactsMatchIntersectingPairs) {
+    std::mt19937 gen(34);
+    std::uniform_real_distribution<double> coord(0.0, 20.0);
+    std::uniform_real_distribution<double> offset(-1.5, 1.5);
+
+    std::vector<Tri> triangles;
+    for (std::size_t i = 0; i < 600; ++i) {
+        P base{coord(gen), coord(gen), coord(gen)};
+        auto near = [&] { return P{base.x_ + offset(gen), base.y_ + offset(gen), base.z_ + offset(gen)}; };
+        triangles.emplace_back(near(), near(), near(), i);
+    }
+
+    std::set<std::pair<std::size_t, std::size_t>> expected;
+    for (std::size_t i = 0; i < triangles.size(); ++i)
+        for (std::size_t j = i + 1; j < triangles.size(); ++j)
+            if (intersect(triangles[i], triangles[j]))
+                expected.emplace(i, j);
+
+    BVHD bvh(std::move(triangles));
+    bvh.build();
+
+    const auto &contacts = bvh.get_contacts();
+    std::set<std::pair<std::size_t, std::size_t>> pairs;
+    for (const auto &record : contacts.get_records()) {
+        pairs.emplace(std::min(record.first_id, record.second_id), std::max(record.first_id, record.second_id));
+        EXPECT_GE(record.size, 1u);
+        EXPECT_EQ(contacts.get_vertices(record).size(), record.size);
+    }
+    EXPECT_FALSE(expected.empty());
+    EXPECT_EQ(pairs, expected);
+    EXPECT_EQ(contacts.size(), expected.size());
+}
+
+TEST(BVH, ParallelContactsMatchSerial) {
+    auto triangles = make_grid_triangles();
+    for (std::size_t i = 0; i < 200; ++i) {
+        double x = static_cast<double>(i % 20) * 0.5;
+        double y = static_cast<double>(i / 20) * 0.5;
+        triangles.emplace_back(P{x,y,-1}, P{x+1,y+0.3,1}, P{x,y+1,0.5}, 10 + i);
+    }
+
+    BVHD bvh(std::move(triangles));
+    bvh.build();
+
+    const bin_tree::ContactBuffer<double> serial = bvh.get_contacts();
+    ASSERT_FALSE(serial.empty());
+
+    for (std::size_t threads : {1u, 2u, 3u, 8u}) {
+        const auto &parallel = bvh.get_contacts_parallel(threads);
+        ASSERT_EQ(parallel.size(), serial.size());
+        for (std::size_t i = 0; i < serial.size(); ++i) {
+            const auto &a = serial.get_records()[i];
+            const auto &b = parallel.get_records()[i];
+            EXPECT_EQ(a.first_id, b.first_id);
+            EXPECT_EQ(a.second_id, b.second_id);
+            ASSERT_EQ(a.size, b.size);
+            for (std::size_t k = 0; k < a.size; ++k)
+                EXPECT_EQ(serial.get_vertices(a)[k], parallel.get_vertices(b)[k]);
+        }
+    }
+}
+
+TEST(BVH, ContactsOnEmptyTree) {
+    BVHD bvh(std::vector<Tri>{});
+    bvh.build();
+
+    EXPECT_TRUE(bvh.get_contacts().empty());
+    EXPECT_TRUE(bvh.get_contacts_parallel(4).empty());
+}
+
+TEST(BVH, MixedPrecisionMatchesDouble) {
+    std::mt19937 gen(35);
+    std::uniform_real_distribution<float> coord(0.0f, 20.0f);
+    std::uniform_real_distribution<float> offset(-1.5f, 1.5f);
+
+    std::vector<triangle::Triangle<float>> triangles;
+    std::vector<Tri> wide;
+    for (std::size_t i = 0; i < 600; ++i) {
+        Point<float> base{coord(gen), coord(gen), coord(gen)};
+        auto near = [&] { return Point<float>{base.x_ + offset(gen), base.y_ + offset(gen), base.z_ + offset(gen)}; };
+        triangles.emplace_back(near(), near(), near(), i);
+        wide.push_back(widen(triangles.back()));
+    }
+    triangles.emplace_back(Point<float>{1,1,1}, Point<float>{3,1,1}, Point<float>{1,3,1}, 600);
+    triangles.emplace_back(Point<float>{1.5f,1.5f,1}, Point<float>{2,1.5f,1}, Point<float>{1.5f,2,1}, 601);
+    wide.push_back(widen(triangles[600]));
+    wide.push_back(widen(triangles[601]));
+
+    bin_tree::BVH<float> bvh(std::move(triangles));
+    bvh.build();
+    BVHD reference(std::move(wide));
+    reference.build();
+
+    EXPECT_EQ(bvh.get_intersecting_triangles_mixed(), reference.get_intersecting_triangles());
+
+    const auto &counters = bvh.get_escalation_counters();
+    EXPECT_GT(counters.pairs, 0u);
+    EXPECT_GE(counters.band + counters.branch, 1u);
+    EXPECT_LE(counters.escalated(), counters.pairs);
+}
+
+TEST(BVH, IndexedMeshMatchesSoup) {
+    std::mt19937 gen(37);
+    std::uniform_real_distribution<double> coord(0.0, 12.0);
+    std::uniform_int_distribution<std::size_t> pick(0, 399);
+
+    std::vector<P> points;
+    for (int i = 0; i < 400; ++i)
+        points.push_back(P{coord(gen), coord(gen), coord(gen)});
+
+    TriangleStore<double> soup;
+    for (std::size_t i = 0; i < 300; ++i) {
+        const std::size_t a = pick(gen);
+        const std::size_t b = i % 50 == 0 ? a : pick(gen); // some segments and points
+        soup.push_back(points[a], points[b], points[i % 70 == 0 ? a : pick(gen)], i);
+    }
+    TriangleStore<double> copy = soup;
+
+    bin_tree::BVH<double, IndexedMesh<double>> mesh_bvh(weld_vertices(soup, 3));
+    mesh_bvh.build();
+    BVHD soup_bvh(std::move(copy));
+    soup_bvh.build();
+
+    const auto expected = soup_bvh.get_intersecting_triangles();
+    EXPECT_FALSE(expected.empty());
+    EXPECT_EQ(mesh_bvh.get_intersecting_triangles(), expected);
+    EXPECT_EQ(mesh_bvh.get_intersecting_triangles_pipelined(), expected);
+    EXPECT_EQ(mesh_bvh.get_contacts().size(), soup_bvh.get_contacts().size());
+}
+
+TEST(BVH, ViewMatchesStoreWithoutTouchingTriangles) {
+    std::mt19937 gen(40);
+    std::uniform_real_distribution<double> coord(0.0, 10.0);
+    std::uniform_real_distribution<double> offset(-1.0, 1.0);
+
+    std::vector<Tri> triangles;
+    for (std::size_t i = 0; i < 300; ++i) {
+        const P a{coord(gen), coord(gen), coord(gen)};
+        const P b = i % 40 == 0 ? a : P{a.x_ + offset(gen), a.y_ + offset(gen), a.z_};
+        triangles.emplace_back(a, b, P{a.x_, a.y_ + offset(gen), a.z_ + offset(gen)}, 1000 + i);
+    }
+    const std::vector<Tri> original = triangles;
+
+    bin_tree::BVH<double, TriangleView<double>> view_bvh{TriangleView<double>(triangles)};
+    view_bvh.build();
+    BVHD store_bvh{TriangleStore<double>(triangles)};
+    store_bvh.build();
+
+    const auto expected = store_bvh.get_intersecting_triangles();
+    EXPECT_FALSE(expected.empty());
+    EXPECT_EQ(view_bvh.get_intersecting_triangles(), expected);
+    EXPECT_EQ(view_bvh.get_intersecting_triangles_pipelined(), expected);
+    EXPECT_EQ(view_bvh.get_contacts().size(), store_bvh.get_contacts().size());
+
+    ASSERT_EQ(triangles.size(), original.size());
+    for (std::size_t i = 0; i < triangles.size(); ++i) {
+        EXPECT_EQ(triangles[i].get_id(), original[i].get_id());
+        EXPECT_EQ(triangles[i].get_vertices(), original[i].get_vertices());
+    }
+}
+
+TEST(BVH, BuildWithKnownBox) {
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> coord(0.0, 10.0);
+
+    TriangleStore<double> triangles;
+    bounding_box::AABB<double> box;
+    for (std::size_t i = 0; i < 200; ++i) {
+        const Tri tr(P{coord(gen), coord(gen), coord(gen)}, P{coord(gen), coord(gen), coord(gen)},
+                     P{coord(gen), coord(gen), coord(gen)}, i);
+        triangles.push_back(tr.get_vertices()[0], tr.get_vertices()[1], tr.get_vertices()[2], i);
+        box.wrap_in_box_with(tr.get_box());
+    }
+    TriangleStore<double> copy = triangles;
+
+    BVHD with_box(std::move(triangles));
+    with_box.build(box);
+    BVHD without_box(std::move(copy));
+    without_box.build();
+
+    EXPECT_EQ(with_box.get_intersecting_triangles(), without_box.get_intersecting_triangles());
+    EXPECT_TRUE(std::ranges::equal(with_box.get_triangles().get_xs(),
+                                   without_box.get_triangles().get_xs()));
+}
+
+TEST(BVH, BuildWithPrecomputedArrays) {
+    std::mt19937 gen(43);
+    std::uniform_real_distribution<double> coord(0.0, 10.0);
+
+    TriangleStore<double> triangles;
+    for (std::size_t i = 0; i < 200; ++i)
+        triangles.push_back(P{coord(gen), coord(gen), coord(gen)},
+                            P{coord(gen), coord(gen), coord(gen)},
+                            P{coord(gen), coord(gen), coord(gen)}, i);
+    const bin_tree::BuildArrays<double> arrays(triangles);
+    bounding_box::AABB<double> box;
+    for (const auto &triangle_box : arrays.boxes)
+        box.wrap_in_box_with(triangle_box);
+    TriangleStore<double> copy = triangles;
+
+    BVHD with_arrays(std::move(triangles));
+    with_arrays.build(arrays, box);
+    BVHD without_arrays(std::move(copy));
+    without_arrays.build();
+
+    EXPECT_EQ(with_arrays.get_intersecting_triangles(),
+              without_arrays.get_intersecting_triangles());
+    EXPECT_TRUE(std::ranges::equal(with_arrays.get_triangles().get_xs(),
+                                   without_arrays.get_triangles().get_xs()));
+
+    BVHD mismatched{TriangleStore<double>()};
+    EXPECT_THROW(mismatched.build(arrays, box), std::invalid_argument);
+}
+
+TEST(BVH, CountedQueryMatchesAndCounts) {
+    std::mt19937 gen(44);
+    std::uniform_real_distribution<double> coord(0.0, 10.0);
+    std::uniform_real_distribution<double> offset(-1.0, 1.0);
+
+    std::vector<Tri> triangles;
+    for (std::size_t i = 0; i < 400; ++i) {
+        P base{coord(gen), coord(gen), coord(gen)};
+        auto near = [&] { return P{base.x_ + offset(gen), base.y_ + offset(gen), base.z_ + offset(gen)}; };
+        if (i % 10 == 0)
+            triangles.emplace_back(base, base, base, i); // point
+        else if (i % 10 == 1)
+            triangles.emplace_back(base, near(), base, i); // segment
+        else
+            triangles.emplace_back(near(), near(), near(), i);
+    }
+    std::vector<Tri> copy = triangles;
+
+    std::size_t intersecting_pairs = 0;
+    for (std::size_t i = 0; i < triangles.size(); ++i)
+        for (std::size_t j = i + 1; j < triangles.size(); ++j)
+            intersecting_pairs += intersect(triangles[i], triangles[j]);
+
+    BVHD bvh(std::move(triangles));
+    bvh.build();
+    bin_tree::QueryCounters counters;
+    const std::set<std::size_t> counted = bvh.get_intersecting_triangles_counted(counters);
+    BVHD uncounted(std::move(copy));
+    uncounted.build();
+    EXPECT_EQ(counted, uncounted.get_intersecting_triangles());
+
+    EXPECT_EQ(counters.hits, intersecting_pairs);
+    EXPECT_GT(counters.narrowphase_calls(), counters.hits);
+    EXPECT_GT(counters.point_pairs + counters.segment_segment_pairs +
+                  counters.triangle_segment_pairs, 0u);
+    EXPECT_GT(counters.get_triangle_pairs(triangle::Sign::different), 0u);
+    EXPECT_EQ(counters.box_tests_passed + counters.box_tests_failed, counters.node_pairs());
+    EXPECT_GE(counters.box_tests_passed, counters.leaf_pairs);
+
+    const bin_tree::TreeShape shape = bvh.get_tree_shape();
+    EXPECT_EQ(shape.triangles, 400u);
+    EXPECT_EQ(shape.nodes, 2 * shape.leaves - 1);
+    EXPECT_GE(shape.leaves, 400u / bin_tree::max_number_of_triangles_in_leaf);
+    EXPECT_GE(shape.depth, 8u);
+
+    BVHD empty(std::vector<Tri>{});
+    empty.build();
+    EXPECT_TRUE(empty.get_intersecting_triangles_counted(counters).empty());
+    EXPECT_EQ(counters.node_pairs(), 0u);
+    EXPECT_EQ(empty.get_tree_shape().nodes, 0u);
+}
+
+TEST(BVH, BuildSplitsAlongTheLongestAxis) {
+    // a row of disjoint triangles along x, all alike in y and z: splits along x give leaves
+    // that only overlap their neighbours, splits along y or z give leaves spread over the row
+    constexpr std::size_t count = 512;
+    std::vector<Tri> row;
+    for (std::size_t i = 0; i < count; ++i) {
+        const double x = 2.0 * static_cast<double>(i);
+        row.emplace_back(P{x, 0, 0}, P{x + 1, 0, 0}, P{x, 1, 1}, i);
+    }
+
+    BVHD bvh(std::move(row));
+    bvh.build();
+    bin_tree::QueryCounters counters;
+    EXPECT_TRUE(bvh.get_intersecting_triangles_counted(counters).empty());
+
+    EXPECT_LT(counters.node_pairs(), 2 * count);
+    EXPECT_LE(counters.narrowphase_calls(), count);
+}
@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "candidate_pairs.hpp"
+
+using bin_tree::BoundedQueue;
+using bin_tree::CandidateBatch;
+
+// ------------------------------- CandidateBatch -------------------------------
+
+TEST(candidate_pairs, BatchStartsEmpty) {
+    CandidateBatch batch;
+
+    EXPECT_TRUE(batch.empty());
+    EXPECT_FALSE(batch.full());
+    EXPECT_EQ(batch.get_pairs().size(), 0u);
+}
+
+TEST(candidate_pairs, BatchStoresPairsInOrder) {
+    CandidateBatch batch;
+    batch.push(1, 2);
+    batch.push(3, 4);
+
+    auto pairs = batch.get_pairs();
+    ASSERT_EQ(pairs.size(), 2u);
+    EXPECT_EQ(pairs[0].first, 1u);
+    EXPECT_EQ(pairs[0].second, 2u);
+    EXPECT_EQ(pairs[1].first, 3u);
+    EXPECT_EQ(pairs[1].second, 4u);
+}
+
+TEST(candidate_pairs, BatchBecomesFullAndClears) {
+    CandidateBatch batch;
+    for (std::uint32_t i = 0; i < bin_tree::candidate_batch_size; ++i)
+        batch.push(i, i + 1);
+
+    EXPECT_TRUE(batch.full());
+
+    batch.clear();
+    EXPECT_TRUE(batch.empty());
+}
+
+// -------------------------------- BoundedQueue --------------------------------
+
+TEST(candidate_pairs, QueueZeroCapacityThrows) {
+    EXPECT_THROW(BoundedQueue<int>(0), std::invalid_argument);
+}
+
+TEST(candidate_pairs, QueueDrainsAfterClose) {
+    BoundedQueue<int> queue(4);
+    EXPECT_TRUE(queue.push(1));
+    EXPECT_TRUE(queue.push(2));
+    queue.close();
+
+    EXPECT_FALSE(queue.push(3));
+    EXPECT_EQ(queue.pop(), 1);
+    EXPECT_EQ(queue.pop(), 2);
+    EXPECT_EQ(queue.pop(), std::nullopt);
+}
+
+TEST(candidate_pairs, QueueTransfersItemsBetweenThreads) {
+    BoundedQueue<std::unique_ptr<int>> queue(2);
+    const int count = 1000;
+
+    std::thread producer([&] {
+        for (int i = 0; i < count; ++i)
+            queue.push(std::make_unique<int>(i));
+        queue.close();
+    });
+
+    int expected = 0;
+    while (auto item = queue.pop()) {
+        EXPECT_EQ(**item, expected);
+        ++expected;
+    }
+    producer.join();
+
+    EXPECT_EQ(expected, count);
+}
@@ -25,7 +25,7 @@ TEST(node, DefaultConstruction) {
     NodeD node;
 
     EXPECT_EQ(node.get_number_of_triangles(), 0u);
-    EXPECT_EQ(node.get_triangles().size(), 0u);
+    EXPECT_EQ(node.get_first_triangle(), 0u);
     EXPECT_EQ(node.get_left().get(),  nullptr);
     EXPECT_EQ(node.get_right().get(), nullptr);
 }
@@ -33,10 +33,10 @@ TEST(node, DefaultConstruction) {
 TEST(node, SetTrianglesMakesLeafLikeState) {
     NodeD node;
     auto triangles = make_triangles();
-    node.set_triangles(std::span<Tri>(triangles));
+    node.set_triangles(0, static_cast<std::uint32_t>(triangles.size()));
 
     EXPECT_EQ(node.get_number_of_triangles(), 2u);
-    EXPECT_EQ(node.get_triangles().size(), 2u);
+    EXPECT_EQ(node.get_first_triangle(), 0u);
     EXPECT_EQ(node.get_left().get(),  nullptr);
     EXPECT_EQ(node.get_right().get(), nullptr);
 }
@@ -70,15 +70,13 @@ TEST(node, AABBManagement) {
     EXPECT_DOUBLE_EQ(result.p_max.z_, 1.0);
 }
 
-TEST(node, TriangleSpanIntegrity) {
+TEST(node, TriangleRangeIntegrity) {
     NodeD node;
-    auto triangles = make_triangles();
-    node.set_triangles(std::span<Tri>(triangles));
+    node.set_triangles(/*first=*/5, /*count=*/2);
 
-    auto span = node.get_triangles();
-    ASSERT_EQ(span.size(), 2u);
-    EXPECT_EQ(span[0].get_id(), 1u);
-    EXPECT_EQ(span[1].get_id(), 2u);
+    EXPECT_EQ(node.get_first_triangle(), 5u);
+    EXPECT_EQ(node.get_number_of_triangles(), 2u);
+    EXPECT_EQ(node.get_left().get(),  nullptr);
 }
 
 TEST(node, StateTransitions_NoCrashOnSettingSingleChild) {
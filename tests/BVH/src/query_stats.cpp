@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include "query_stats.hpp"
+
+using bin_tree::StatsFormat;
+using triangle::Sign;
+
+// --------------------------------------------------------------------------------------
+//                           Tests the --stats report
+// --------------------------------------------------------------------------------------
+
+namespace {
+
+bin_tree::QueryStats make_stats() {
+    bin_tree::QueryStats stats;
+    stats.timings.add("load", 0.5);
+    stats.timings.add("query \"counted\"", 2);
+    stats.tree = {10, 7, 4, 3};
+    stats.counters.box_tests_passed = 6;
+    stats.counters.box_tests_failed = 2;
+    stats.counters.leaf_pairs = 3;
+    stats.counters.triangle_pairs[static_cast<std::size_t>(Sign::pozitive)] = 4;
+    stats.counters.triangle_pairs[static_cast<std::size_t>(Sign::different)] = 1;
+    stats.counters.point_pairs = 2;
+    stats.counters.hits = 2;
+    return stats;
+}
+
+} // namespace
+
+TEST(QueryStats, Counters) {
+    const bin_tree::QueryStats stats = make_stats();
+    EXPECT_EQ(stats.counters.node_pairs(), 8u);
+    EXPECT_EQ(stats.counters.narrowphase_calls(), 7u);
+    EXPECT_EQ(stats.counters.get_triangle_pairs(Sign::pozitive), 4u);
+    EXPECT_EQ(stats.counters.get_triangle_pairs(Sign::common_plane), 0u);
+}
+
+TEST(QueryStats, Text) {
+    std::ostringstream os;
+    bin_tree::print_stats(os, make_stats(), StatsFormat::text);
+    const std::string text = os.str();
+
+    EXPECT_NE(text.find("load"), std::string::npos);
+    EXPECT_NE(text.find("tree: 10 triangles, 7 nodes, 4 leaves, depth 3\n"), std::string::npos);
+    EXPECT_NE(text.find("broadphase: 8 node pairs, 6 box tests passed, 2 failed, 3 leaf pairs\n"),
+              std::string::npos);
+    EXPECT_NE(text.find("narrowphase: 7 calls, 2 hits\n"), std::string::npos);
+    EXPECT_NE(text.find("4 separated (positive)"), std::string::npos);
+    EXPECT_NE(text.find("1 edges tested"), std::string::npos);
+}
+
+TEST(QueryStats, Json) {
+    std::ostringstream os;
+    bin_tree::print_stats(os, make_stats(), StatsFormat::json);
+
+    EXPECT_EQ(os.str(),
+              "{\"stages\":{\"load\":0.5,\"query \\\"counted\\\"\":2},"
+              "\"tree\":{\"triangles\":10,\"nodes\":7,\"leaves\":4,\"depth\":3},"
+              "\"broadphase\":{\"node_pairs\":8,\"box_tests_passed\":6,\"box_tests_failed\":2,"
+              "\"leaf_pairs\":3},"
+              "\"narrowphase\":{\"calls\":7,\"hits\":2,"
+              "\"triangle_pairs\":{\"separated_positive\":4,"
+              "\"separated_negative\":0,\"coplanar\":0,\"vertex_in_plane\":0,\"edges_tested\":1},"
+              "\"triangle_segment_pairs\":0,\"segment_segment_pairs\":0,\"point_pairs\":2}}\n");
+}
+
+TEST(QueryStats, ParseFormat) {
+    EXPECT_EQ(bin_tree::parse_stats_format("text"), StatsFormat::text);
+    EXPECT_EQ(bin_tree::parse_stats_format("json"), StatsFormat::json);
+    EXPECT_THROW(bin_tree::parse_stats_format("xml"), std::invalid_argument);
+}
@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+#include <random>
+
+#include "mixed_precision.hpp"
+#include "triangle.hpp"
+#include "triangle_to_triangle.hpp"
+#include "point.hpp"
+
+using namespace triangle;
+
+// --------------------------------------------------------------------------------------
+//                           Tests intersect_mixed
+// --------------------------------------------------------------------------------------
+
+using PF = Point<float>;
+using TF = Triangle<float>;
+
+TEST(intersect_mixed, WidenKeepsCoordinatesAndId) {
+    TF A{PF{0.1f,0.2f,0.3f}, PF{1,0,0}, PF{0,1,0}, 7};
+    auto wide = widen(A);
+
+    EXPECT_EQ(wide.get_id(), 7u);
+    EXPECT_EQ(wide.get_vertices()[0].x_, static_cast<double>(0.1f));
+    EXPECT_EQ(wide.get_type(), TypeTriangle::triangle);
+}
+
+TEST(intersect_mixed, ClearCasesStayInFloat) {
+    TF A{PF{0,0,0}, PF{4,0,0}, PF{0,4,0}};
+    TF crossing{PF{1,1,-1}, PF{3,1,-1}, PF{2,1,1}};
+    TF separated{PF{0,0,1}, PF{1,0,1}, PF{0,1,1}};
+
+    EscalationCounters counters;
+    EXPECT_TRUE(intersect_mixed(A, crossing, counters));
+    EXPECT_FALSE(intersect_mixed(A, separated, counters));
+    EXPECT_EQ(counters.pairs, 2u);
+    EXPECT_EQ(counters.escalated(), 0u);
+}
+
+TEST(intersect_mixed, CoplanarAndDegenerateAreEscalated) {
+    TF A{PF{0,0,0}, PF{2,0,0}, PF{0,2,0}};
+    TF B{PF{0.2f,0.2f,0}, PF{0.6f,0.2f,0}, PF{0.2f,0.6f,0}};
+    TF S{PF{1,1,-1}, PF{1,1,1}, PF{1,1,0.5f}};
+
+    EscalationCounters counters;
+    EXPECT_TRUE(intersect_mixed(A, B, counters));
+    EXPECT_TRUE(intersect_mixed(A, S, counters));
+    EXPECT_EQ(counters.band + counters.branch, 1u); // exact zeros are uncertain with exact predicates
+    EXPECT_EQ(counters.degenerate, 1u);
+}
+
+TEST(intersect_mixed, ValueAtTheThresholdIsEscalated) {
+    // the vertex of B lies at the threshold the float test compares against
+    const float h = predicates::exact_mode ? 0.0f : cmp::precision<float>::epsilon / 16.0f;
+    TF A{PF{0,0,0}, PF{4,0,0}, PF{0,4,0}};
+    TF B{PF{1,1,h}, PF{1,2,3}, PF{2,1,3}};
+
+    EscalationCounters counters;
+    EXPECT_EQ(intersect_mixed(A, B, counters), intersect(widen(A), widen(B)));
+    EXPECT_EQ(counters.band, 1u);
+}
+
+TEST(intersect_mixed, MatchesDoubleNarrowphase) {
+    std::mt19937 gen(35);
+    std::uniform_real_distribution<float> coord(-100.0f, 100.0f);
+    std::uniform_real_distribution<float> offset(-2.0f, 2.0f);
+    std::uniform_real_distribution<float> tiny(-1e-4f, 1e-4f);
+
+    EscalationCounters counters;
+    for (int i = 0; i < 20000; ++i) {
+        PF base{coord(gen), coord(gen), coord(gen)};
+        auto near = [&] { return PF{base.x_ + offset(gen), base.y_ + offset(gen), base.z_ + offset(gen)}; };
+        TF A{near(), near(), near()};
+
+        // every second pair touches: a vertex of B nudged off a point of A
+        const auto &a = A.get_vertices();
+        PF touch{(a[0].x_ + a[1].x_ + a[2].x_) / 3 + tiny(gen), (a[0].y_ + a[1].y_ + a[2].y_) / 3 + tiny(gen),
+                 (a[0].z_ + a[1].z_ + a[2].z_) / 3 + tiny(gen)};
+        TF B{i % 2 ? touch : near(), near(), near()};
+
+        ASSERT_EQ(intersect_mixed(A, B, counters), intersect(widen(A), widen(B))) << "pair " << i;
+    }
+    EXPECT_EQ(counters.pairs, 20000u);
+    EXPECT_GT(counters.escalated(), 0u);
+    EXPECT_LT(counters.escalated(), counters.pairs / 2);
+}
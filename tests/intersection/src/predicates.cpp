@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+#include <random>
+
+#include "common/predicates.hpp"
+#include "point.hpp"
+#include "triangle_to_triangle.hpp"
+
+using namespace triangle;
+
+// orient_3d of integer coordinates evaluated in 128-bit integers
+static int reference_sign(const Point<float> &a, const Point<float> &b, const Point<float> &c,
+                          const Point<float> &d) {
+    auto i = [](float v) { return static_cast<__int128>(v); };
+    __int128 bx = i(b.x_) - i(a.x_), by = i(b.y_) - i(a.y_), bz = i(b.z_) - i(a.z_);
+    __int128 cx = i(c.x_) - i(a.x_), cy = i(c.y_) - i(a.y_), cz = i(c.z_) - i(a.z_);
+    __int128 dx = i(d.x_) - i(a.x_), dy = i(d.y_) - i(a.y_), dz = i(d.z_) - i(a.z_);
+
+    __int128 det = (by * cz - bz * cy) * dx + (bz * cx - bx * cz) * dy + (bx * cy - by * cx) * dz;
+    return (det > 0) - (det < 0);
+}
+
+TEST(Predicates, SignConvention) {
+    Point<double> a(0, 0, 0), b(1, 0, 0), c(0, 1, 0);
+
+    EXPECT_EQ(predicates::orient_3d_exact(a, b, c, Point<double>(0.3, 0.3, 2)), 1);
+    EXPECT_EQ(predicates::orient_3d_exact(a, b, c, Point<double>(0.3, 0.3, -2)), -1);
+    EXPECT_EQ(predicates::orient_3d_exact(a, b, c, Point<double>(7, -5, 0)), 0);
+
+    EXPECT_GT(predicates::orient_3d_adaptive(a, b, c, Point<double>(0.3, 0.3, 2)), 0);
+    EXPECT_LT(predicates::orient_3d_adaptive(a, b, c, Point<double>(0.3, 0.3, -2)), 0);
+}
+
+TEST(Predicates, ExactOnLargeIntegerCoordinates) {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> coord(-(1 << 23), 1 << 23);
+    auto random_point = [&] {
+        return Point<float>(static_cast<float>(coord(gen)), static_cast<float>(coord(gen)),
+                            static_cast<float>(coord(gen)));
+    };
+
+    for (int i = 0; i < 2000; ++i) {
+        Point<float> a = random_point(), b = random_point(), c = random_point();
+        Point<float> d = random_point();
+        EXPECT_EQ(predicates::orient_3d_exact(a, b, c, d), reference_sign(a, b, c, d));
+        EXPECT_EQ(static_cast<int>(predicates::orient_3d_adaptive(a, b, c, d)),
+                  reference_sign(a, b, c, d));
+    }
+}
+
+TEST(Predicates, CoplanarPointsAreZero) {
+    std::mt19937 gen(7);
+    std::uniform_int_distribution<int> coord(-(1 << 10), 1 << 10);
+    std::uniform_int_distribution<int> step(-(1 << 5), 1 << 5);
+
+    for (int i = 0; i < 2000; ++i) {
+        // d = a + s (b - a) + t (c - a) is in the plane, every coordinate stays below 2^24
+        Point<float> a(coord(gen), coord(gen), coord(gen));
+        Point<float> b(coord(gen), coord(gen), coord(gen));
+        Point<float> c(coord(gen), coord(gen), coord(gen));
+        float s = step(gen), t = step(gen);
+        Point<float> d(a.x_ + s * (b.x_ - a.x_) + t * (c.x_ - a.x_),
+                       a.y_ + s * (b.y_ - a.y_) + t * (c.y_ - a.y_),
+                       a.z_ + s * (b.z_ - a.z_) + t * (c.z_ - a.z_));
+
+        ASSERT_EQ(reference_sign(a, b, c, d), 0);
+        EXPECT_EQ(predicates::orient_3d_exact(a, b, c, d), 0);
+        EXPECT_EQ(predicates::orient_3d_adaptive(a, b, c, d), 0.0f);
+
+        // one unit off the plane is never zero
+        Point<float> e(d.x_, d.y_, d.z_ + 1);
+        EXPECT_EQ(static_cast<int>(predicates::orient_3d_adaptive(a, b, c, e)),
+                  reference_sign(a, b, c, e));
+    }
+}
+
+TEST(Predicates, AdaptiveAgreesWithFloatOnClearCases) {
+    std::mt19937 gen(3);
+    std::uniform_real_distribution<double> coord(-10, 10);
+    auto random_point = [&] { return Point<double>(coord(gen), coord(gen), coord(gen)); };
+
+    for (int i = 0; i < 2000; ++i) {
+        Point<double> a = random_point(), b = random_point(), c = random_point();
+        Point<double> d = random_point();
+
+        Vector<double> ab(a, b), ac(a, c), ad(a, d);
+        double value = scalar_product(vector_product(ab, ac), ad);
+        if (std::abs(value) < 1e-3)
+            continue;
+
+        EXPECT_EQ(predicates::orient_3d_adaptive(a, b, c, d), value > 0 ? 1.0 : -1.0);
+        EXPECT_EQ(predicates::orient_3d_exact(a, b, c, d), value > 0 ? 1 : -1);
+    }
+}
@@ -0,0 +1,166 @@
+#include <gtest/gtest.h>
+#include <random>
+
+#include "contact.hpp"
+#include "triangle.hpp"
+#include "triangle_contact.hpp"
+#include "triangle_to_triangle.hpp"
+#include "point.hpp"
+
+using namespace triangle;
+
+// --------------------------------------------------------------------------------------
+//                           Tests intersection
+// --------------------------------------------------------------------------------------
+
+using PD = Point<double>;
+using TD = Triangle<double>;
+
+static bool has_vertex(const Contact<double> &contact, const PD &p) {
+    for (const auto &vertex : contact.get_vertices())
+        if (vertex == p)
+            return true;
+    return false;
+}
+
+TEST(intersection, DisjointIsEmpty) {
+    TD A{PD{0,0,0}, PD{1,0,0}, PD{0,1,0}};
+    TD B{PD{0,0,1}, PD{1,0,1}, PD{0,1,1}};
+
+    auto contact = intersection(A, B);
+    EXPECT_TRUE(contact.empty());
+    EXPECT_EQ(contact.get_type(), ContactType::none);
+}
+
+TEST(intersection, CrossingTrianglesGiveSegment) {
+    TD A{PD{0,0,0}, PD{4,0,0}, PD{0,4,0}};
+    TD B{PD{1,1,-1}, PD{3,1,-1}, PD{2,1,1}}; // in the plane y = 1
+
+    for (const auto &contact : {intersection(A, B), intersection(B, A)}) {
+        ASSERT_EQ(contact.get_type(), ContactType::segment);
+        EXPECT_TRUE(has_vertex(contact, PD{1.5,1,0}));
+        EXPECT_TRUE(has_vertex(contact, PD{2.5,1,0}));
+    }
+}
+
+TEST(intersection, SegmentClippedByBothTriangles) {
+    TD A{PD{0,0,0}, PD{2,0,0}, PD{0,2,0}};
+    TD B{PD{-1,0.5,-1}, PD{5,0.5,-1}, PD{-1,0.5,3}}; // crosses z = 0 on x in [-1, 3]
+
+    auto contact = intersection(A, B);
+    ASSERT_EQ(contact.get_type(), ContactType::segment);
+    EXPECT_TRUE(has_vertex(contact, PD{0,0.5,0}));
+    EXPECT_TRUE(has_vertex(contact, PD{1.5,0.5,0}));
+}
+
+TEST(intersection, TouchingVertexGivesPoint) {
+    TD A{PD{0,0,0}, PD{4,0,0}, PD{0,4,0}};
+    TD B{PD{1,1,0}, PD{1,1,2}, PD{2,1,2}};
+
+    auto contact = intersection(A, B);
+    ASSERT_EQ(contact.get_type(), ContactType::point);
+    EXPECT_EQ(contact.get_vertices()[0], (PD{1,1,0}));
+}
+
+TEST(intersection, CoplanarContainedTriangle) {
+    TD A{PD{0,0,0}, PD{2,0,0}, PD{0,2,0}};
+    TD B{PD{0.2,0.2,0}, PD{0.6,0.2,0}, PD{0.2,0.6,0}};
+
+    for (const auto &contact : {intersection(A, B), intersection(B, A)}) {
+        ASSERT_EQ(contact.get_type(), ContactType::polygon);
+        ASSERT_EQ(contact.size(), 3u);
+        for (const auto &vertex : B.get_vertices())
+            EXPECT_TRUE(has_vertex(contact, vertex));
+    }
+}
+
+TEST(intersection, CoplanarStarGivesHexagon) {
+    TD A{PD{0,0,0}, PD{6,0,0}, PD{3,6,0}};
+    TD B{PD{0,4,0}, PD{3,-2,0}, PD{6,4,0}};
+
+    auto contact = intersection(A, B);
+    ASSERT_EQ(contact.get_type(), ContactType::polygon);
+    EXPECT_EQ(contact.size(), 6u);
+    for (const auto &vertex : contact.get_vertices()) {
+        EXPECT_TRUE(point_inside_triangle(A, vertex));
+        EXPECT_TRUE(point_inside_triangle(B, vertex));
+    }
+}
+
+TEST(intersection, CoplanarSharedEdgeGivesSegment) {
+    TD A{PD{0,0,0}, PD{2,0,0}, PD{0,2,0}};
+    TD B{PD{0,0,0}, PD{2,0,0}, PD{0,-2,0}};
+
+    auto contact = intersection(A, B);
+    ASSERT_EQ(contact.get_type(), ContactType::segment);
+    EXPECT_TRUE(has_vertex(contact, PD{0,0,0}));
+    EXPECT_TRUE(has_vertex(contact, PD{2,0,0}));
+}
+
+TEST(intersection, SegmentThroughTriangleGivesPoint) {
+    TD A{PD{0,0,0}, PD{4,0,0}, PD{0,4,0}};
+    TD S{PD{1,1,-1}, PD{1,1,1}, PD{1,1,0.5}};
+
+    auto contact = intersection(A, S);
+    ASSERT_EQ(contact.get_type(), ContactType::point);
+    EXPECT_EQ(contact.get_vertices()[0], (PD{1,1,0}));
+}
+
+TEST(intersection, SegmentInPlaneIsClipped) {
+    TD A{PD{0,0,0}, PD{4,0,0}, PD{0,4,0}};
+    TD S{PD{-1,1,0}, PD{5,1,0}, PD{1,1,0}};
+
+    auto contact = intersection(S, A);
+    ASSERT_EQ(contact.get_type(), ContactType::segment);
+    EXPECT_TRUE(has_vertex(contact, PD{0,1,0}));
+    EXPECT_TRUE(has_vertex(contact, PD{3,1,0}));
+}
+
+TEST(intersection, CrossingAndOverlappingSegments) {
+    TD S1{PD{0,0,0}, PD{2,2,0}, PD{1,1,0}};
+    TD S2{PD{0,2,0}, PD{2,0,0}, PD{1,1,0}};
+    TD S3{PD{1,1,0}, PD{3,3,0}, PD{2,2,0}};
+
+    auto crossing = intersection(S1, S2);
+    ASSERT_EQ(crossing.get_type(), ContactType::point);
+    EXPECT_EQ(crossing.get_vertices()[0], (PD{1,1,0}));
+
+    auto overlapping = intersection(S1, S3);
+    ASSERT_EQ(overlapping.get_type(), ContactType::segment);
+    EXPECT_TRUE(has_vertex(overlapping, PD{1,1,0}));
+    EXPECT_TRUE(has_vertex(overlapping, PD{2,2,0}));
+}
+
+TEST(intersection, PointContact) {
+    TD A{PD{0,0,0}, PD{4,0,0}, PD{0,4,0}};
+    TD P{PD{1,1,0}, PD{1,1,0}, PD{1,1,0}};
+
+    auto contact = intersection(P, A);
+    ASSERT_EQ(contact.get_type(), ContactType::point);
+    EXPECT_EQ(contact.get_vertices()[0], (PD{1,1,0}));
+}
+
+TEST(intersection, EmptyExactlyWhenIntersectIsFalse) {
+    std::mt19937 gen(34);
+    std::uniform_real_distribution<double> coord(0.0, 10.0);
+    std::uniform_real_distribution<double> offset(-3.0, 3.0);
+
+    int hits = 0;
+    for (int i = 0; i < 3000; ++i) {
+        PD base{coord(gen), coord(gen), coord(gen)};
+        auto near = [&] { return PD{base.x_ + offset(gen), base.y_ + offset(gen), base.z_ + offset(gen)}; };
+        TD A{near(), near(), near()};
+        TD B{near(), near(), near()};
+
+        const bool expected = intersect(A, B);
+        auto contact = intersection(A, B);
+        ASSERT_EQ(contact.empty(), !expected);
+        hits += expected;
+
+        for (const auto &vertex : contact.get_vertices()) {
+            EXPECT_TRUE(point_inside_triangle(A, vertex));
+            EXPECT_TRUE(point_inside_triangle(B, vertex));
+        }
+    }
+    EXPECT_GT(hits, 100);
+}
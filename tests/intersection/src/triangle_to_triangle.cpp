@@ -298,3 +298,72 @@ TEST(intersect_3d, Coplanar_ProperEdgeCross) {
     EXPECT_TRUE(intersect(t1, t2));
     EXPECT_TRUE(intersect(t2, t1));
 }
+
+// --------------------------------------------------------------------------------------
+//                           Tests precomputed TrianglePlane
+// --------------------------------------------------------------------------------------
+
+TEST(TrianglePlane, OrientMatchesOrient3d) {
+    Triangle<float> tri(Point<float>(0.3f,-1.7f,2.9f), Point<float>(4.1f,0.2f,-0.6f), Point<float>(-2.2f,3.3f,1.1f));
+    TrianglePlane<float> plane(tri);
+    const auto &v = tri.get_vertices();
+
+    for (float t = -3.0f; t < 3.0f; t += 0.37f) {
+        Point<float> p(t, 1.3f * t - 0.5f, 2.0f - t);
+        EXPECT_EQ(plane.orient(tri, p), orient_3d(v[0], v[1], v[2], p));
+    }
+}
+
+TEST(TrianglePlane, PrecomputedIntersectMatches) {
+    Triangle<float> t1(Point<float>(0,0,0), Point<float>(2,0,0), Point<float>(0,2,0));
+    Triangle<float> t2(Point<float>(0.5,0.5,-1), Point<float>(0.5,0.5,1), Point<float>(2,2,2));
+    Triangle<float> t3(Point<float>(0,0,1), Point<float>(2,0,1), Point<float>(0,2,1));
+    TrianglePlane<float> p1(t1), p2(t2), p3(t3);
+
+    EXPECT_TRUE(intersect(t1, p1, t2, p2));
+    EXPECT_TRUE(intersect(t2, p2, t3, p3));
+    EXPECT_FALSE(intersect(t1, p1, t3, p3));
+}
+
+TEST(intersect_3d, TouchesInsideAtLastVertex) {
+    // only the third vertex of t2 lies in the plane of t1
+    Triangle<float> t1(Point<float>(0,0,0), Point<float>(2,0,0), Point<float>(0,2,0));
+    Triangle<float> t2(Point<float>(2,0,1), Point<float>(0,2,1), Point<float>(0.3,0.3,0));
+
+    EXPECT_TRUE(intersect(t1, t2));
+    EXPECT_TRUE(intersect(t2, t1));
+}
+
+TEST(intersect_3d, TouchesInsideAtMiddleVertex) {
+    Triangle<float> t1(Point<float>(0,0,0), Point<float>(2,0,0), Point<float>(0,2,0));
+    Triangle<float> t2(Point<float>(2,0,-1), Point<float>(0.3,0.3,0), Point<float>(0,2,-1));
+
+    EXPECT_TRUE(intersect(t1, t2));
+    EXPECT_TRUE(intersect(t2, t1));
+}
+
+TEST(intersect_3d, BranchMatchesCheckRelativePositions) {
+    const Triangle<double> base(Point<double>(0, 0, 0), Point<double>(2, 0, 0),
+                                Point<double>(0, 2, 0));
+    const Triangle<double> others[] = {
+        Triangle<double>(Point<double>(0, 0, 1), Point<double>(1, 0, 1), Point<double>(0, 1, 2)),
+        Triangle<double>(Point<double>(0, 0, -1), Point<double>(1, 0, -1), Point<double>(0, 1, -2)),
+        Triangle<double>(Point<double>(1, 0, 0), Point<double>(3, 0, 0), Point<double>(1, 2, 0)),
+        Triangle<double>(Point<double>(0.5, 0.5, 0), Point<double>(1, 0, 1),
+                         Point<double>(0, 1, 1)),
+        Triangle<double>(Point<double>(0.5, 0.5, -1), Point<double>(0.5, 0.5, 1),
+                         Point<double>(3, 3, 0))};
+
+    for (const Triangle<double> &other : others) {
+        Sign branch = Sign::different;
+        int calls = 0;
+        const bool hit = intersect_triangles(base, TrianglePlane<double>(base), other,
+                                             TrianglePlane<double>(other), [&](Sign decided) {
+                                                 branch = decided;
+                                                 ++calls;
+                                             });
+        EXPECT_EQ(calls, 1);
+        EXPECT_EQ(branch, check_relative_positions(base, other));
+        EXPECT_EQ(hit, intersect(base, other));
+    }
+}
@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include <random>
 
 #include "triangle.hpp"
 #include "triangle_to_triangle.hpp"
@@ -92,3 +93,41 @@ TEST(intersect_2d, Disjoint_CloseButSeparated) {
     EXPECT_FALSE(intersect_2d(A, B));
     EXPECT_FALSE(intersect_2d(B, A));
 }
+
+TEST(intersect_2d, ProjectionMatchesMixedProduct) {
+    std::mt19937 gen(17);
+    std::uniform_real_distribution<double> coord(-3.0, 3.0);
+
+    // random triangles in planes of every orientation, including axis-aligned ones
+    const Vector<double> normals[] = {{0, 0, 1}, {0, -1, 0}, {1, 0, 0}, {0.3, -0.8, 0.5}, {-2, 1, 0.1}};
+    for (const auto &n : normals) {
+        Vector<double> e_1 = vector_product(n, Vector<double>(0.3, 0.1, 0.7));
+        Vector<double> e_2 = vector_product(n, e_1);
+        auto point = [&] {
+            double s = coord(gen), t = coord(gen);
+            return Point<double>(e_1.x_ * s + e_2.x_ * t, e_1.y_ * s + e_2.y_ * t, e_1.z_ * s + e_2.z_ * t);
+        };
+
+        int hits = 0;
+        for (int i = 0; i < 500; ++i) {
+            Triangle<double> A{point(), point(), point()};
+            Triangle<double> B{point(), point(), point()};
+            const auto &v = A.get_vertices();
+            Vector<double> normal = vector_product(Vector(v[0], v[1]), Vector(v[0], v[2]));
+
+            bool projected = intersect_2d(A, B, normal);
+            EXPECT_EQ(projected, detail::intersect_2d_mixed_product(A, B, normal));
+            hits += projected;
+        }
+        EXPECT_GT(hits, 0);
+        EXPECT_LT(hits, 500);
+    }
+}
+
+TEST(intersect_2d, ZeroNormalFallsBackToMixedProduct) {
+    Triangle<float> A{ P(0,0), P(1,1), P(2,2) };
+    Triangle<float> B{ P(5,5), P(6,5), P(5,6) };
+    Vector<float> zero(0, 0, 0);
+
+    EXPECT_EQ(intersect_2d(A, B, zero), detail::intersect_2d_mixed_product(A, B, zero));
+}
@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+#include "triangle.hpp"
+#include "triangle_to_triangle.hpp"
+#include "triangle_to_triangle_batch.hpp"
+#include "point.hpp"
+
+using namespace triangle;
+
+struct IndexPair {
+    std::size_t first;
+    std::size_t second;
+};
+
+// mix of general position, shared planes, shared vertices and degenerate triangles
+static std::vector<Triangle<float>> make_random_triangles(std::size_t count, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<float> coord(-2.0f, 2.0f);
+    std::uniform_int_distribution<int> grid(-2, 2);
+    std::uniform_int_distribution<int> kind(0, 9);
+
+    std::vector<Triangle<float>> triangles;
+    for (std::size_t i = 0; i < count; ++i) {
+        auto random_point = [&] { return Point<float>(coord(gen), coord(gen), coord(gen)); };
+        auto grid_point = [&] {
+            return Point<float>(static_cast<float>(grid(gen)), static_cast<float>(grid(gen)), 0);
+        };
+
+        switch (kind(gen)) {
+        case 0: // coplanar with z = 0
+            triangles.emplace_back(grid_point(), grid_point(), grid_point(), i);
+            break;
+        case 1: // one vertex in z = 0
+            triangles.emplace_back(grid_point(), random_point(), random_point(), i);
+            break;
+        case 2: { // segment
+            auto a = random_point();
+            triangles.emplace_back(a, a, random_point(), i);
+            break;
+        }
+        case 3: { // point
+            auto a = random_point();
+            triangles.emplace_back(a, a, a, i);
+            break;
+        }
+        default:
+            triangles.emplace_back(random_point(), random_point(), random_point(), i);
+        }
+    }
+    return triangles;
+}
+
+TEST(intersect_batch, MatchesScalarOnAllPairs) {
+    auto triangles = make_random_triangles(120, 42);
+
+    std::vector<IndexPair> pairs;
+    for (std::size_t i = 0; i < triangles.size(); ++i)
+        for (std::size_t j = i + 1; j < triangles.size(); ++j)
+            pairs.push_back({i, j});
+
+    std::vector<char> batched(pairs.size(), 0);
+    intersect_pairs<float>(triangles, std::span<const IndexPair>(pairs), [&](const IndexPair &pair) {
+        batched[static_cast<std::size_t>(&pair - pairs.data())] = 1;
+    });
+
+    std::size_t hits = 0;
+    for (std::size_t k = 0; k < pairs.size(); ++k) {
+        const bool expected = intersect(triangles[pairs[k].first], triangles[pairs[k].second]);
+        hits += expected;
+        EXPECT_EQ(static_cast<bool>(batched[k]), expected) << "pair " << pairs[k].first << ", " << pairs[k].second;
+    }
+    EXPECT_GT(hits, 0u);
+}
+
+TEST(intersect_batch, PartialBatch) {
+    std::vector<Triangle<float>> triangles = {
+        Triangle<float>(Point<float>(0,0,0), Point<float>(2,0,0), Point<float>(0,2,0), 0),
+        Triangle<float>(Point<float>(0.5,0.5,-1), Point<float>(0.5,0.5,1), Point<float>(2,2,2), 1),
+        Triangle<float>(Point<float>(0,0,1), Point<float>(2,0,1), Point<float>(0,2,1), 2)
+    };
+    std::vector<IndexPair> pairs = {{0, 1}, {0, 2}, {1, 2}};
+
+    std::vector<IndexPair> hits;
+    intersect_pairs<float>(triangles, std::span<const IndexPair>(pairs),
+                           [&](const IndexPair &pair) { hits.push_back(pair); });
+
+    ASSERT_EQ(hits.size(), 2u);
+    EXPECT_EQ(hits[0].first, 0u);
+    EXPECT_EQ(hits[0].second, 1u);
+    EXPECT_EQ(hits[1].first, 1u);
+    EXPECT_EQ(hits[1].second, 2u);
+}
+
+TEST(intersect_batch, EmptyInput) {
+    std::vector<Triangle<double>> triangles;
+    std::vector<IndexPair> pairs;
+
+    std::size_t hits = 0;
+    intersect_pairs<double>(triangles, std::span<const IndexPair>(pairs),
+                            [&](const IndexPair &) { ++hits; });
+
+    EXPECT_EQ(hits, 0u);
+}
@@ -0,0 +1,157 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "binary_format.hpp"
+#include "indexed_mesh.hpp"
+#include "triangle_store.hpp"
+
+using namespace triangle;
+
+// --------------------------------------------------------------------------------------
+//                           Tests binary input
+// --------------------------------------------------------------------------------------
+
+namespace {
+
+TriangleStore<double> make_store() {
+    TriangleStore<double> store;
+    store.push_back(Point<double>(0, 0, 0), Point<double>(1, 0, 0), Point<double>(0, 1, 0), 0);
+    store.push_back(Point<double>(1, 0, 0), Point<double>(0, 1, 0), Point<double>(0.1, 0.2, 5), 1);
+    store.push_back(Point<double>(-3, 2, 1), Point<double>(-3, 2, 1), Point<double>(-3, 2, 1), 2);
+    store.push_back(Point<double>(7, 8, 9), Point<double>(1, 0, 0), Point<double>(2, -4, 0.5), 3);
+    return store;
+}
+
+template <typename Stored, typename Mesh> std::string to_binary(const Mesh &mesh) {
+    std::ostringstream os;
+    io::write_binary<Stored>(os, mesh);
+    return os.str();
+}
+
+template <typename T> TriangleStore<T> parse(std::string_view data) {
+    TriangleStore<T> store;
+    io::parse_binary_input<T>(
+        data, [&](std::size_t n) { store.reserve(n); },
+        [&](const Point<T> &p0, const Point<T> &p1, const Point<T> &p2, std::size_t id) {
+            store.push_back(p0, p1, p2, id);
+        });
+    return store;
+}
+
+template <typename T, typename U>
+void expect_same_triangles(const TriangleStore<T> &a, const TriangleStore<U> &b) {
+    ASSERT_EQ(a.size(), b.size());
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        EXPECT_EQ(a.get_id(i), b.get_id(i));
+        EXPECT_EQ(a.get_type(i), b.get_type(i));
+        for (std::size_t k = 0; k < 3; ++k) {
+            EXPECT_EQ(a.get_vertex(i, k).x_, static_cast<T>(b.get_vertex(i, k).x_));
+            EXPECT_EQ(a.get_vertex(i, k).y_, static_cast<T>(b.get_vertex(i, k).y_));
+            EXPECT_EQ(a.get_vertex(i, k).z_, static_cast<T>(b.get_vertex(i, k).z_));
+        }
+    }
+}
+
+} // namespace
+
+TEST(BinaryInput, Header) {
+    const std::string data = to_binary<float>(make_store());
+    ASSERT_TRUE(io::is_binary_input(data));
+    EXPECT_FALSE(io::is_binary_input("4\n0 0 0 1 0 0 0 1 0"));
+    EXPECT_EQ(data.size(), 32 + 4 * 9 * sizeof(float));
+
+    const io::BinaryInput input(data);
+    EXPECT_EQ(input.size(), 4u);
+    EXPECT_EQ(input.header().precision, 4u);
+    EXPECT_EQ(input.header().layout, io::BinaryLayout::soup);
+    EXPECT_EQ(input.header().vertex_count, 12u);
+}
+
+TEST(BinaryInput, SoupRoundTrip) {
+    const TriangleStore<double> store = make_store();
+
+    expect_same_triangles(parse<double>(to_binary<double>(store)), store);
+    expect_same_triangles(parse<float>(to_binary<float>(store)), store);
+    // a double file read as float and a float file read as double: the float values
+    expect_same_triangles(parse<float>(to_binary<double>(store)),
+                          parse<double>(to_binary<float>(store)));
+}
+
+TEST(BinaryInput, ReadIntoStoreWithBox) {
+    const TriangleStore<double> store = make_store();
+    const std::string data = to_binary<double>(store);
+
+    for (std::size_t threads : {1u, 3u}) {
+        const io::LoadedTriangles<double> loaded = io::read_binary_input<double>(data, threads);
+        expect_same_triangles(loaded.triangles, store);
+
+        bounding_box::AABB<double> box;
+        for (std::size_t i = 0; i < store.size(); ++i)
+            box.wrap_in_box_with(store.get_box(i));
+        EXPECT_EQ(loaded.box.p_min, box.p_min);
+        EXPECT_EQ(loaded.box.p_max, box.p_max);
+    }
+}
+
+TEST(BinaryInput, IndexedRoundTrip) {
+    const TriangleStore<double> store = make_store();
+    const IndexedMesh<double> mesh = weld_vertices(store, 1);
+    const std::string data = to_binary<double>(mesh);
+
+    const io::BinaryInput input(data);
+    EXPECT_EQ(input.header().layout, io::BinaryLayout::indexed);
+    EXPECT_EQ(input.header().vertex_count, mesh.get_number_of_vertices());
+    EXPECT_EQ(data.size(), 32 + mesh.get_number_of_vertices() * 3 * sizeof(double) + 4 * 3 * 4);
+
+    expect_same_triangles(parse<double>(data), store);
+    expect_same_triangles(io::read_binary_input<double>(data, 2).triangles, store);
+}
+
+TEST(BinaryInput, ViewInPlace) {
+    const TriangleStore<float> store = parse<float>(to_binary<float>(make_store()));
+    const std::string data = to_binary<float>(store);
+    const io::BinaryInput input(data);
+
+    const TriangleView<float> view = input.view<float>();
+    ASSERT_EQ(view.size(), store.size());
+    EXPECT_EQ(view.get_xs().data(), input.coordinates<float>().data());
+    for (std::size_t i = 0; i < view.size(); ++i) {
+        EXPECT_EQ(view.get_id(i), i);
+        EXPECT_EQ(view.get_type(i), store.get_type(i));
+        for (std::size_t k = 0; k < 3; ++k)
+            EXPECT_EQ(view.get_vertex(i, k), store.get_vertex(i, k));
+    }
+
+    EXPECT_THROW(input.view<double>(), std::invalid_argument);
+    const std::string indexed = to_binary<float>(weld_vertices(store, 1));
+    EXPECT_THROW(io::BinaryInput(indexed).view<float>(), std::invalid_argument);
+}
+
+TEST(BinaryInput, Errors) {
+    const std::string data = to_binary<float>(make_store());
+
+    EXPECT_THROW(io::BinaryInput{std::string_view(data).substr(0, 20)}, std::runtime_error);
+    EXPECT_THROW(io::BinaryInput{std::string_view(data).substr(0, data.size() - 1)},
+                 std::runtime_error);
+    EXPECT_THROW(parse<float>("4\n0 0 0 1 0 0 0 1 0"), std::runtime_error);
+
+    std::string bad_version = data;
+    bad_version[8] = 2;
+    EXPECT_THROW(io::BinaryInput{bad_version}, std::runtime_error);
+
+    std::string bad_precision = data;
+    bad_precision[12] = 2;
+    EXPECT_THROW(io::BinaryInput{bad_precision}, std::runtime_error);
+
+    // an index past the vertex buffer
+    std::string bad_index = to_binary<float>(weld_vertices(make_store(), 1));
+    const std::uint32_t index = 1000;
+    std::memcpy(bad_index.data() + bad_index.size() - 4, &index, 4);
+    EXPECT_THROW(parse<float>(bad_index), std::runtime_error);
+    EXPECT_THROW(io::read_binary_input<float>(bad_index, 2), std::runtime_error);
+}
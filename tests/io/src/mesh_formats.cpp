@@ -0,0 +1,215 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "input_format.hpp"
+#include "triangle_store.hpp"
+
+using namespace triangle;
+
+// --------------------------------------------------------------------------------------
+//                           Tests STL, OBJ and PLY input
+// --------------------------------------------------------------------------------------
+
+namespace {
+
+// a unit square in z = 0 and a pentagon, both to be fan-triangulated
+const std::vector<std::array<float, 3>> mesh_vertices{
+    {0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {0, 1, 0}, {2, 0, 1}, {3, 0, 1}, {3.5f, 1, 1}, {2.5f, 2, 1.5f},
+    {1.5f, 1, 1}};
+const std::vector<std::array<std::uint32_t, 3>> mesh_triangles{
+    {0, 1, 2}, {0, 2, 3}, {4, 5, 6}, {4, 6, 7}, {4, 7, 8}};
+
+template <typename T> TriangleStore<T> parse(std::string_view data) {
+    TriangleStore<T> store;
+    io::parse_input<T>(
+        data, [&](std::size_t n) { store.reserve(n); },
+        [&](const Point<T> &p0, const Point<T> &p1, const Point<T> &p2, std::size_t id) {
+            store.push_back(p0, p1, p2, id);
+        });
+    return store;
+}
+
+template <typename T> void expect_mesh(const TriangleStore<T> &store) {
+    ASSERT_EQ(store.size(), mesh_triangles.size());
+    for (std::size_t i = 0; i < store.size(); ++i) {
+        EXPECT_EQ(store.get_id(i), i);
+        for (std::size_t k = 0; k < 3; ++k) {
+            const auto &v = mesh_vertices[mesh_triangles[i][k]];
+            EXPECT_EQ(store.get_vertex(i, k).x_, static_cast<T>(v[0]));
+            EXPECT_EQ(store.get_vertex(i, k).y_, static_cast<T>(v[1]));
+            EXPECT_EQ(store.get_vertex(i, k).z_, static_cast<T>(v[2]));
+        }
+    }
+}
+
+template <typename Value> void append(std::string &data, Value value, bool big_endian = false) {
+    char bytes[sizeof(Value)];
+    std::memcpy(bytes, &value, sizeof(Value));
+    if (big_endian)
+        std::reverse(bytes, bytes + sizeof(Value));
+    data.append(bytes, sizeof(Value));
+}
+
+std::string binary_stl() {
+    std::string data = "solid but binary";
+    data.resize(80, ' ');
+    append(data, static_cast<std::uint32_t>(mesh_triangles.size()));
+    for (const auto &tr : mesh_triangles) {
+        for (int c = 0; c < 3; ++c)
+            append(data, 0.0f); // normal
+        for (std::uint32_t v : tr)
+            for (float c : mesh_vertices[v])
+                append(data, c);
+        append(data, std::uint16_t{0});
+    }
+    return data;
+}
+
+std::string ascii_stl() {
+    std::string text = "solid mesh\n";
+    for (const auto &tr : mesh_triangles) {
+        text += "  facet normal 0 0 1\n    outer loop\n";
+        for (std::uint32_t v : tr)
+            text += "      vertex " + std::to_string(mesh_vertices[v][0]) + ' ' +
+                    std::to_string(mesh_vertices[v][1]) + ' ' +
+                    std::to_string(mesh_vertices[v][2]) + '\n';
+        text += "    endloop\n  endfacet\n";
+    }
+    return text + "endsolid mesh\n";
+}
+
+std::string obj() {
+    std::string text = "# a square and a pentagon\nmtllib mesh.mtl\no mesh\n";
+    for (const auto &v : mesh_vertices)
+        text += "v " + std::to_string(v[0]) + ' ' + std::to_string(v[1]) + ' ' +
+                std::to_string(v[2]) + '\n';
+    return text + "vt 0 0\nvn 0 0 1\ng square\nusemtl red\nf 1/1/1 2/1/1 3//1 4 # quad\n"
+                  "s off\nf -5 -4 -3 -2 -1\n";
+}
+
+// the vertex element with a normal between the coordinates, the face element with a list of
+// texture coordinates after the indices and a flag before them
+std::string binary_ply(bool big_endian) {
+    std::string data = std::string("ply\nformat ") +
+                       (big_endian ? "binary_big_endian" : "binary_little_endian") +
+                       " 1.0\ncomment made by hand\nelement vertex 9\nproperty double x\n"
+                       "property float nx\nproperty double y\nproperty double z\n"
+                       "element face 2\nproperty uchar flag\n"
+                       "property list uchar uint vertex_indices\n"
+                       "property list uchar float texcoord\nend_header\n";
+    for (const auto &v : mesh_vertices) {
+        append(data, static_cast<double>(v[0]), big_endian);
+        append(data, 0.5f, big_endian);
+        append(data, static_cast<double>(v[1]), big_endian);
+        append(data, static_cast<double>(v[2]), big_endian);
+    }
+    const std::vector<std::vector<std::uint32_t>> faces{{0, 1, 2, 3}, {4, 5, 6, 7, 8}};
+    for (const auto &face : faces) {
+        append(data, std::uint8_t{1});
+        append(data, static_cast<std::uint8_t>(face.size()));
+        for (std::uint32_t v : face)
+            append(data, v, big_endian);
+        append(data, std::uint8_t{2});
+        append(data, 0.25f, big_endian);
+        append(data, 0.75f, big_endian);
+    }
+    return data;
+}
+
+} // namespace
+
+TEST(InputFormat, Detect) {
+    EXPECT_EQ(io::detect_input_format("2\n0 0 0 1 0 0 0 1 0"), io::InputFormat::text);
+    EXPECT_EQ(io::detect_input_format(""), io::InputFormat::text);
+    EXPECT_EQ(io::detect_input_format(binary_stl()), io::InputFormat::binary_stl);
+    EXPECT_EQ(io::detect_input_format(ascii_stl()), io::InputFormat::ascii_stl);
+    EXPECT_EQ(io::detect_input_format(obj()), io::InputFormat::obj);
+    EXPECT_EQ(io::detect_input_format("v 1 2 3\n"), io::InputFormat::obj);
+    EXPECT_EQ(io::detect_input_format(binary_ply(false)), io::InputFormat::ply);
+}
+
+TEST(StlInput, Binary) {
+    expect_mesh(parse<float>(binary_stl()));
+    expect_mesh(parse<double>(binary_stl()));
+
+    std::string truncated = binary_stl();
+    truncated.pop_back();
+    EXPECT_THROW(io::parse_binary_stl<float>(truncated, [](std::size_t) {},
+                                             [](const Point<float> &, const Point<float> &,
+                                                const Point<float> &, std::size_t) {}),
+                 std::runtime_error);
+}
+
+TEST(StlInput, Ascii) {
+    expect_mesh(parse<float>(ascii_stl()));
+    EXPECT_THROW(parse<float>("solid s\nfacet normal 0 0 1\nouter loop\nvertex 0 0 0\n"
+                              "vertex 1 0 0\nendloop\nendfacet\nendsolid s\n"),
+                 std::runtime_error);
+    EXPECT_THROW(parse<float>("solid s\nfacet normal 0 0 1\nouter loop\nvertex 0 0 x\n"),
+                 std::runtime_error);
+}
+
+TEST(StlInput, AsciiGrammar) {
+    // names are optional, solids may follow each other
+    EXPECT_EQ(parse<float>("solid\nfacet normal 0 0 1\nouter loop\nvertex 0 0 0\nvertex 1 0 0\n"
+                           "vertex 0 1 0\nendloop\nendfacet\nendsolid\nsolid two words\n"
+                           "endsolid two words")
+                  .size(),
+              1u);
+
+    // truncated anywhere inside a solid
+    const std::string text = ascii_stl();
+    for (const char *cut : {"endsolid", "endfacet", "endloop", "vertex", "loop", "normal"}) {
+        const std::string truncated = text.substr(0, text.rfind(cut));
+        EXPECT_THROW(parse<float>(truncated), std::runtime_error) << "cut before " << cut;
+    }
+
+    // unknown keywords, missing ones and empty files
+    std::string color = text;
+    color.insert(color.find("endloop"), "color 1 0 0\n");
+    EXPECT_THROW(parse<float>(color), std::runtime_error);
+    std::string no_loop = text;
+    no_loop.erase(no_loop.find("outer loop"), 10);
+    EXPECT_THROW(parse<float>(no_loop), std::runtime_error);
+    EXPECT_THROW(parse<float>("solid s\nvertex 0 0 0\nvertex 1 0 0\nvertex 0 1 0\nendsolid s\n"),
+                 std::runtime_error);
+    EXPECT_THROW(parse<float>("solid s\nendsolid s\n"), std::runtime_error);
+    EXPECT_THROW(parse<float>(text + "junk\n"), std::runtime_error);
+}
+
+TEST(ObjInput, FacesAndFans) {
+    expect_mesh(parse<float>(obj()));
+    expect_mesh(parse<double>(obj()));
+
+    EXPECT_THROW(parse<float>("v 0 0 0\nv 1 0 0\nf 1 2\n"), std::runtime_error);
+    EXPECT_THROW(parse<float>("v 0 0 0\nv 1 0 0\nf 1 2 3\n"), std::runtime_error);
+    EXPECT_THROW(parse<float>("v 0 0 0\nf 1 0 1\n"), std::runtime_error);
+    EXPECT_THROW(parse<float>("v 0 0 0\nf 1 1 -2\n"), std::runtime_error);
+    EXPECT_THROW(parse<float>("v 0 0\n"), std::runtime_error);
+}
+
+TEST(PlyInput, Binary) {
+    expect_mesh(parse<float>(binary_ply(false)));
+    expect_mesh(parse<double>(binary_ply(true)));
+
+    std::string truncated = binary_ply(false);
+    truncated.resize(truncated.size() - 3);
+    EXPECT_THROW(parse<float>(truncated), std::runtime_error);
+
+    std::string bad_index = binary_ply(false);
+    const std::size_t first_face = bad_index.find("end_header\n") + 11 + 9 * 28;
+    const std::uint32_t index = 9;
+    std::memcpy(bad_index.data() + first_face + 2, &index, 4);
+    EXPECT_THROW(parse<float>(bad_index), std::runtime_error);
+
+    EXPECT_THROW(parse<float>("ply\nformat ascii 1.0\nend_header\n"), std::runtime_error);
+    EXPECT_THROW(parse<float>("ply\nformat binary_little_endian 1.0\nelement vertex 0\n"
+                              "property float x\nend_header\n"),
+                 std::runtime_error);
+}
@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include "parallel_text_input.hpp"
+#include "text_input.hpp"
+#include "triangle_store.hpp"
+
+using namespace triangle;
+
+// --------------------------------------------------------------------------------------
+//                           Tests parallel text input
+// --------------------------------------------------------------------------------------
+
+static std::string random_input(std::size_t n, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> coord(-100.0, 100.0);
+    std::ostringstream os;
+    os.precision(9);
+    os << n << '\n';
+    for (std::size_t i = 0; i < n; ++i) {
+        for (int k = 0; k < 9; ++k)
+            os << (i % 13 == 0 && k >= 3 ? 1.5 : coord(gen)) << (k % 3 == 2 ? "\n" : "  \t");
+    }
+    return os.str();
+}
+
+static TriangleStore<float> parse_sequential(const std::string &text) {
+    TriangleStore<float> store;
+    io::parse_text_input<float>(
+        text, [&](std::size_t n) { store.reserve(n); },
+        [&](const Point<float> &p0, const Point<float> &p1, const Point<float> &p2,
+            std::size_t id) { store.push_back(p0, p1, p2, id); });
+    return store;
+}
+
+TEST(ParallelTextInput, MatchesSequential) {
+    const std::string text = random_input(500, 42) + "trailing data is ignored";
+    const TriangleStore<float> expected = parse_sequential(text);
+
+    for (std::size_t chunk_size : {1u, 7u, 100u, 4096u, 1u << 22}) {
+        for (std::size_t threads : {1u, 3u}) {
+            const auto loaded = io::parse_text_input_parallel<float>(text, threads, chunk_size);
+            const TriangleStore<float> &store = loaded.triangles;
+
+            ASSERT_EQ(store.size(), expected.size());
+            EXPECT_TRUE(std::ranges::equal(store.get_xs(), expected.get_xs()));
+            EXPECT_TRUE(std::ranges::equal(store.get_ys(), expected.get_ys()));
+            EXPECT_TRUE(std::ranges::equal(store.get_zs(), expected.get_zs()));
+            for (std::size_t i = 0; i < store.size(); ++i) {
+                EXPECT_EQ(store.get_id(i), i);
+                EXPECT_EQ(store.get_type(i), expected.get_type(i));
+            }
+        }
+    }
+}
+
+TEST(ParallelTextInput, Boxes) {
+    const std::string text = "2\n0 0 0  4 2 0  0 2 1\n-1 5 5  -1 5 5  -3 5 7\n";
+    const auto loaded = io::parse_text_input_parallel<double>(text, 2, 5);
+
+    EXPECT_EQ(loaded.box.p_min, (Point<double>{-3, 0, 0}));
+    EXPECT_EQ(loaded.box.p_max, (Point<double>{4, 5, 7}));
+    EXPECT_EQ(loaded.triangles.get_type(1), TypeTriangle::interval);
+}
+
+TEST(ParallelTextInput, SameErrorsAsSequential) {
+    for (const std::string text : {"", "x", "2\n1 2 3 4 5 6 7 8 9\n1 2 3", "1\n1 2 3 4 x 6 7 8 9",
+                                   "2\n1 2 3 4 5 6 7 8 9\n1 2 3 4 5 6 7 8 9e999"}) {
+        std::string expected;
+        try {
+            parse_sequential(text);
+        } catch (const std::runtime_error &error) {
+            expected = error.what();
+        }
+        ASSERT_FALSE(expected.empty()) << text;
+
+        try {
+            io::parse_text_input_parallel<float>(text, 2, 3);
+            ADD_FAILURE() << "no error for: " << text;
+        } catch (const std::runtime_error &error) {
+            EXPECT_EQ(error.what(), expected);
+        }
+    }
+    EXPECT_TRUE(io::parse_text_input_parallel<float>("0").triangles.empty());
+}
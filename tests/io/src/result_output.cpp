@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+#include <unistd.h>
+
+#include "result_output.hpp"
+
+// --------------------------------------------------------------------------------------
+//                           Tests result output
+// --------------------------------------------------------------------------------------
+
+namespace {
+
+// the bytes write(fd) puts into a temporary file
+template <typename Write> std::string written(Write &&write) {
+    std::FILE *file = std::tmpfile();
+    if (!file)
+        throw std::runtime_error("tmpfile failed");
+    const int fd = ::fileno(file);
+    try {
+        write(fd);
+    } catch (...) {
+        std::fclose(file);
+        throw;
+    }
+
+    std::string bytes(static_cast<std::size_t>(::lseek(fd, 0, SEEK_END)), '\0');
+    ::lseek(fd, 0, SEEK_SET);
+    const ::ssize_t count = ::read(fd, bytes.data(), bytes.size());
+    std::fclose(file);
+    bytes.resize(count < 0 ? 0 : static_cast<std::size_t>(count));
+    return bytes;
+}
+
+} // namespace
+
+TEST(ResultOutput, Text) {
+    const std::set<std::size_t> ids = {0, 7, 42, 1000000, 4294967295u};
+    EXPECT_EQ(written([&](int fd) { io::write_ids_text(fd, ids); }),
+              "0\n7\n42\n1000000\n4294967295\n");
+    EXPECT_EQ(written([](int fd) { io::write_ids_text(fd, {}); }), "");
+
+    // more than a buffer of output goes out in several writes
+    std::set<std::size_t> many;
+    std::string expected;
+    for (std::size_t id = 0; id < 300000; id += 3) {
+        many.insert(id);
+        expected += std::to_string(id) + '\n';
+    }
+    EXPECT_EQ(written([&](int fd) { io::write_ids_text(fd, many); }), expected);
+
+    EXPECT_EQ(written([](int fd) {
+                  io::OutputBuffer output(fd, 1);
+                  output.append("ids:");
+                  output.append_number(12, ' ');
+                  output.append_number(345);
+              }),
+              "ids:12 345\n");
+}
+
+TEST(ResultOutput, Uint32) {
+    const std::set<std::size_t> ids = {1, 256, 70000};
+    const std::string bytes = written([&](int fd) { io::write_ids_uint32(fd, ids); });
+    ASSERT_EQ(bytes.size(), 3 * sizeof(std::uint32_t));
+
+    std::uint32_t values[3];
+    std::memcpy(values, bytes.data(), bytes.size());
+    EXPECT_EQ(values[0], 1u);
+    EXPECT_EQ(values[1], 256u);
+    EXPECT_EQ(values[2], 70000u);
+    EXPECT_EQ(bytes.substr(4, 4), std::string("\x00\x01\x00\x00", 4));
+
+    EXPECT_THROW(written([](int fd) { io::write_ids_uint32(fd, {std::size_t{1} << 32}); }),
+                 std::length_error);
+}
+
+TEST(ResultOutput, Bitmap) {
+    const std::set<std::size_t> ids = {0, 3, 8, 9};
+    EXPECT_EQ(written([&](int fd) { io::write_ids_bitmap(fd, ids, 10); }),
+              std::string("\x09\x03", 2));
+    EXPECT_EQ(written([&](int fd) { io::write_ids(fd, ids, io::ResultFormat::bitmap, 17); }),
+              std::string("\x09\x03\x00", 3));
+    EXPECT_EQ(written([](int fd) { io::write_ids_bitmap(fd, {}, 0); }), "");
+
+    EXPECT_THROW(written([&](int fd) { io::write_ids_bitmap(fd, ids, 9); }), std::out_of_range);
+}
+
+TEST(ResultOutput, FormatsAndErrors) {
+    EXPECT_EQ(io::parse_result_format("text"), io::ResultFormat::text);
+    EXPECT_EQ(io::parse_result_format("uint32"), io::ResultFormat::uint32);
+    EXPECT_EQ(io::parse_result_format("bitmap"), io::ResultFormat::bitmap);
+    EXPECT_THROW(io::parse_result_format("json"), std::invalid_argument);
+
+    EXPECT_EQ(written([](int fd) { io::write_ids(fd, {5, 6}, io::ResultFormat::text, 0); }),
+              "5\n6\n");
+
+    // a closed descriptor
+    int fds[2];
+    ASSERT_EQ(::pipe(fds), 0);
+    ::close(fds[0]);
+    ::close(fds[1]);
+    EXPECT_THROW(io::write_ids_text(fds[1], {1}), std::system_error);
+}
@@ -0,0 +1,226 @@
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+#include "BVH/query_stats.hpp"
+#include "common/perf_counters.hpp"
+#include "common/stage_timings.hpp"
+#include "common/trace.hpp"
+
+// --------------------------------------------------------------------------------------
+//                    Tests stage timings, event counters and trace spans
+// --------------------------------------------------------------------------------------
+
+namespace {
+
+perf::EventCounts make_counts() {
+    perf::EventCounts counts;
+    counts.counts[static_cast<std::size_t>(perf::Event::cycles)] = 2000;
+    counts.counts[static_cast<std::size_t>(perf::Event::instructions)] = 3000;
+    counts.counts[static_cast<std::size_t>(perf::Event::l1d_misses)] = 40;
+    return counts;
+}
+
+std::size_t count(const std::string &text, const std::string &what) {
+    std::size_t n = 0;
+    for (std::size_t at = text.find(what); at != std::string::npos; at = text.find(what, at + 1))
+        ++n;
+    return n;
+}
+
+std::string chrome_trace(trace::Recorder &recorder) {
+    std::ostringstream os;
+    recorder.write_chrome_trace(os);
+    return os.str();
+}
+
+} // namespace
+
+TEST(StageTimings, MeasureAndPrint) {
+    timing::StageTimings timings;
+    EXPECT_EQ(timings.measure("first", [] { return 42; }), 42);
+    timings.add("second", 1.5);
+
+    ASSERT_EQ(timings.get_stages().size(), 2u);
+    EXPECT_EQ(timings.get_stages()[0].first, "first");
+    EXPECT_EQ(timings.get_stages()[1].second, 1.5);
+    EXPECT_EQ(timings.find_events("first"), nullptr);
+    EXPECT_TRUE(timings.get_events().empty());
+
+    std::ostringstream os;
+    os << 0.125 << ' ';
+    timings.print(os);
+    os << 0.125;
+    const std::string text = os.str();
+    EXPECT_NE(text.find("second     1.500 s\n"), std::string::npos);
+    EXPECT_EQ(text.substr(text.size() - 5), "0.125"); // the stream state is restored
+}
+
+TEST(StageTimings, EventCounts) {
+    const perf::EventCounts counts = make_counts();
+    EXPECT_DOUBLE_EQ(*counts.ipc(), 1.5);
+    EXPECT_FALSE(counts.get(perf::Event::llc_misses));
+    EXPECT_FALSE(counts.empty());
+    EXPECT_TRUE(perf::EventCounts().empty());
+    EXPECT_FALSE(perf::EventCounts().ipc());
+
+    std::ostringstream os;
+    perf::print_counts(os, counts);
+    EXPECT_EQ(os.str(), "cycles 2000, instructions 3000, IPC 1.50, L1d misses 40, LLC misses n/a, "
+                        "branch misses n/a, dTLB misses n/a");
+
+    timing::StageTimings timings;
+    timings.add("load", 0.5);
+    timings.add("query", 2, counts);
+    ASSERT_NE(timings.find_events("query"), nullptr);
+    EXPECT_EQ(timings.find_events("load"), nullptr);
+    ASSERT_EQ(timings.get_events().size(), 1u);
+    EXPECT_EQ(timings.get_events()[0].first, "query");
+
+    std::ostringstream printed;
+    timings.print(printed);
+    EXPECT_NE(printed.str().find("query  cycles 2000, instructions 3000, IPC 1.50"),
+              std::string::npos);
+}
+
+TEST(StageTimings, EventsInQueryStats) {
+    bin_tree::QueryStats stats;
+    stats.timings.add("query", 2, make_counts());
+    stats.counters.box_tests_passed = 8;
+    stats.counters.box_tests_failed = 2;
+
+    std::ostringstream text;
+    bin_tree::print_stats(text, stats, bin_tree::StatsFormat::text);
+    EXPECT_NE(text.str().find("query per node pair: cycles 200, L1d misses 4, LLC misses n/a"),
+              std::string::npos);
+
+    std::ostringstream json;
+    bin_tree::print_stats(json, stats, bin_tree::StatsFormat::json);
+    EXPECT_NE(json.str().find("\"events\":{\"query\":{\"cycles\":2000,\"instructions\":3000,"
+                              "\"l1d_misses\":40,\"llc_misses\":null,\"branch_misses\":null,"
+                              "\"dtlb_misses\":null,\"ipc\":1.5}}"),
+              std::string::npos);
+    EXPECT_NE(json.str().find("\"query_per_node_pair\":{\"cycles\":200,\"l1d_misses\":4,"
+                              "\"llc_misses\":null,\"branch_misses\":null,\"dtlb_misses\":null}}"),
+              std::string::npos);
+}
+
+TEST(PerfCounters, UnavailableCountersAreEmpty) {
+    perf::EventCounters counters; // never throws, whatever the kernel allows
+
+    timing::StageTimings timings;
+    timings.count_events(&counters);
+    timings.measure("stage", [] {});
+    ASSERT_NE(timings.find_events("stage"), nullptr);
+    if (!counters.available()) {
+        EXPECT_FALSE(counters.get_error().empty());
+        EXPECT_TRUE(timings.find_events("stage")->empty());
+    }
+}
+
+// the open and read path on a software event, which works without a PMU
+TEST(PerfCounters, SoftwareEvent) {
+    const int fd = perf::detail::open_counter(PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK);
+    if (fd < 0)
+        GTEST_SKIP() << "perf_event_open is not allowed here";
+
+    ::ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+    ::ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    volatile std::uint64_t sum = 0;
+    for (std::uint64_t i = 0; i < 10000000; ++i)
+        sum = sum + i;
+    ::ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+
+    const auto nanoseconds = perf::detail::read_counter(fd);
+    ::close(fd);
+    ASSERT_TRUE(nanoseconds);
+    EXPECT_GT(*nanoseconds, 0.0);
+}
+
+TEST(Trace, SpansOfEveryThread) {
+    trace::Recorder recorder;
+    recorder.start();
+    {
+        trace::ScopedSpan outer("outer", 7, recorder);
+        trace::ScopedSpan inner("inner", 0, recorder);
+        trace::ScopedSpan skipped(nullptr, 0, recorder);
+    }
+    std::thread([&] { trace::ScopedSpan span("worker", 3, recorder); }).join();
+
+    const std::string text = chrome_trace(recorder);
+    EXPECT_EQ(text.rfind("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", 0), 0u);
+    EXPECT_EQ(text.substr(text.size() - 3), "]}\n");
+    EXPECT_EQ(count(text, "\"ph\":\"X\""), 3u);
+    EXPECT_EQ(count(text, "\"thread_name\""), 2u);
+    EXPECT_NE(text.find("\"name\":\"outer\",\"ph\":\"X\",\"pid\":1,\"tid\":1,"), std::string::npos);
+    EXPECT_NE(text.find("\"args\":{\"n\":7}"), std::string::npos);
+    EXPECT_NE(text.find("\"name\":\"worker\",\"ph\":\"X\",\"pid\":1,\"tid\":2,"),
+              std::string::npos);
+    // spans are pushed when they end: inner before outer
+    EXPECT_LT(text.find("\"inner\""), text.find("\"outer\""));
+}
+
+TEST(Trace, NothingBeforeStart) {
+    trace::Recorder recorder;
+    { trace::ScopedSpan early("early", 0, recorder); }
+    recorder.start();
+    { trace::ScopedSpan late("late", 0, recorder); }
+
+    const std::string text = chrome_trace(recorder);
+    EXPECT_EQ(text.find("\"early\""), std::string::npos);
+    EXPECT_EQ(count(text, "\"ph\":\"X\""), 1u);
+}
+
+TEST(Trace, OneBufferPerRecorderAndThread) {
+    trace::Recorder first;
+    trace::Recorder second;
+    first.start();
+    second.start();
+    for (int i = 0; i < 3; ++i) {
+        trace::ScopedSpan a("a", 0, first);
+        trace::ScopedSpan b("b", 0, second);
+    }
+
+    for (auto *recorder : {&first, &second}) {
+        const std::string text = chrome_trace(*recorder);
+        EXPECT_EQ(count(text, "\"thread_name\""), 1u);
+        EXPECT_EQ(count(text, "\"ph\":\"X\""), 3u);
+    }
+}
+
+TEST(Trace, RingBufferKeepsTheNewest) {
+    trace::Recorder recorder(4);
+    recorder.start();
+    const char *names[] = {"s0", "s1", "s2", "s3", "s4", "s5"};
+    for (const char *name : names)
+        trace::ScopedSpan span(name, 0, recorder);
+
+    const std::string text = chrome_trace(recorder);
+    EXPECT_EQ(count(text, "\"ph\":\"X\""), 4u);
+    EXPECT_EQ(text.find("\"s1\""), std::string::npos);
+    EXPECT_LT(text.find("\"s2\""), text.find("\"s5\""));
+    EXPECT_NE(text.find("\"dropped spans\""), std::string::npos);
+    EXPECT_NE(text.find("\"count\":2"), std::string::npos);
+}
+
+TEST(Trace, FileOpenedUpFront) {
+    trace::Recorder recorder;
+    EXPECT_THROW(recorder.write_at_exit("/nonexistent/directory/trace.json"), std::runtime_error);
+    EXPECT_FALSE(recorder.recording());
+}
+
+TEST(Trace, Microseconds) {
+    std::ostringstream os;
+    trace::print_microseconds(os, 1234567);
+    os << ' ';
+    trace::print_microseconds(os, 5);
+    EXPECT_EQ(os.str(), "1234.567 0.005");
+}
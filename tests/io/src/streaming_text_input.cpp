@@ -0,0 +1,174 @@
+#include <gtest/gtest.h>
+#include <csignal>
+#include <cstddef>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+#include "BVH/build_arrays.hpp"
+#include "overlapped_input.hpp"
+#include "streaming_text_input.hpp"
+#include "text_input.hpp"
+#include "triangle_store.hpp"
+
+using namespace triangle;
+
+// --------------------------------------------------------------------------------------
+//                           Tests streaming and overlapped input
+// --------------------------------------------------------------------------------------
+
+namespace {
+
+std::string random_input(std::size_t n) {
+    std::mt19937 generator(7);
+    std::uniform_real_distribution<double> coordinate(-10, 10);
+    std::string text = std::to_string(n) + "\n";
+    for (std::size_t i = 0; i < 9 * n; ++i)
+        text += std::to_string(coordinate(generator)) + ((i % 9 == 8) ? "\n" : "  ");
+    return text;
+}
+
+// runs read(fd) with `text` written into a pipe by another thread
+template <typename Read> auto through_pipe(const std::string &text, Read &&read) {
+    std::signal(SIGPIPE, SIG_IGN); // the reader may stop before the writer is done
+    int fds[2];
+    if (::pipe(fds) != 0)
+        throw std::runtime_error("pipe failed");
+
+    std::thread writer([&] {
+        std::size_t written = 0;
+        while (written < text.size()) {
+            const ::ssize_t count = ::write(fds[1], text.data() + written, text.size() - written);
+            if (count <= 0)
+                break;
+            written += static_cast<std::size_t>(count);
+        }
+        ::close(fds[1]);
+    });
+
+    struct Cleanup {
+        int fd;
+        std::thread &writer;
+        ~Cleanup() {
+            ::close(fd); // a writer blocked on a full pipe gets EPIPE
+            writer.join();
+        }
+    } cleanup{fds[0], writer};
+    return read(fds[0]);
+}
+
+TriangleStore<float> parse(std::string_view text) {
+    TriangleStore<float> store;
+    io::parse_text_input<float>(
+        text, [&](std::size_t n) { store.reserve(n); },
+        [&](const Point<float> &p0, const Point<float> &p1, const Point<float> &p2,
+            std::size_t id) { store.push_back(p0, p1, p2, id); });
+    return store;
+}
+
+TriangleStore<float> stream(const std::string &text, std::size_t block_size,
+                            std::size_t read_size) {
+    return through_pipe(text, [&](int fd) {
+        TriangleStore<float> store;
+        std::size_t next_id = 0;
+        io::stream_text_input<float>(
+            fd, [&](std::size_t n) { store.reserve(n); },
+            [&](io::TriangleBlock<float> &&block) {
+                EXPECT_EQ(block.first_id, next_id);
+                EXPECT_LE(block.size(), block_size);
+                next_id += block.size();
+                const auto &[xs, ys, zs] = block.columns;
+                for (std::size_t i = 0; i < block.size(); ++i)
+                    store.push_back(Point<float>(xs[3 * i], ys[3 * i], zs[3 * i]),
+                                    Point<float>(xs[3 * i + 1], ys[3 * i + 1], zs[3 * i + 1]),
+                                    Point<float>(xs[3 * i + 2], ys[3 * i + 2], zs[3 * i + 2]),
+                                    block.first_id + i);
+            },
+            block_size, read_size);
+        return store;
+    });
+}
+
+void expect_same(const TriangleStore<float> &a, const TriangleStore<float> &b) {
+    ASSERT_EQ(a.size(), b.size());
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        EXPECT_EQ(a.get_id(i), b.get_id(i));
+        EXPECT_EQ(a.get_type(i), b.get_type(i));
+        for (std::size_t k = 0; k < 3; ++k)
+            EXPECT_EQ(a.get_vertex(i, k), b.get_vertex(i, k));
+    }
+}
+
+} // namespace
+
+TEST(StreamingTextInput, MatchesParseTextInput) {
+    const std::string text = random_input(1000);
+    const TriangleStore<float> expected = parse(text);
+
+    // reads that cut numbers in half, a single byte at a time, and the whole input at once
+    for (std::size_t read_size : {7u, 1u, 1u << 20})
+        for (std::size_t block_size : {1u, 64u, 5000u})
+            expect_same(stream(text, block_size, read_size), expected);
+
+    expect_same(stream("0\n", 4, 3), parse("0\n"));
+    expect_same(stream("1 0 0 0 1 0 0 0 1 0 trailing", 4, 3), parse("1 0 0 0 1 0 0 0 1 0"));
+}
+
+TEST(StreamingTextInput, SameErrorsAsParseTextInput) {
+    for (const std::string text : {"", "x", "2\n1 2 3 4 5 6 7 8 9\n1 2 3",
+                                   "2\n1 2 3 4 5 6 7 8 9\n1 2 3 4 5x 6 7 8 9\n"}) {
+        std::string expected, actual;
+        try {
+            parse(text);
+        } catch (const std::runtime_error &error) {
+            expected = error.what();
+        }
+        try {
+            stream(text, 1, 3);
+        } catch (const std::runtime_error &error) {
+            actual = error.what();
+        }
+        EXPECT_FALSE(expected.empty());
+        EXPECT_EQ(actual, expected) << text;
+    }
+}
+
+TEST(OverlappedInput, MatchesSequentialPreparation) {
+    const std::string text = random_input(3000) + "\n1 1 1 1 1 1 1 1 1\n";
+    const TriangleStore<float> expected = parse(text);
+    const bin_tree::BuildArrays<float> expected_arrays(expected);
+
+    timing::StageTimings timings;
+    const io::PreparedTriangles<float> prepared = through_pipe(
+        text, [&](int fd) { return io::load_overlapped<float>(fd, timings, 100, 2); });
+
+    expect_same(prepared.loaded.triangles, expected);
+    ASSERT_EQ(prepared.arrays.size(), expected.size());
+
+    bounding_box::AABB<float> box;
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ(prepared.arrays.boxes[i].p_min, expected_arrays.boxes[i].p_min);
+        EXPECT_EQ(prepared.arrays.boxes[i].p_max, expected_arrays.boxes[i].p_max);
+        for (std::size_t axis = 0; axis < 3; ++axis)
+            EXPECT_EQ(prepared.arrays.centers[axis][i], expected.get_center(i, axis));
+
+        box.wrap_in_box_with(expected.get_box(i));
+    }
+    EXPECT_EQ(prepared.loaded.box.p_min, box.p_min);
+    EXPECT_EQ(prepared.loaded.box.p_max, box.p_max);
+
+    ASSERT_EQ(timings.get_stages().size(), 3u);
+    EXPECT_EQ(timings.get_stages()[0].first, "load");
+    EXPECT_EQ(timings.get_stages()[2].first, "load + prepare");
+}
+
+TEST(OverlappedInput, Errors) {
+    timing::StageTimings timings;
+    auto load = [&](int fd) { return io::load_overlapped<float>(fd, timings, 1, 1); };
+    EXPECT_THROW(through_pipe("2\n1 2 3 4 5 6 7 8 9\n1 2 x", load), std::runtime_error);
+    EXPECT_THROW(through_pipe("x", load), std::runtime_error);
+}
@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+#include "mapped_input.hpp"
+#include "text_input.hpp"
+#include "triangle_store.hpp"
+
+using namespace triangle;
+
+// --------------------------------------------------------------------------------------
+//                           Tests text input
+// --------------------------------------------------------------------------------------
+
+TEST(TextScanner, Numbers) {
+    io::TextScanner scanner(" 3\n\t+1.5 -2e-3  7.25E+2 0.1\r\n");
+    std::size_t n = 0;
+    float a = 0, b = 0, c = 0;
+    double d = 0;
+
+    ASSERT_TRUE(scanner.next(n));
+    ASSERT_TRUE(scanner.next(a));
+    ASSERT_TRUE(scanner.next(b));
+    ASSERT_TRUE(scanner.next(c));
+    ASSERT_TRUE(scanner.next(d));
+    EXPECT_EQ(n, 3u);
+    EXPECT_EQ(a, 1.5f);
+    EXPECT_EQ(b, -2e-3f);
+    EXPECT_EQ(c, 725.0f);
+    EXPECT_EQ(d, 0.1);
+    EXPECT_FALSE(scanner.next(d));
+}
+
+TEST(TextScanner, Malformed) {
+    float value = 0;
+    EXPECT_FALSE(io::TextScanner("1.5abc").next(value));
+    EXPECT_FALSE(io::TextScanner("abc").next(value));
+    EXPECT_FALSE(io::TextScanner("1e500").next(value));
+    EXPECT_FALSE(io::TextScanner("   ").next(value));
+}
+
+TEST(TextScanner, Words) {
+    io::TextScanner scanner("  vertex 1.5\tendloop\n");
+    std::string_view word;
+    float value = 0;
+
+    ASSERT_TRUE(scanner.next_word(word));
+    EXPECT_EQ(word, "vertex");
+    ASSERT_TRUE(scanner.next(value));
+    EXPECT_EQ(value, 1.5f);
+    ASSERT_TRUE(scanner.next_word(word));
+    EXPECT_EQ(word, "endloop");
+    EXPECT_FALSE(scanner.next_word(word));
+    EXPECT_TRUE(word.empty());
+}
+
+TEST(TextInput, MatchesStreamExtraction) {
+    // 1e-40 is a float denormal, 1e-50 and -1e-320 underflow to zero
+    const std::string text = "2\n0.1 0.2 0.3 1e-7 -4 5.5\n7 8 9\n"
+                             "3.14159265 2.71828 -1 1e-40 1e-50 -1e-320 1 1 1\n";
+
+    TriangleStore<float> store;
+    io::parse_text_input<float>(
+        text, [&](std::size_t n) { store.reserve(n); },
+        [&](const Point<float> &p0, const Point<float> &p1, const Point<float> &p2,
+            std::size_t id) { store.push_back(p0, p1, p2, id); });
+
+    std::istringstream stream(text);
+    std::size_t n = 0;
+    stream >> n;
+    ASSERT_EQ(store.size(), n);
+    for (std::size_t i = 0; i < n; ++i) {
+        EXPECT_EQ(store.get_id(i), i);
+        for (std::size_t k = 0; k < 3; ++k) {
+            float x, y, z;
+            stream >> x >> y >> z;
+            const Point<float> vertex = store.get_vertex(i, k);
+            EXPECT_EQ(vertex.x_, x);
+            EXPECT_EQ(vertex.y_, y);
+            EXPECT_EQ(vertex.z_, z);
+        }
+    }
+}
+
+TEST(TextInput, Errors) {
+    auto parse = [](std::string_view text) {
+        io::parse_text_input<double>(text, [](std::size_t) {},
+                                     [](const Point<double> &, const Point<double> &,
+                                        const Point<double> &, std::size_t) {});
+    };
+    EXPECT_THROW(parse(""), std::runtime_error);
+    EXPECT_THROW(parse("x"), std::runtime_error);
+    EXPECT_THROW(parse("2\n1 2 3 4 5 6 7 8 9\n1 2 3"), std::runtime_error);
+    EXPECT_NO_THROW(parse("1\n1 2 3 4 5 6 7 8 9"));
+
+    // no nan or inf, and no overflow; an underflow is read as zero
+    for (const char *number : {"nan", "-nan", "inf", "-infinity", "nan(1)", "1e400"})
+        EXPECT_THROW(parse("1\n1 2 3 4 5 6 7 8 " + std::string(number)), std::runtime_error)
+            << number;
+    EXPECT_NO_THROW(parse("1\n1 2 3 4 5 6 7 8 1e-400"));
+
+    auto parse_float = [](std::string_view text) {
+        io::parse_text_input<float>(text, [](std::size_t) {},
+                                    [](const Point<float> &, const Point<float> &,
+                                       const Point<float> &, std::size_t) {});
+    };
+    EXPECT_THROW(parse_float("1\n1 2 3 4 5 6 7 8 1e50"), std::runtime_error);
+    EXPECT_NO_THROW(parse_float("1\n1e-50 2 3 4 5 6 7 8 -1e-320"));
+}
+
+TEST(MappedInput, RegularFile) {
+    const std::filesystem::path path =
+        std::filesystem::temp_directory_path() / "triangles_mapped_input_test.txt";
+    std::ofstream(path) << "1\n0 0 0 1 0 0 0 1 0\n";
+
+    {
+        const io::MappedInput input(path);
+        EXPECT_TRUE(input.is_mapped());
+        EXPECT_EQ(input.text(), "1\n0 0 0 1 0 0 0 1 0\n");
+    }
+    std::ofstream(path, std::ios::trunc).close();
+    EXPECT_TRUE(io::MappedInput(path).text().empty());
+    std::filesystem::remove(path);
+
+    EXPECT_THROW(io::MappedInput{path}, std::system_error);
+}
+
+TEST(MappedInput, PipeIsReadInBlocks) {
+    int fds[2];
+    ASSERT_EQ(::pipe(fds), 0);
+
+    // more than one block, written from a thread so the pipe buffer cannot fill up
+    const std::string text(io::input_block_size + 12345, '7');
+    std::thread writer([&] {
+        std::size_t written = 0;
+        while (written < text.size()) {
+            const ::ssize_t count = ::write(fds[1], text.data() + written, text.size() - written);
+            if (count <= 0)
+                break;
+            written += static_cast<std::size_t>(count);
+        }
+        ::close(fds[1]);
+    });
+
+    const io::MappedInput input(fds[0]);
+    writer.join();
+    ::close(fds[0]);
+
+    EXPECT_FALSE(input.is_mapped());
+    EXPECT_EQ(input.text(), text);
+}
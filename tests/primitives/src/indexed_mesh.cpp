@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "indexed_mesh.hpp"
+#include "triangle.hpp"
+#include "triangle_store.hpp"
+
+using namespace triangle;
+
+// --------------------------------------------------------------------------------------
+//                           Tests class IndexedMesh
+// --------------------------------------------------------------------------------------
+
+using PF = Point<float>;
+
+// the 12 triangles of the unit cube, every vertex repeated
+static TriangleStore<float> cube_soup() {
+    const std::array<PF, 8> c{PF{0,0,0}, PF{1,0,0}, PF{1,1,0}, PF{0,1,0},
+                              PF{0,0,1}, PF{1,0,1}, PF{1,1,1}, PF{0,1,1}};
+    const std::array<std::array<int, 3>, 12> faces{{{0,1,2}, {0,2,3}, {4,6,5}, {4,7,6},
+                                                    {0,5,1}, {0,4,5}, {3,2,6}, {3,6,7},
+                                                    {0,3,7}, {0,7,4}, {1,5,6}, {1,6,2}}};
+    TriangleStore<float> soup;
+    for (std::size_t i = 0; i < faces.size(); ++i)
+        soup.push_back(c[faces[i][0]], c[faces[i][1]], c[faces[i][2]], i);
+    return soup;
+}
+
+TEST(IndexedMesh, PushAndRead) {
+    IndexedMesh<float> mesh;
+    const auto a = mesh.add_vertex(PF{0,0,0});
+    const auto b = mesh.add_vertex(PF{1,0,0});
+    const auto c = mesh.add_vertex(PF{0,1,0});
+    const auto d = mesh.add_vertex(PF{2,0,0});
+
+    mesh.push_back(a, b, c, 5);
+    mesh.push_back(a, b, d, 6);
+    mesh.push_back(c, c, c, 7);
+
+    ASSERT_EQ(mesh.size(), 3u);
+    EXPECT_EQ(mesh.get_number_of_vertices(), 4u);
+    EXPECT_EQ(mesh.get_type(0), TypeTriangle::triangle);
+    EXPECT_EQ(mesh.get_type(1), TypeTriangle::interval);
+    EXPECT_EQ(mesh.get_type(2), TypeTriangle::point);
+    EXPECT_EQ(mesh.get_vertex(1, 2), (PF{2,0,0}));
+    EXPECT_EQ(mesh.get_id(2), 7u);
+    EXPECT_EQ(mesh.get_box(0).p_max, (PF{1,1,0}));
+    EXPECT_FLOAT_EQ(mesh.get_center(1, 0), 1.0f);
+
+    EXPECT_THROW(mesh.push_back(a, b, 4, 8), std::out_of_range);
+}
+
+TEST(IndexedMesh, WeldCube) {
+    const TriangleStore<float> soup = cube_soup();
+    const IndexedMesh<float> mesh = weld_vertices(soup, 1);
+
+    ASSERT_EQ(mesh.size(), 12u);
+    EXPECT_EQ(mesh.get_number_of_vertices(), 8u);
+    EXPECT_LT(mesh.get_memory_size(), soup.size() * TriangleStore<float>::bytes_per_triangle);
+
+    for (std::size_t i = 0; i < soup.size(); ++i) {
+        EXPECT_EQ(mesh.get_id(i), soup.get_id(i));
+        EXPECT_EQ(mesh.get_type(i), soup.get_type(i));
+        EXPECT_EQ(mesh.get_vertices(i), soup.get_vertices(i));
+    }
+    // first occurrence order: the first triangle uses the first three mesh vertices
+    EXPECT_EQ(mesh.vertex_index(0, 0), 0u);
+    EXPECT_EQ(mesh.vertex_index(0, 1), 1u);
+    EXPECT_EQ(mesh.vertex_index(0, 2), 2u);
+}
+
+TEST(IndexedMesh, WeldKeepsDistinctBitPatterns) {
+    TriangleStore<float> soup;
+    soup.push_back(PF{0,0,0}, PF{1,0,0}, PF{0,1,0}, 0);
+    soup.push_back(PF{-0.0f,0,0}, PF{1,0,0}, PF{0,1,1e-7f}, 1);
+
+    const IndexedMesh<float> mesh = weld_vertices(soup, 2);
+    EXPECT_EQ(mesh.get_number_of_vertices(), 5u);
+}
+
+TEST(IndexedMesh, ParallelWeldMatchesSerial) {
+    std::mt19937 gen(37);
+    std::uniform_int_distribution<int> pick(0, 299);
+    std::uniform_real_distribution<float> coord(-10.0f, 10.0f);
+
+    std::vector<PF> points;
+    for (int i = 0; i < 300; ++i)
+        points.push_back(PF{coord(gen), coord(gen), coord(gen)});
+
+    TriangleStore<float> soup;
+    for (std::size_t i = 0; i < 2000; ++i)
+        soup.push_back(points[pick(gen)], points[pick(gen)], points[pick(gen)], i);
+
+    const IndexedMesh<float> serial = weld_vertices(soup, 1);
+    EXPECT_LE(serial.get_number_of_vertices(), 300u);
+
+    for (std::size_t threads : {2u, 3u, 8u}) {
+        const IndexedMesh<float> parallel = weld_vertices(soup, threads);
+        ASSERT_EQ(parallel.get_number_of_vertices(), serial.get_number_of_vertices());
+        EXPECT_TRUE(std::ranges::equal(parallel.get_indices(), serial.get_indices()));
+        EXPECT_TRUE(std::ranges::equal(parallel.get_xs(), serial.get_xs()));
+    }
+}
+
+TEST(IndexedMesh, PermuteKeepsVertices) {
+    IndexedMesh<float> mesh = weld_vertices(cube_soup(), 1);
+    const IndexedMesh<float> original = mesh;
+
+    std::vector<std::uint32_t> order(mesh.size());
+    for (std::size_t j = 0; j < order.size(); ++j)
+        order[j] = static_cast<std::uint32_t>(order.size() - 1 - j);
+    mesh.permute(order);
+
+    EXPECT_EQ(mesh.get_number_of_vertices(), original.get_number_of_vertices());
+    for (std::size_t j = 0; j < order.size(); ++j) {
+        EXPECT_EQ(mesh.get_id(j), original.get_id(order[j]));
+        EXPECT_EQ(mesh.get_vertices(j), original.get_vertices(order[j]));
+    }
+}
+
+TEST(IndexedMesh, WeldEmptySoup) {
+    const IndexedMesh<float> mesh = weld_vertices(TriangleStore<float>(), 4);
+    EXPECT_TRUE(mesh.empty());
+    EXPECT_EQ(mesh.get_number_of_vertices(), 0u);
+}
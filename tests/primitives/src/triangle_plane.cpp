@@ -0,0 +1,33 @@
+#include <gtest/gtest.h>
+
+#include "triangle.hpp"
+#include "triangle_plane.hpp"
+
+using namespace triangle;
+
+// --------------------------------------------------------------------------------------
+//                           Tests struct TrianglePlane
+// --------------------------------------------------------------------------------------
+
+using T = double;
+
+TEST(TrianglePlane, EdgesAndNormal) {
+    Triangle<T> tri(Point<T>(1,1,1), Point<T>(3,1,1), Point<T>(1,4,1));
+    TrianglePlane<T> plane(tri);
+
+    EXPECT_DOUBLE_EQ(plane.edge_1.x_, 2);
+    EXPECT_DOUBLE_EQ(plane.edge_1.y_, 0);
+    EXPECT_DOUBLE_EQ(plane.edge_2.y_, 3);
+    EXPECT_DOUBLE_EQ(plane.normal.x_, 0);
+    EXPECT_DOUBLE_EQ(plane.normal.y_, 0);
+    EXPECT_DOUBLE_EQ(plane.normal.z_, 6);
+}
+
+TEST(TrianglePlane, OrientSign) {
+    Triangle<T> tri(Point<T>(0,0,0), Point<T>(1,0,0), Point<T>(0,1,0));
+    TrianglePlane<T> plane(tri);
+
+    EXPECT_GT(plane.orient(tri, Point<T>(0.2,0.2,1)), 0);
+    EXPECT_LT(plane.orient(tri, Point<T>(0.2,0.2,-1)), 0);
+    EXPECT_DOUBLE_EQ(plane.orient(tri, Point<T>(5,-3,0)), 0);
+}
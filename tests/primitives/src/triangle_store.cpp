@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "triangle.hpp"
+#include "triangle_store.hpp"
+
+using namespace triangle;
+
+// --------------------------------------------------------------------------------------
+//                           Tests class TriangleStore
+// --------------------------------------------------------------------------------------
+
+using PF = Point<float>;
+using TF = Triangle<float>;
+
+TEST(TriangleStore, PushAndRead) {
+    TriangleStore<float> store;
+    EXPECT_TRUE(store.empty());
+
+    store.push_back(PF{0,0,0}, PF{1,0,0}, PF{0,1,0}, 7);
+    store.push_back(PF{0,0,0}, PF{2,2,2}, PF{1,1,1}, 8);
+    store.push_back(PF{3,3,3}, PF{3,3,3}, PF{3,3,3}, 9);
+
+    ASSERT_EQ(store.size(), 3u);
+    EXPECT_EQ(store.get_id(0), 7u);
+    EXPECT_EQ(store.get_id(2), 9u);
+    EXPECT_EQ(store.get_type(0), TypeTriangle::triangle);
+    EXPECT_EQ(store.get_type(1), TypeTriangle::interval);
+    EXPECT_EQ(store.get_type(2), TypeTriangle::point);
+    EXPECT_EQ(store.get_vertex(1, 1), (PF{2,2,2}));
+    EXPECT_EQ(store.get_xs().size(), 9u);
+}
+
+TEST(TriangleStore, MatchesTriangle) {
+    std::vector<TF> triangles{TF{PF{0,-1,2}, PF{4,0,1}, PF{1,3,5}, 0},
+                              TF{PF{-2,-2,-2}, PF{0,0,0}, PF{2,2,2}, 1}};
+    const TriangleStore<float> store(triangles);
+
+    for (std::size_t i = 0; i < triangles.size(); ++i) {
+        const TF tr = store.get_triangle(i);
+        EXPECT_EQ(tr.get_id(), triangles[i].get_id());
+        EXPECT_EQ(tr.get_type(), triangles[i].get_type());
+        EXPECT_EQ(tr.get_vertices(), triangles[i].get_vertices());
+
+        const auto box = store.get_box(i);
+        EXPECT_EQ(box.p_min, triangles[i].get_box().p_min);
+        EXPECT_EQ(box.p_max, triangles[i].get_box().p_max);
+
+        const auto center = triangles[i].get_box().get_center();
+        EXPECT_FLOAT_EQ(store.get_center(i, 0), center.x_);
+        EXPECT_FLOAT_EQ(store.get_center(i, 1), center.y_);
+        EXPECT_FLOAT_EQ(store.get_center(i, 2), center.z_);
+    }
+}
+
+TEST(TriangleStore, Permute) {
+    TriangleStore<float> store;
+    for (std::size_t i = 0; i < 4; ++i) {
+        const float c = static_cast<float>(i);
+        store.push_back(PF{c,0,0}, PF{c,1,0}, PF{c,0,1}, i);
+    }
+
+    const std::vector<std::uint32_t> order{2, 0, 3, 1};
+    store.permute(order);
+
+    for (std::size_t j = 0; j < order.size(); ++j) {
+        EXPECT_EQ(store.get_id(j), order[j]);
+        EXPECT_EQ(store.get_vertex(j, 0).x_, static_cast<float>(order[j]));
+    }
+
+    const std::vector<std::uint32_t> wrong{0, 1};
+    EXPECT_THROW(store.permute(wrong), std::invalid_argument);
+}
+
+TEST(TriangleStore, FromColumns) {
+    const TriangleStore<float> store({0, 1, 0}, {0, 0, 1}, {0, 0, 0}, {4},
+                                     {static_cast<std::uint8_t>(TypeTriangle::triangle)});
+    ASSERT_EQ(store.size(), 1u);
+    EXPECT_EQ(store.get_id(0), 4u);
+    EXPECT_EQ(store.get_vertex(0, 2), (PF{0,1,0}));
+
+    EXPECT_THROW(TriangleStore<float>({0, 1}, {0, 0}, {0, 0}, {4}, {0}), std::invalid_argument);
+    EXPECT_THROW(TriangleStore<float>({0, 1, 0}, {0, 0, 1}, {0, 0, 0}, {4}, {}),
+                 std::invalid_argument);
+}
+
+TEST(TriangleStore, IdsAreLimitedTo32Bits) {
+    if constexpr (sizeof(std::size_t) > sizeof(std::uint32_t)) {
+        TriangleStore<float> store;
+        const std::size_t too_big = std::size_t{std::numeric_limits<std::uint32_t>::max()} + 1;
+        EXPECT_THROW(store.push_back(PF{0,0,0}, PF{1,0,0}, PF{0,1,0}, too_big), std::length_error);
+        EXPECT_TRUE(store.empty());
+    }
+}
+
+TEST(TriangleStore, SmallerThanTriangles) {
+    EXPECT_LT(TriangleStore<float>::bytes_per_triangle, sizeof(TF));
+    EXPECT_LT(TriangleStore<double>::bytes_per_triangle, sizeof(Triangle<double>));
+}
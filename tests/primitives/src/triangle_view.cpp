@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "triangle.hpp"
+#include "triangle_store.hpp"
+#include "triangle_view.hpp"
+
+using namespace triangle;
+
+// --------------------------------------------------------------------------------------
+//                           Tests class TriangleView
+// --------------------------------------------------------------------------------------
+
+using PF = Point<float>;
+using TF = Triangle<float>;
+
+TEST(TriangleView, OverTriangles) {
+    const std::vector<TF> triangles{TF{PF{0,-1,2}, PF{4,0,1}, PF{1,3,5}, 10},
+                                    TF{PF{-2,-2,-2}, PF{0,0,0}, PF{2,2,2}, 11},
+                                    TF{PF{1,1,1}, PF{1,1,1}, PF{1,1,1}, 12}};
+    const TriangleView<float> view(triangles);
+    const TriangleStore<float> store(triangles);
+
+    ASSERT_EQ(view.size(), 3u);
+    for (std::size_t i = 0; i < view.size(); ++i) {
+        EXPECT_EQ(view.get_id(i), store.get_id(i));
+        EXPECT_EQ(view.get_type(i), store.get_type(i));
+        EXPECT_EQ(view.get_vertices(i), store.get_vertices(i));
+        EXPECT_EQ(view.get_box(i).p_min, store.get_box(i).p_min);
+        EXPECT_EQ(view.get_box(i).p_max, store.get_box(i).p_max);
+        for (std::size_t axis = 0; axis < 3; ++axis)
+            EXPECT_EQ(view.get_center(i, axis), store.get_center(i, axis));
+    }
+    // the vertices are read from the triangles, there are no columns to hand out
+    EXPECT_TRUE(view.get_xs().empty());
+    EXPECT_TRUE(view.get_zs().empty());
+}
+
+TEST(TriangleView, OverStridedVertexBuffer) {
+    // x, y, z and one unused value per vertex
+    const std::vector<float> vertices{0,0,0,9, 1,0,0,9, 0,1,0,9,
+                                      5,5,5,9, 6,6,6,9, 7,7,7};
+    const TriangleView<float> view(vertices, 4);
+
+    ASSERT_EQ(view.size(), 2u);
+    EXPECT_EQ(view.get_id(1), 1u);
+    EXPECT_EQ(view.get_type(0), TypeTriangle::triangle);
+    EXPECT_EQ(view.get_type(1), TypeTriangle::interval);
+    EXPECT_EQ(view.get_vertex(0, 1), (PF{1,0,0}));
+    EXPECT_EQ(view.get_vertex(1, 2), (PF{7,7,7}));
+    for (std::size_t i = 0; i < view.size(); ++i) {
+        for (std::size_t k = 0; k < 3; ++k) {
+            const std::size_t v = view.vertex_index(i, k);
+            EXPECT_EQ((PF{view.get_xs()[v], view.get_ys()[v], view.get_zs()[v]}),
+                      view.get_vertex(i, k));
+        }
+    }
+    EXPECT_EQ(view.get_xs().data(), vertices.data());
+
+    const std::vector<float> partial{0,0,0, 1,0,0, 0,1,0, 2,2,2};
+    EXPECT_THROW(TriangleView<float>{partial}, std::invalid_argument);
+    EXPECT_THROW(TriangleView<float>(vertices, 2), std::invalid_argument);
+    EXPECT_TRUE(TriangleView<float>(std::vector<float>{}).empty());
+}
+
+TEST(TriangleView, PermuteLeavesSourceAlone) {
+    std::vector<float> vertices;
+    for (int i = 0; i < 4; ++i)
+        for (float c : {float(i),0.0f,0.0f, float(i),1.0f,0.0f, float(i),0.0f,1.0f})
+            vertices.push_back(c);
+    const std::vector<float> original = vertices;
+
+    TriangleView<float> view(vertices);
+    const std::vector<std::uint32_t> order{2, 0, 3, 1};
+    view.permute(order);
+    view.permute(order);
+
+    // applied twice: position j shows source triangle order[order[j]]
+    for (std::size_t j = 0; j < order.size(); ++j) {
+        EXPECT_EQ(view.get_source_index(j), order[order[j]]);
+        EXPECT_EQ(view.get_id(j), order[order[j]]);
+        EXPECT_EQ(view.get_vertex(j, 0).x_, static_cast<float>(order[order[j]]));
+    }
+    EXPECT_EQ(vertices, original);
+
+    const std::vector<std::uint32_t> wrong{0};
+    EXPECT_THROW(view.permute(wrong), std::invalid_argument);
+}
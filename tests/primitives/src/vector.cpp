@@ -1,4 +1,7 @@
 #include <gtest/gtest.h>
+#include <random>
+
+#include "BVH/AABB.hpp"
 #include "vector.hpp"
 
 using namespace triangle;
@@ -145,3 +148,47 @@ TEST(Vector, projection) {
     EXPECT_NEAR(proj3.y_, 0.0, 1e-6);
     EXPECT_NEAR(proj3.z_, 0.0, 1e-6);
 }
+
+// With SIMD_POINTS the float products run on padded registers; they must round exactly like
+// the scalar formulas
+TEST(Vector, ProductsMatchScalarFormulas) {
+    std::mt19937 gen(38);
+    std::uniform_real_distribution<float> coord(-100.0f, 100.0f);
+
+    for (int i = 0; i < 1000; ++i) {
+        const Point<float> a{coord(gen), coord(gen), coord(gen)};
+        const Point<float> b{coord(gen), coord(gen), coord(gen)};
+        const Vector<float> u(a, b);
+        const Vector<float> v(coord(gen), coord(gen), coord(gen));
+
+        EXPECT_EQ(u.x_, b.x_ - a.x_);
+        EXPECT_EQ(u.z_, b.z_ - a.z_);
+        EXPECT_EQ(scalar_product(u, v), u.x_ * v.x_ + u.y_ * v.y_ + u.z_ * v.z_);
+
+        const Vector<float> w = vector_product(u, v);
+        EXPECT_EQ(w.x_, u.y_ * v.z_ - u.z_ * v.y_);
+        EXPECT_EQ(w.y_, u.z_ * v.x_ - u.x_ * v.z_);
+        EXPECT_EQ(w.z_, u.x_ * v.y_ - u.y_ * v.x_);
+    }
+}
+
+TEST(Vector, WrapInBoxMatchesScalar) {
+    bounding_box::AABB<float> box;
+    box.wrap_in_box_with(bounding_box::AABB<float>(Point<float>{-1, 2, -0.0f}, Point<float>{1, 3, 0}));
+    box.wrap_in_box_with(bounding_box::AABB<float>(Point<float>{0, -2, 0}, Point<float>{4, 2, 0}));
+
+    EXPECT_EQ(box.p_min, (Point<float>{-1, -2, 0}));
+    EXPECT_EQ(box.p_max, (Point<float>{4, 3, 0}));
+    EXPECT_TRUE(std::signbit(box.p_min.z_)); // std::min keeps the first of two equal values
+}
+
+TEST(Vector, Layout) {
+    if constexpr (simd::has_xyz0<float>) {
+        EXPECT_EQ(sizeof(Point<float>), 16u);
+        EXPECT_EQ(alignof(Vector<float>), 16u);
+    } else {
+        EXPECT_EQ(sizeof(Point<float>), 3 * sizeof(float));
+    }
+    EXPECT_EQ(sizeof(Point<double>), 3 * sizeof(double));
+    EXPECT_EQ(sizeof(Vector<double>), 3 * sizeof(double));
+}
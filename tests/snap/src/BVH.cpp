@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "BVH/BVH.hpp"
+#include "snap/BVH.hpp"
+#include "point.hpp"
+#include "triangle.hpp"
+
+using namespace triangle;
+using Tri = Triangle<double>;
+using P = Point<double>;
+
+TEST(SnapBVH, EmptyInput) {
+    snap::SnapBVH<21> bvh(std::vector<Tri>{});
+    EXPECT_NO_THROW(bvh.build());
+    EXPECT_TRUE(bvh.get_intersecting_triangles().empty());
+}
+
+TEST(SnapBVH, FindsTouchingAndCrossingPairs) {
+    std::vector<Tri> triangles{
+        Tri(P{0,0,0}, P{4,0,0}, P{0,4,0}, /*id=*/10),
+        Tri(P{1,1,-1}, P{1,1,1}, P{2,1,0}, /*id=*/11),  // crosses 10
+        Tri(P{4,0,0}, P{6,0,1}, P{6,1,0}, /*id=*/12),   // touches 10 at a vertex
+        Tri(P{8,8,8}, P{9,8,8}, P{8,9,8}, /*id=*/13),
+    };
+
+    snap::SnapBVH<21> bvh(triangles);
+    bvh.build();
+    EXPECT_EQ(bvh.get_intersecting_triangles(), (std::set<std::size_t>{10, 11, 12}));
+}
+
+// general position: the snapped and the floating-point query agree
+TEST(SnapBVH, MatchesFloatingPointBVH) {
+    std::mt19937 gen(11);
+    std::uniform_real_distribution<double> center(0, 40);
+    std::uniform_real_distribution<double> offset(-1.5, 1.5);
+
+    std::vector<Tri> triangles;
+    for (std::size_t i = 0; i < 3000; ++i) {
+        P c(center(gen), center(gen), center(gen));
+        auto vertex = [&] { return P(c.x_ + offset(gen), c.y_ + offset(gen), c.z_ + offset(gen)); };
+        triangles.emplace_back(vertex(), vertex(), vertex(), i);
+    }
+
+    snap::SnapBVH<21> snap_21(triangles);
+    snap::SnapBVH<32> snap_32(triangles);
+    snap_21.build();
+    snap_32.build();
+
+    std::vector<Tri> copy = triangles;
+    bin_tree::BVH<double> reference(std::move(copy));
+    reference.build();
+
+    const auto expected = reference.get_intersecting_triangles();
+    EXPECT_FALSE(expected.empty());
+    EXPECT_EQ(snap_21.get_intersecting_triangles(), expected);
+    EXPECT_EQ(snap_32.get_intersecting_triangles(), expected);
+}
@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+#include <random>
+
+#include "snap/grid.hpp"
+#include "snap/predicates.hpp"
+#include "point.hpp"
+
+using namespace snap;
+using triangle::Point;
+
+static bounding_box::AABB<double> make_box(double lo, double hi) {
+    return bounding_box::AABB<double>(Point<double>(lo, lo, lo), Point<double>(hi, hi, hi));
+}
+
+TEST(SnapGrid, QuantizeCorners) {
+    SnapGrid<21> grid(make_box(-1, 3));
+
+    EXPECT_EQ(grid.quantize(Point<double>(-1, -1, -1)), (IntPoint{0, 0, 0}));
+    EXPECT_EQ(grid.quantize(Point<double>(3, 3, 3)),
+              (IntPoint{SnapGrid<21>::max_coordinate, SnapGrid<21>::max_coordinate,
+                        SnapGrid<21>::max_coordinate}));
+    EXPECT_NEAR(grid.get_resolution(), 4.0 / ((1 << 21) - 1), 1e-15);
+}
+
+TEST(SnapGrid, QuantizeClampsAndKeepsFullRange) {
+    SnapGrid<32> grid(make_box(0, 1));
+
+    EXPECT_EQ(grid.quantize(Point<double>(-5, 2, 0.5)).x_, 0u);
+    EXPECT_EQ(grid.quantize(Point<double>(-5, 2, 0.5)).y_, 0xffffffffu);
+    EXPECT_EQ(grid.quantize(Point<double>(-5, 2, 0.5)).z_, 0x80000000u);
+}
+
+TEST(SnapGrid, FlatSceneDoesNotDivideByZero) {
+    SnapGrid<21> grid(make_box(2, 2));
+    EXPECT_EQ(grid.quantize(Point<double>(2, 2, 2)), (IntPoint{0, 0, 0}));
+}
+
+template <unsigned Bits> static void check_orient_extremes() {
+    const std::uint32_t m = SnapGrid<Bits>::max_coordinate;
+    IntPoint o{0, 0, 0}, x{m, 0, 0}, y{0, m, 0};
+
+    EXPECT_EQ(orient_3d<Bits>(o, x, y, IntPoint{0, 0, m}), 1);
+    EXPECT_EQ(orient_3d<Bits>(x, o, y, IntPoint{0, 0, m}), -1);
+    EXPECT_EQ(orient_3d<Bits>(o, x, y, IntPoint{m, m, 0}), 0);
+    EXPECT_EQ(orient_3d<Bits>(o, x, y, IntPoint{m, m, 1}), 1);
+}
+
+TEST(SnapPredicates, OrientExtremes21) { check_orient_extremes<21>(); }
+TEST(SnapPredicates, OrientExtremes32) { check_orient_extremes<32>(); }
+
+TEST(SnapPredicates, Orient21MatchesOrient32) {
+    std::mt19937 gen(1);
+    std::uniform_int_distribution<std::uint32_t> coord(0, SnapGrid<21>::max_coordinate);
+    auto random_point = [&] { return IntPoint{coord(gen), coord(gen), coord(gen)}; };
+
+    for (int i = 0; i < 5000; ++i) {
+        IntPoint a = random_point(), b = random_point(), c = random_point(), d = random_point();
+        EXPECT_EQ(orient_3d<21>(a, b, c, d), orient_3d<32>(a, b, c, d));
+    }
+}
+
+TEST(SnapPredicates, CoplanarAtFullRange) {
+    const std::uint32_t m = SnapGrid<32>::max_coordinate;
+    // d = b + c - a lies in the plane of a, b, c
+    IntPoint a{10, 20, 30}, b{m - 100, 5, m / 3}, c{50, m - 200, m / 2};
+    IntPoint d{b.x_ + c.x_ - a.x_, b.y_ + c.y_ - a.y_, b.z_ + c.z_ - a.z_};
+
+    EXPECT_EQ(orient_3d<32>(a, b, c, d), 0);
+    EXPECT_NE(orient_3d<32>(a, b, c, IntPoint{d.x_, d.y_, d.z_ + 1}), 0);
+}
@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+
+#include "snap/intersection.hpp"
+#include "snap/triangle.hpp"
+
+using namespace snap;
+
+static IntTriangle tri(IntPoint a, IntPoint b, IntPoint c) { return IntTriangle(a, b, c, 0); }
+
+TEST(SnapIntersection, Types) {
+    EXPECT_EQ(tri({1,1,1}, {1,1,1}, {1,1,1}).get_type(), triangle::TypeTriangle::point);
+    EXPECT_EQ(tri({0,0,0}, {2,2,2}, {1,1,1}).get_type(), triangle::TypeTriangle::interval);
+    EXPECT_EQ(tri({0,0,0}, {2,2,2}, {1,1,2}).get_type(), triangle::TypeTriangle::triangle);
+
+    auto [first, second] = tri({1,1,1}, {0,0,0}, {3,3,3}).get_interval();
+    EXPECT_EQ(first, 1u);
+    EXPECT_EQ(second, 2u);
+}
+
+TEST(SnapIntersection, CrossingAndSeparated) {
+    IntTriangle flat = tri({0,0,10}, {20,0,10}, {0,20,10});
+    IntTriangle crossing = tri({2,2,0}, {2,2,20}, {8,3,5});
+    IntTriangle above = tri({2,2,11}, {2,2,20}, {8,3,15});
+
+    EXPECT_TRUE(intersect<21>(flat, crossing));
+    EXPECT_TRUE(intersect<21>(crossing, flat));
+    EXPECT_FALSE(intersect<21>(flat, above));
+    EXPECT_FALSE(intersect<32>(above, flat));
+}
+
+TEST(SnapIntersection, TouchingCountsOneCellGapDoesNot) {
+    IntTriangle flat = tri({0,0,10}, {20,0,10}, {0,20,10});
+    IntTriangle touching = tri({5,5,10}, {5,5,20}, {9,6,15});
+    IntTriangle gap = tri({5,5,11}, {5,5,20}, {9,6,15});
+    IntTriangle on_edge = tri({10,0,10}, {10,5,30}, {12,3,30}); // vertex on an edge
+
+    EXPECT_TRUE(intersect<21>(flat, touching));
+    EXPECT_FALSE(intersect<21>(flat, gap));
+    EXPECT_TRUE(intersect<21>(on_edge, flat));
+}
+
+TEST(SnapIntersection, Coplanar) {
+    IntTriangle a = tri({0,0,0}, {10,0,0}, {0,10,0});
+    IntTriangle overlapping = tri({5,5,0}, {15,5,0}, {5,15,0});  // shares the point (5, 5)
+    IntTriangle inside = tri({1,1,0}, {3,1,0}, {1,3,0});
+    IntTriangle apart = tri({6,6,0}, {15,6,0}, {6,15,0});
+
+    EXPECT_TRUE(intersect<21>(a, overlapping));
+    EXPECT_TRUE(intersect<21>(a, inside));
+    EXPECT_TRUE(intersect<21>(inside, a));
+    EXPECT_FALSE(intersect<21>(a, apart));
+}
+
+TEST(SnapIntersection, DegenerateTriangles) {
+    IntTriangle a = tri({0,0,1}, {0,1,0}, {1,0,0});
+    IntTriangle plane = tri({2,2,0}, {8,2,0}, {2,8,0});
+
+    // segment (0,0,0)-(3,3,3) passes through a only in rational coordinates
+    EXPECT_TRUE(intersect<21>(a, tri({0,0,0}, {0,0,0}, {3,3,3})));
+    EXPECT_FALSE(intersect<21>(a, tri({1,1,1}, {1,1,1}, {3,3,3})));
+
+    // points
+    EXPECT_TRUE(intersect<21>(plane, tri({3,3,0}, {3,3,0}, {3,3,0})));
+    EXPECT_TRUE(intersect<21>(tri({8,2,0}, {8,2,0}, {8,2,0}), plane));
+    EXPECT_FALSE(intersect<21>(plane, tri({3,3,1}, {3,3,1}, {3,3,1})));
+
+    // segments against segments
+    EXPECT_TRUE(intersect<21>(tri({0,0,0}, {4,4,0}, {2,2,0}), tri({0,4,0}, {4,0,0}, {4,0,0})));
+    EXPECT_FALSE(intersect<21>(tri({0,0,0}, {4,4,0}, {2,2,0}), tri({0,4,1}, {4,0,1}, {4,0,1})));
+    EXPECT_TRUE(intersect<21>(tri({0,0,0}, {4,0,0}, {4,0,0}), tri({3,0,0}, {9,0,0}, {9,0,0})));
+    EXPECT_FALSE(intersect<21>(tri({0,0,0}, {4,0,0}, {4,0,0}), tri({5,0,0}, {9,0,0}, {9,0,0})));
+
+    // segment lying in the plane of a triangle
+    EXPECT_TRUE(intersect<21>(plane, tri({0,4,0}, {9,4,0}, {9,4,0})));
+    EXPECT_FALSE(intersect<21>(plane, tri({6,6,0}, {9,9,0}, {9,9,0})));
+}